@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BENCHMARK_HPP
+#define LIBBITCOIN_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+
+/**
+ * Invoke the action the given number of times and print the mean duration.
+ */
+template <typename Action>
+void measure(const std::string& name, size_t iterations, Action action)
+{
+    typedef std::chrono::high_resolution_clock clock;
+    const auto start = clock::now();
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+        action();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - start);
+
+    bc::cout << name << ": " << elapsed.count() / iterations << " ns"
+        << std::endl;
+}
+
+#ifdef _MSC_VER
+/**
+ * The target of keep where inline assembly is unavailable, see main.cpp.
+ */
+extern const void* volatile keep_sink;
+#endif
+
+/**
+ * Prevent the optimizer from discarding the computation of a value.
+ */
+template <typename Value>
+void keep(const Value& value)
+{
+#ifdef _MSC_VER
+    keep_sink = &value;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/**
+ * The number of heap allocations made by the process so far.
+ */
+size_t allocations();
+
+/**
+ * Invoke the action once and print the number of heap allocations it made.
+ */
+template <typename Action>
+void count(const std::string& name, Action action)
+{
+    const auto start = allocations();
+    action();
+    bc::cout << name << ": " << allocations() - start << " allocations"
+        << std::endl;
+}
+
+/**
+ * A serialized block of 2000 two-input two-output transactions (~750KB).
+ */
+bc::data_chunk synthetic_block();
+
+// Benchmark suites, registered in main.cpp.
+void benchmark_block();
+void benchmark_hash();
+void benchmark_hd();
+void benchmark_hosts();
+void benchmark_log();
+void benchmark_mnemonic();
+void benchmark_random();
+void benchmark_registry();
+void benchmark_script();
+void benchmark_scrypt();
+void benchmark_secp256k1();
+void benchmark_serialize();
+void benchmark_signature();
+void benchmark_subscriber();
+void benchmark_timer_wheel();
+
+#endif
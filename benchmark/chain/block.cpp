@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+static const size_t iterations = 20;
+
+data_chunk synthetic_block()
+{
+    // A signature and public key push, and a pay to public key hash script.
+    const auto signature = build_chunk({ data_chunk{ 72 }, data_chunk(72, 0x30),
+        data_chunk{ 33 }, data_chunk(33, 0x02) });
+    const auto pay_key_hash = build_chunk({ data_chunk{ 0x76, 0xa9, 20 },
+        data_chunk(20, 0x42), data_chunk{ 0x88, 0xac } });
+
+    block block;
+    for (uint32_t count = 0; count < 2000; ++count)
+    {
+        transaction tx;
+        tx.version = 1;
+        tx.locktime = count;
+
+        for (uint32_t index = 0; index < 2; ++index)
+        {
+            input input;
+            input.previous_output.hash = bitcoin_hash(to_little_endian(count));
+            input.previous_output.index = index;
+            input.script = script::factory_from_data(signature, false,
+                script::parse_mode::strict);
+            input.sequence = max_input_sequence;
+            tx.inputs.push_back(input);
+
+            output output;
+            output.value = count * 1000 + index;
+            output.script = script::factory_from_data(pay_key_hash, false,
+                script::parse_mode::strict);
+            tx.outputs.push_back(output);
+        }
+
+        block.transactions.push_back(tx);
+    }
+
+    block.header.transaction_count = block.transactions.size();
+    block.header.merkle = block::generate_merkle_root(block.transactions);
+    return block.to_data();
+}
+
+// The owned parse is measured through a stream and through a slice, against
+// the in-place view, which only records offsets into the serialized block.
+void benchmark_block()
+{
+    const auto data = synthetic_block();
+    const std::string text(data.begin(), data.end());
+    const auto prefix = std::to_string(data.size()) + " bytes";
+
+    const auto from_stream = [&]()
+    {
+        std::istringstream stream(text);
+        block block;
+        block.from_data(stream);
+        keep(block);
+    };
+
+    const auto from_slice = [&]()
+    {
+        block block;
+        block.from_data(data);
+        keep(block);
+    };
+
+    const auto from_view = [&]()
+    {
+        block_view view;
+        view.from_data(data);
+        keep(view);
+    };
+
+    measure("block::from_data(istream) " + prefix, iterations, from_stream);
+    measure("block::from_data(data_chunk) " + prefix, iterations, from_slice);
+    measure("block_view::from_data " + prefix, iterations, from_view);
+    count("block::from_data(istream)", from_stream);
+    count("block::from_data(data_chunk)", from_slice);
+    count("block_view::from_data", from_view);
+}
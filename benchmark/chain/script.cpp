@@ -0,0 +1,565 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+static const size_t iterations = 10000;
+
+static data_chunk push(const data_chunk& data)
+{
+    data_chunk result;
+
+    if (data.size() < static_cast<uint8_t>(opcode::pushdata1))
+    {
+        result.push_back(static_cast<uint8_t>(data.size()));
+    }
+    else
+    {
+        result.push_back(static_cast<uint8_t>(opcode::pushdata1));
+        result.push_back(static_cast<uint8_t>(data.size()));
+    }
+
+    extend_data(result, data);
+    return result;
+}
+
+static data_chunk endorsement_data(uint8_t seed)
+{
+    data_chunk result(71, seed);
+    result.push_back(signature_hash_algorithm::all);
+    return result;
+}
+
+static data_chunk point_data(uint8_t seed)
+{
+    data_chunk result(33, seed);
+    result[0] = 0x02;
+    return result;
+}
+
+static script make_script(const data_chunk& data)
+{
+    return script::factory_from_data(data, false,
+        script::parse_mode::raw_data_fallback);
+}
+
+// The interpreter as previously implemented, reduced to the operations of
+// the scripts measured here. Operations are walked and copied, stack items
+// are data chunks, operations are dispatched by a switch and each signature
+// check copies the operations of its script code. Signatures are checked
+// through the same signature hash cache as the current implementation, so
+// that only the interpreter differs.
+namespace previous {
+
+static const data_chunk stack_false_value;
+static const data_chunk stack_true_value{ 1 };
+static constexpr uint64_t op_counter_limit = 201;
+
+class evaluation_context
+{
+public:
+    data_chunk pop_primary()
+    {
+        const auto value = primary.back();
+        primary.pop_back();
+        return value;
+    }
+
+    bool has_failed_branches() const
+    {
+        return std::find(conditional.begin(), conditional.end(), false) !=
+            conditional.end();
+    }
+
+    operation::stack::const_iterator codehash_begin;
+    uint64_t operation_counter;
+    data_stack primary;
+    data_stack secondary;
+    std::vector<bool> conditional;
+};
+
+static bool cast_to_bool(const data_chunk& values)
+{
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        if (*it != 0)
+        {
+            // Can be negative zero
+            if (it == values.end() - 1 && *it == 0x80)
+                return false;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool read_value(data_stack& stack, int32_t& value)
+{
+    if (stack.empty())
+        return false;
+
+    script_number mid;
+    const auto item = stack.back();
+    stack.pop_back();
+    if (!mid.set_data(item))
+        return false;
+
+    value = mid.int32();
+    return true;
+}
+
+static bool op_x(evaluation_context& context, opcode code)
+{
+    const auto difference = static_cast<uint8_t>(code) -
+        static_cast<uint8_t>(opcode::op_1) + 1;
+
+    script_number value(difference);
+    context.primary.push_back(value.data());
+    return true;
+}
+
+static bool op_dup(evaluation_context& context)
+{
+    if (context.primary.size() < 1)
+        return false;
+
+    context.primary.push_back(context.primary.back());
+    return true;
+}
+
+static bool op_equal(evaluation_context& context)
+{
+    if (context.primary.size() < 2)
+        return false;
+
+    if (context.pop_primary() == context.pop_primary())
+        context.primary.push_back(stack_true_value);
+    else
+        context.primary.push_back(stack_false_value);
+
+    return true;
+}
+
+static bool op_equalverify(evaluation_context& context)
+{
+    if (context.primary.size() < 2)
+        return false;
+
+    return context.pop_primary() == context.pop_primary();
+}
+
+static bool op_hash160(evaluation_context& context)
+{
+    if (context.primary.size() < 1)
+        return false;
+
+    const auto hash = bitcoin_short_hash(context.pop_primary());
+    context.primary.push_back(to_chunk(hash));
+    return true;
+}
+
+static bool op_checksigverify(evaluation_context& context,
+    const script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
+{
+    if (context.primary.size() < 2)
+        return false;
+
+    const auto point = context.pop_primary();
+    const auto signature = context.pop_primary();
+
+    chain::script script_code;
+    for (auto it = context.codehash_begin; it != script.operations.end(); ++it)
+    {
+        const auto op = *it;
+        if (op.data == signature || op.code == opcode::codeseparator)
+            continue;
+
+        script_code.operations.push_back(op);
+    }
+
+    return script::check_signature(signature, point, script_code, cache,
+        input_index);
+}
+
+static bool op_checksig(evaluation_context& context, const script& script,
+    const signature_hash_cache& cache, uint32_t input_index)
+{
+    if (op_checksigverify(context, script, cache, input_index))
+        context.primary.push_back(stack_true_value);
+    else
+        context.primary.push_back(stack_false_value);
+
+    return true;
+}
+
+static bool read_section(evaluation_context& context, data_stack& section,
+    size_t count)
+{
+    if (context.primary.size() < count)
+        return false;
+
+    for (size_t i = 0; i < count; ++i)
+        section.push_back(context.pop_primary());
+
+    return true;
+}
+
+static bool op_checkmultisigverify(evaluation_context& context,
+    const script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
+{
+    int32_t pubkeys_count;
+    if (!read_value(context.primary, pubkeys_count))
+        return false;
+
+    if (pubkeys_count < 0 || pubkeys_count > 20)
+        return false;
+
+    context.operation_counter += pubkeys_count;
+    if (context.operation_counter > op_counter_limit)
+        return false;
+
+    data_stack pubkeys;
+    if (!read_section(context, pubkeys, pubkeys_count))
+        return false;
+
+    int32_t sigs_count;
+    if (!read_value(context.primary, sigs_count))
+        return false;
+
+    if (sigs_count < 0 || sigs_count > pubkeys_count)
+        return false;
+
+    data_stack signatures;
+    if (!read_section(context, signatures, sigs_count))
+        return false;
+
+    // Due to a bug in bitcoind, we need to read an extra null value which we
+    // discard later.
+    if (context.primary.empty())
+        return false;
+
+    context.primary.pop_back();
+    const auto is_signature = [&signatures](const data_chunk& data)
+    {
+        return std::find(signatures.begin(), signatures.end(), data) !=
+            signatures.end();
+    };
+
+    chain::script script_code;
+    for (auto it = context.codehash_begin; it != script.operations.end(); ++it)
+    {
+        const operation op = *it;
+
+        if (op.code == opcode::codeseparator)
+            continue;
+
+        if (is_signature(op.data))
+            continue;
+
+        script_code.operations.push_back(op);
+    }
+
+    auto pubkey_iterator = pubkeys.begin();
+    for (const auto& signature: signatures)
+    {
+        while (true)
+        {
+            const auto& point = *pubkey_iterator;
+            if (script::check_signature(signature, point, script_code,
+                cache, input_index))
+                break;
+
+            ++pubkey_iterator;
+            if (pubkey_iterator == pubkeys.end())
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static bool op_checkmultisig(evaluation_context& context,
+    const script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
+{
+    if (op_checkmultisigverify(context, script, cache, input_index))
+        context.primary.push_back(stack_true_value);
+    else
+        context.primary.push_back(stack_false_value);
+
+    return true;
+}
+
+// Operations other than those of the measured scripts are not reproduced.
+static bool run_operation(const operation& op,
+    const signature_hash_cache& cache, uint32_t input_index,
+    const script& script, evaluation_context& context)
+{
+    switch (op.code)
+    {
+        case opcode::op_1:
+        case opcode::op_2:
+        case opcode::op_3:
+        case opcode::op_4:
+        case opcode::op_5:
+        case opcode::op_6:
+        case opcode::op_7:
+        case opcode::op_8:
+        case opcode::op_9:
+        case opcode::op_10:
+        case opcode::op_11:
+        case opcode::op_12:
+        case opcode::op_13:
+        case opcode::op_14:
+        case opcode::op_15:
+        case opcode::op_16:
+            return op_x(context, op.code);
+
+        case opcode::return_:
+            return false;
+
+        case opcode::dup:
+            return op_dup(context);
+
+        case opcode::equal:
+            return op_equal(context);
+
+        case opcode::equalverify:
+            return op_equalverify(context);
+
+        case opcode::hash160:
+            return op_hash160(context);
+
+        case opcode::checksig:
+            return op_checksig(context, script, cache, input_index);
+
+        case opcode::checkmultisig:
+            return op_checkmultisig(context, script, cache, input_index);
+
+        default:
+            return false;
+    }
+}
+
+static bool opcode_is_disabled(opcode code)
+{
+    switch (code)
+    {
+        case opcode::cat:
+        case opcode::substr:
+        case opcode::left:
+        case opcode::right:
+        case opcode::invert:
+        case opcode::and_:
+        case opcode::or_:
+        case opcode::xor_:
+        case opcode::op_2mul:
+        case opcode::op_2div:
+        case opcode::mul:
+        case opcode::div:
+        case opcode::mod:
+        case opcode::lshift:
+        case opcode::rshift:
+        case opcode::verif:
+        case opcode::vernotif:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool next_step(const signature_hash_cache& cache,
+    uint32_t input_index, operation::stack::const_iterator it,
+    const script& script, evaluation_context& context)
+{
+    const auto& op = *it;
+
+    if (op.data.size() > 520)
+        return false;
+
+    if (static_cast<uint8_t>(op.code) > static_cast<uint8_t>(opcode::op_16))
+        ++context.operation_counter;
+
+    if (context.operation_counter > op_counter_limit)
+        return false;
+
+    if (opcode_is_disabled(op.code))
+        return false;
+
+    if (op.code == opcode::zero)
+        context.primary.push_back(data_chunk());
+    else if (op.code == opcode::special
+        || op.code == opcode::pushdata1
+        || op.code == opcode::pushdata2
+        || op.code == opcode::pushdata4)
+        context.primary.push_back(op.data);
+    else if (op.code == opcode::codeseparator)
+        context.codehash_begin = it;
+    else if (!run_operation(op, cache, input_index, script, context))
+        return false;
+
+    return context.primary.size() + context.secondary.size() <= 1000;
+}
+
+static bool evaluate(const signature_hash_cache& cache, uint32_t input_index,
+    const script& script, evaluation_context& context)
+{
+    if (script.satoshi_content_size() > 10000)
+        return false;
+
+    context.operation_counter = 0;
+    context.codehash_begin = script.operations.begin();
+    for (auto it = script.operations.begin(); it != script.operations.end();
+        ++it)
+        if (!next_step(cache, input_index, it, script, context))
+            return false;
+
+    return context.conditional.empty();
+}
+
+static bool verify(const script& input_script, const script& output_script,
+    const signature_hash_cache& cache, uint32_t input_index)
+{
+    evaluation_context input_context;
+    evaluation_context output_context;
+    if (!evaluate(cache, input_index, input_script, input_context))
+        return false;
+
+    output_context.primary = input_context.primary;
+    if (!evaluate(cache, input_index, output_script, output_context))
+        return false;
+
+    if (output_context.primary.empty())
+        return false;
+
+    if (!cast_to_bool(output_context.primary.back()))
+        return false;
+
+    if (output_script.pattern() == script_pattern::pay_script_hash)
+    {
+        if (!operation::is_push_only(input_script.operations))
+            return false;
+
+        evaluation_context eval_context;
+        eval_context.primary = input_context.primary;
+        script eval_script;
+
+        if (!eval_script.from_data(input_context.primary.back(), false,
+            script::parse_mode::raw_data_fallback))
+            return false;
+
+        eval_context.primary.pop_back();
+
+        if (!evaluate(cache, input_index, eval_script, eval_context))
+            return false;
+
+        if (eval_context.primary.empty())
+            return false;
+
+        return cast_to_bool(eval_context.primary.back());
+    }
+
+    return true;
+}
+
+} // namespace previous
+
+static void compare(const std::string& name, const script& input_script,
+    const script& output_script, const signature_hash_cache& cache)
+{
+    const auto expected = previous::verify(input_script, output_script,
+        cache, 0);
+    if (script::verify(input_script, output_script, cache, 0) != expected)
+        bc::cout << name << ": result differs from previous" << std::endl;
+
+    measure(name + " (previous)", iterations, [&]()
+    {
+        keep(previous::verify(input_script, output_script, cache, 0));
+    });
+
+    measure(name + " (script)", iterations, [&]()
+    {
+        keep(script::verify(input_script, output_script, cache, 0));
+    });
+
+    const compiled_script input(input_script);
+    const compiled_script output(output_script);
+    measure(name + " (compiled)", iterations, [&]()
+    {
+        keep(script::verify(input, output, cache, 0));
+    });
+}
+
+void benchmark_script()
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.resize(1);
+    tx.inputs[0].sequence = max_input_sequence;
+    tx.outputs.resize(1);
+    tx.outputs[0].value = 0;
+    const signature_hash_cache cache(tx);
+
+    // [sig] [point] / DUP HASH160 [hash160(point)] EQUALVERIFY CHECKSIG
+    const auto point = point_data(1);
+    auto p2pkh_input = push(endorsement_data(1));
+    extend_data(p2pkh_input, push(point));
+    auto p2pkh_output = data_chunk{ 0x76, 0xa9 };
+    extend_data(p2pkh_output, push(to_chunk(bitcoin_short_hash(point))));
+    extend_data(p2pkh_output, data_chunk{ 0x88, 0xac });
+    compare("p2pkh", make_script(p2pkh_input), make_script(p2pkh_output),
+        cache);
+
+    // 0 [sig] [sig] [2 [point] [point] [point] 3 CHECKMULTISIG] /
+    // HASH160 [hash160(redeem)] EQUAL
+    auto redeem = data_chunk{ 0x52 };
+    extend_data(redeem, push(point_data(1)));
+    extend_data(redeem, push(point_data(2)));
+    extend_data(redeem, push(point_data(3)));
+    extend_data(redeem, data_chunk{ 0x53, 0xae });
+    auto p2sh_input = data_chunk{ 0x00 };
+    extend_data(p2sh_input, push(endorsement_data(1)));
+    extend_data(p2sh_input, push(endorsement_data(2)));
+    extend_data(p2sh_input, push(redeem));
+    auto p2sh_output = data_chunk{ 0xa9 };
+    extend_data(p2sh_output, push(to_chunk(bitcoin_short_hash(redeem))));
+    p2sh_output.push_back(0x87);
+    compare("p2sh multisig", make_script(p2sh_input),
+        make_script(p2sh_output), cache);
+
+    // / RETURN [data]
+    auto null_data_output = data_chunk{ 0x6a };
+    extend_data(null_data_output, push(data_chunk(40, 0x2a)));
+    compare("op_return", script(), make_script(null_data_output), cache);
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "benchmark.hpp"
+
+BC_USE_LIBBITCOIN_MAIN
+
+typedef std::pair<std::string, std::function<void()>> suite;
+
+#ifdef _MSC_VER
+const void* volatile keep_sink = nullptr;
+#endif
+
+static std::atomic<size_t> allocation_count(0);
+
+// Count every heap allocation, so that suites can report allocations.
+void* operator new(size_t size)
+{
+    ++allocation_count;
+    const auto memory = std::malloc(std::max(size, size_t(1)));
+
+    if (memory == nullptr)
+        throw std::bad_alloc();
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+size_t allocations()
+{
+    return allocation_count.load();
+}
+
+// Run the named benchmark suites, or all suites if none are named.
+int bc::main(int argc, char* argv[])
+{
+    const std::vector<suite> suites
+    {
+        { "block", benchmark_block },
+        { "hash", benchmark_hash },
+        { "hd", benchmark_hd },
+        { "hosts", benchmark_hosts },
+        { "log", benchmark_log },
+        { "mnemonic", benchmark_mnemonic },
+        { "random", benchmark_random },
+        { "registry", benchmark_registry },
+        { "script", benchmark_script },
+        { "scrypt", benchmark_scrypt },
+        { "secp256k1", benchmark_secp256k1 },
+        { "serialize", benchmark_serialize },
+        { "signature", benchmark_signature },
+        { "subscriber", benchmark_subscriber },
+        { "timer_wheel", benchmark_timer_wheel }
+    };
+
+    const std::vector<std::string> names(argv + 1, argv + argc);
+    const auto selected = [&names](const std::string& name)
+    {
+        return names.empty() ||
+            std::find(names.begin(), names.end(), name) != names.end();
+    };
+
+    for (const auto& suite: suites)
+    {
+        if (selected(suite.first))
+        {
+            bc::cout << "[" << suite.first << "]" << std::endl;
+            suite.second();
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
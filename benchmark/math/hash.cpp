@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 1000;
+
+// Each implementation supported by this processor is measured in turn, for a
+// typical transaction size, a block of transaction hashes and a merkle level.
+void benchmark_hash()
+{
+    const data_chunk transaction(250, 0x2a);
+    const std::vector<data_slice> transactions(2000, transaction);
+    const hash_list level(2000, hash_digest{ { 0x42 } });
+
+    const auto implementations = sha256_implementations();
+    for (const auto& implementation: implementations)
+    {
+        select_sha256_implementation(implementation);
+        const auto prefix = implementation + ": ";
+
+        measure(prefix + "bitcoin_hash (250 bytes)", iterations * 100, [&]()
+        {
+            keep(bitcoin_hash(transaction));
+        });
+
+        measure(prefix + "bitcoin_hash (2000 x 250 bytes)", iterations, [&]()
+        {
+            hash_list hashes;
+            hashes.reserve(transactions.size());
+            for (const auto& item: transactions)
+                hashes.push_back(bitcoin_hash(item));
+
+            keep(hashes);
+        });
+
+        measure(prefix + "bitcoin_hash_many (2000 x 250 bytes)", iterations,
+            [&]()
+        {
+            keep(bitcoin_hash_many(transactions));
+        });
+
+        hash_list reduced(level.size() / 2);
+        measure(prefix + "bitcoin_hash_pairs (1000 pairs)", iterations, [&]()
+        {
+            bitcoin_hash_pairs(reduced.data(), level.data(), reduced.size());
+            keep(reduced);
+        });
+    }
+
+    select_sha256_implementation(implementations.front());
+}
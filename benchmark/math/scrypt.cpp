@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 4;
+
+// The BIP-38 parameters (N = 16384, p = 8, r = 8), 16MB of working memory.
+void benchmark_scrypt()
+{
+    const auto data = to_chunk(std::string("TestingOneTwoThree"));
+    const auto salt = to_chunk(std::string("salt"));
+    const auto implementations = scrypt_implementations();
+
+    // A new context for each hash allocates its working memory each time.
+    for (const auto& implementation: implementations)
+    {
+        select_scrypt_implementation(implementation);
+        measure("fresh context (" + implementation + ")", iterations, [&]()
+        {
+            scrypt_context context(16384, 8, 8);
+            keep(context.hash<64>(data, salt));
+        });
+    }
+
+    for (const auto& implementation: implementations)
+    {
+        select_scrypt_implementation(implementation);
+        scrypt_context context(16384, 8, 8);
+        measure("reused context (" + implementation + ")", iterations, [&]()
+        {
+            keep(context.hash<64>(data, salt));
+        });
+    }
+
+    select_scrypt_implementation(implementations.front());
+
+    threadpool pool(4);
+    scrypt_context context(16384, 8, 8, pool);
+    measure("reused context (4 threads)", iterations, [&]()
+    {
+        keep(context.hash<64>(data, salt));
+    });
+
+    pool.shutdown();
+    pool.join();
+}
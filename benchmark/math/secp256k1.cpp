@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <thread>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 100;
+
+// Context creation generates the precomputed tables of the linked secp256k1,
+// which is the first use latency that initialize() moves to startup.
+void benchmark_secp256k1()
+{
+    measure("create signing context", iterations, []()
+    {
+        secp256k1_signing instance;
+        instance.initialize();
+    });
+
+    measure("create verification context", iterations, []()
+    {
+        secp256k1_verification instance;
+        instance.initialize();
+    });
+
+    secp256k1_signing shared;
+    measure("context (shared)", iterations * 10000, [&shared]()
+    {
+        keep(shared.context());
+    });
+
+    secp256k1_signing local;
+    local.set_per_thread(true);
+    measure("context (per thread)", iterations * 10000, [&local]()
+    {
+        keep(local.context());
+    });
+
+    measure("clone signing context (new thread)", iterations, [&local]()
+    {
+        std::thread thread([&local]() { keep(local.context()); });
+        thread.join();
+    });
+
+    bc::cout << "create: " << shared.metrics().create << std::endl;
+    bc::cout << "clone: " << local.metrics().clone << std::endl;
+    bc::cout << "randomize: " << local.metrics().randomize << std::endl;
+}
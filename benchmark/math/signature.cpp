@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 1000;
+static const size_t signatures = 2000;
+
+static data_chunk make_point(size_t index)
+{
+    data_chunk point(ec_compressed_size, 0x42);
+    point[0] = 0x02;
+    point[1] = static_cast<uint8_t>(index);
+    point[2] = static_cast<uint8_t>(index >> 8);
+    return point;
+}
+
+// The signatures of a block are cached as if seen in the memory pool, so the
+// batch measures the cost of skipping verification rather than of secp256k1.
+void benchmark_signature()
+{
+    const hash_digest sighash{ { 0x2a } };
+    const endorsement signature(71, 0x30);
+
+    std::vector<data_chunk> points;
+    for (size_t index = 0; index < signatures; ++index)
+        points.push_back(make_point(index));
+
+    signature_cache cache(signatures);
+    for (const auto& point: points)
+        cache.insert(point, sighash, signature);
+
+    size_t index = 0;
+    measure("signature_cache::contains", iterations * 100, [&]()
+    {
+        keep(cache.contains(points[index++ % signatures], sighash,
+            signature));
+    });
+
+    uint32_t inserted = 0;
+    measure("signature_cache::insert (full)", iterations * 100, [&]()
+    {
+        auto evicting = sighash;
+        const auto count = to_little_endian(inserted++);
+        std::copy(count.begin(), count.end(), evicting.begin());
+        cache.insert(points.front(), evicting, signature);
+    });
+
+    for (const auto& point: points)
+        cache.insert(point, sighash, signature);
+
+    measure("signature_batch::verify (2000 cached)", iterations, [&]()
+    {
+        signature_batch batch(cache);
+        for (const auto& point: points)
+            batch.add(point, sighash, signature);
+
+        keep(batch.verify());
+    });
+
+    threadpool pool(4);
+    measure("signature_batch::verify (2000 cached, 4 threads)", iterations,
+        [&]()
+    {
+        signature_batch batch(cache);
+        for (const auto& point: points)
+            batch.add(point, sighash, signature);
+
+        std::promise<std::vector<bool>> promise;
+        batch.verify(pool, [&promise](const std::vector<bool>& valid)
+        {
+            promise.set_value(valid);
+        });
+
+        keep(promise.get_future().get());
+    });
+
+    pool.shutdown();
+    pool.join();
+}
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <string>
+#include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 100;
+
+// Serialize through the stream writer, as to_data() did previously.
+template <typename Message>
+static data_chunk to_stream_data(const Message& packet)
+{
+    data_chunk data;
+    data_sink ostream(data);
+    packet.to_data(ostream);
+    ostream.flush();
+    return data;
+}
+
+// Each packet is serialized through a stream and directly into a buffer
+// sized by serialized_size(), and then as a framed wire message into
+// preallocated memory.
+template <typename Message>
+static void measure_message(const std::string& name, const Message& packet,
+    size_t iterations)
+{
+    const auto prefix = name + " (" +
+        std::to_string(packet.serialized_size()) + " bytes) ";
+
+    measure(prefix + "stream", iterations, [&]()
+    {
+        keep(to_stream_data(packet));
+    });
+
+    measure(prefix + "to_data", iterations, [&]()
+    {
+        keep(packet.to_data());
+    });
+
+    data_chunk buffer(packet.serialized_size() + 24);
+    measure(prefix + "serialize into buffer", iterations, [&]()
+    {
+        keep(message::serialize(packet, 0, buffer.data(),
+            buffer.data() + buffer.size()));
+    });
+}
+
+void benchmark_serialize()
+{
+    const auto block = chain::block::factory_from_data(synthetic_block());
+    const auto& transaction = block.transactions.front();
+
+    message::headers headers;
+    for (size_t count = 0; count < 2000; ++count)
+        headers.elements.push_back(block.header);
+
+    measure_message("block", block, iterations);
+    measure_message("transaction", transaction, iterations * 1000);
+    measure_message("headers", headers, iterations);
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::network;
+
+static const size_t pool_size = 100000;
+static const size_t message_size = 1000;
+static const std::string file_name = "benchmark_hosts.cache";
+
+// A distinct IPv4 address for each index, spread across groups.
+static message::network_address make_host(size_t index)
+{
+    message::ip_address ip
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00
+    };
+
+    ip[12] = static_cast<uint8_t>(index);
+    ip[13] = static_cast<uint8_t>(index >> 8);
+    ip[14] = static_cast<uint8_t>(index >> 16);
+    ip[15] = static_cast<uint8_t>(index >> 24);
+
+    auto host = config::authority(ip, 8333).to_network_address();
+    host.timestamp = static_cast<uint32_t>(index);
+    return host;
+}
+
+static code wait(std::function<void(hosts::result_handler)> action)
+{
+    std::promise<code> promise;
+    action([&promise](const code& ec)
+    {
+        promise.set_value(ec);
+    });
+
+    return promise.get_future().get();
+}
+
+// A full pool of 100k hosts is saved and loaded, new hosts are stored into
+// the full pool (evicting) singly and as 1000 address messages, and hosts
+// are fetched.
+void benchmark_hosts()
+{
+    threadpool pool(1);
+    settings config = p2p::mainnet;
+    config.host_pool_capacity = pool_size;
+    config.hosts_file = file_name;
+
+    // One quarter of the hosts are confirmed, filling the tried table.
+    hosts source(pool, config);
+    for (size_t index = 0; index < pool_size; ++index)
+    {
+        source.store(make_host(index), [](const code&) {});
+
+        if (index % 4 == 0)
+            source.confirm(make_host(index), [](const code&) {});
+    }
+
+    size_t stored = 0;
+    source.count([&stored](size_t value) { stored = value; });
+
+    measure("save " + std::to_string(stored), 1, [&]()
+    {
+        wait([&source](hosts::result_handler handler)
+        {
+            source.save(handler);
+        });
+    });
+
+    hosts target(pool, config);
+    measure("load " + std::to_string(stored), 1, [&]()
+    {
+        wait([&target](hosts::result_handler handler)
+        {
+            target.load(handler);
+        });
+    });
+
+    size_t next = pool_size;
+    measure("store into full pool (per address)", message_size, [&]()
+    {
+        target.store(make_host(next++), [](const code&) {});
+    });
+
+    measure("store addr message into full pool", message_size, [&]()
+    {
+        hosts::address::list message;
+        for (size_t index = 0; index < message_size; ++index)
+            message.push_back(make_host(next++));
+
+        target.store(message, [](const code&, const hosts::store_counts& counts)
+        {
+            keep(counts);
+        });
+    });
+
+    measure("fetch", message_size, [&]()
+    {
+        target.fetch([](const code&, const hosts::address& host)
+        {
+            keep(host);
+        });
+    });
+
+    boost::filesystem::remove(file_name);
+    pool.shutdown();
+    pool.join();
+}
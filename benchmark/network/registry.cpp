@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::network;
+
+static const size_t iterations = 10000;
+
+// The linear nonce scan that the pending registry performed previously.
+static bool scan(const std::vector<channel::ptr>& channels, uint64_t nonce)
+{
+    const auto found = [nonce](const channel::ptr& entry)
+    {
+        return entry->nonce() == nonce;
+    };
+
+    return std::find_if(channels.begin(), channels.end(), found) !=
+        channels.end();
+}
+
+// Channels are simulated by unconnected sockets, which is sufficient for
+// the nonce index. A self-connection check for an unknown nonce is the worst
+// case of a linear scan and is measured against the indexed lookup, as is
+// the store and removal of a further channel.
+static void measure_channels(threadpool& pool, size_t count)
+{
+    const auto prefix = std::to_string(count) + " channels ";
+
+    std::vector<channel::ptr> channels;
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto socket = std::make_shared<asio::socket>(pool.service());
+        channels.push_back(std::make_shared<channel>(pool, socket,
+            p2p::testnet));
+        channels.back()->set_nonce(index + 1);
+    }
+
+    pending registry;
+    for (const auto& channel: channels)
+        registry.store(channel, [](const code&) {});
+
+    const auto unknown = count + 1;
+
+    measure(prefix + "linear exists", iterations, [&]()
+    {
+        keep(scan(channels, unknown));
+    });
+
+    measure(prefix + "indexed exists", iterations, [&]()
+    {
+        keep(registry.exists(unknown));
+    });
+
+    const auto socket = std::make_shared<asio::socket>(pool.service());
+    const auto extra = std::make_shared<channel>(pool, socket, p2p::testnet);
+    extra->set_nonce(unknown);
+
+    measure(prefix + "indexed store and remove", iterations, [&]()
+    {
+        registry.store(extra, [](const code&) {});
+        registry.remove(extra, [](const code&) {});
+    });
+
+    registry.clear(error::service_stopped);
+}
+
+void benchmark_registry()
+{
+    threadpool pool(1);
+    measure_channels(pool, 100);
+    measure_channels(pool, 1000);
+    measure_channels(pool, 10000);
+    pool.shutdown();
+    pool.join();
+}
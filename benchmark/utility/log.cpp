@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/date_time.hpp>
+#include <boost/format.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t threads = 4;
+static const size_t lines = 20000;
+static const config::authority peer("127.0.0.1:8333");
+
+// Invoke the action for the given number of lines on each of the threads and
+// print the mean wall time per line.
+template <typename Action>
+static void measure_threads(const std::string& name, Action action)
+{
+    typedef std::chrono::high_resolution_clock clock;
+    const auto start = clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; ++thread)
+        workers.push_back(std::thread([&action]()
+        {
+            for (size_t line = 0; line < lines; ++line)
+                action();
+        }));
+
+    for (auto& worker: workers)
+        worker.join();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - start);
+
+    bc::cout << name << ": " << elapsed.count() / (threads * lines)
+        << " ns" << std::endl;
+}
+
+// The synchronous file sink that network logging used previously.
+static std::mutex file_mutex;
+static void write_locked(std::ofstream& file, const std::string& domain,
+    const std::string& body)
+{
+    const auto message = boost::format("%1% %2% [%3%] %4%\n") %
+        boost::posix_time::microsec_clock::local_time().time_of_day() %
+        bc::log::to_text(bc::log::level::debug) % domain % body;
+
+    std::lock_guard<std::mutex> lock(file_mutex);
+    file << message.str();
+    file.flush();
+}
+
+// A proxy debug line is logged from several threads to a file, by the
+// previous locked sink and by the asynchronous writer. A disabled level
+// skips formatting of the line.
+void benchmark_log()
+{
+    std::ofstream file("/dev/null");
+    const auto body = [](bc::log& line)
+    {
+        line << "Send ping [" << peer << "] (32 bytes)";
+    };
+
+    measure("disabled level", lines, [&body]()
+    {
+        bc::log line(bc::log::level::null, LOG_NETWORK);
+        body(line);
+    });
+
+    // The previous release build debug destination formatted, then ignored.
+    bc::log(bc::log::level::null, "").set_output_function(
+        [](bc::log::level, const std::string&, const std::string&) {});
+
+    measure("ignored level", lines, [&body]()
+    {
+        bc::log line(bc::log::level::null, LOG_NETWORK);
+        body(line);
+    });
+
+    bc::log(bc::log::level::null, "").set_output_function(nullptr);
+
+    measure_threads("locked file sink (4 threads)", [&file]()
+    {
+        std::ostringstream text;
+        text << "Send ping [" << peer << "] (32 bytes)";
+        write_locked(file, LOG_NETWORK, text.str());
+    });
+
+    log_writer writer([&file](bc::log::level, const std::string& text)
+    {
+        file << text;
+        file.flush();
+    }, 65536);
+
+    measure_threads("log writer (4 threads)", [&writer]()
+    {
+        std::ostringstream text;
+        text << "Send ping [" << peer << "] (32 bytes)";
+        writer.write(bc::log::level::debug, LOG_NETWORK, text.str());
+    });
+
+    bc::cout << "log writer dropped: " << writer.dropped() << std::endl;
+}
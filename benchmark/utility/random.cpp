@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdint>
+#include <random>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t iterations = 100000;
+
+// The source that pseudo_random() constructed for each call previously.
+static uint64_t device_random()
+{
+    std::random_device device;
+    std::uniform_int_distribution<uint64_t> distribution;
+    return distribution(device);
+}
+
+// Values are drawn from a new random_device, as previously, and from the
+// thread's chacha20 engine, singly and as a fill of a 32 byte buffer.
+void benchmark_random()
+{
+    measure("random_device", iterations, []()
+    {
+        keep(device_random());
+    });
+
+    measure("pseudo_random", iterations, []()
+    {
+        keep(pseudo_random());
+    });
+
+    data_chunk buffer(32);
+    measure("pseudo_random_fill (32 bytes)", iterations, [&buffer]()
+    {
+        pseudo_random_fill(buffer);
+        keep(buffer);
+    });
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t messages = 100000;
+static const size_t handlers = 8;
+
+typedef subscriber<const code&, size_t> resubscribing_subscriber;
+typedef persistent_subscriber<const code&, size_t> count_subscriber;
+
+// Print the rate at which the action delivers the given number of messages.
+template <typename Action>
+static void throughput(const std::string& name, Action action)
+{
+    typedef std::chrono::high_resolution_clock clock;
+    const auto start = clock::now();
+    action();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        clock::now() - start);
+
+    const auto rate = messages * 1000000 / (elapsed.count() + 1);
+    bc::cout << name << ": " << rate << " messages/sec" << std::endl;
+}
+
+// Count a delivery, relaying the next message once each handler has received
+// the current one, or signalling once every message has been delivered.
+template <typename Subscriber>
+static void deliver(Subscriber subscriber, std::atomic<size_t>& delivered,
+    std::promise<void>& complete)
+{
+    const auto count = ++delivered;
+
+    if (count == messages * handlers)
+        complete.set_value();
+    else if (count % handlers == 0)
+        subscriber->relay(error::success, count / handlers);
+}
+
+// A handler of the existing subscriber, which resubscribes itself for each
+// message as the protocols do.
+static void resubscribe(resubscribing_subscriber::ptr subscriber,
+    std::atomic<size_t>& delivered, std::promise<void>& complete)
+{
+    subscriber->subscribe([subscriber, &delivered, &complete](const code&,
+        size_t)
+    {
+        resubscribe(subscriber, delivered, complete);
+        deliver(subscriber, delivered, complete);
+    });
+}
+
+// Each message is delivered to a number of handlers through the existing
+// strand-ordered subscriber, and through the persistent subscriber both on
+// the threadpool and inline on the calling thread. Messages are relayed one
+// at a time, since the existing subscriber drops messages relayed before a
+// handler has resubscribed.
+void benchmark_subscriber()
+{
+    threadpool pool(1);
+
+    throughput("subscriber relay (resubscribe)", [&pool]()
+    {
+        std::atomic<size_t> delivered(0);
+        std::promise<void> complete;
+        const auto subscriber = std::make_shared<resubscribing_subscriber>(
+            pool, "subscriber", "benchmark");
+
+        for (size_t handler = 0; handler < handlers; ++handler)
+            resubscribe(subscriber, delivered, complete);
+
+        subscriber->relay(error::success, 0);
+        complete.get_future().wait();
+    });
+
+    throughput("persistent_subscriber relay", [&pool]()
+    {
+        std::atomic<size_t> delivered(0);
+        std::promise<void> complete;
+        const auto subscriber = std::make_shared<count_subscriber>(pool);
+        const auto self = subscriber.get();
+
+        for (size_t handler = 0; handler < handlers; ++handler)
+            subscriber->subscribe([self, &delivered, &complete](const code&,
+                size_t)
+            {
+                deliver(self, delivered, complete);
+            });
+
+        subscriber->relay(error::success, 0);
+        complete.get_future().wait();
+    });
+    throughput("persistent_subscriber invoke", [&pool]()
+    {
+        size_t delivered = 0;
+        const auto subscriber = std::make_shared<count_subscriber>(pool);
+
+        for (size_t handler = 0; handler < handlers; ++handler)
+            subscriber->subscribe([&delivered](const code&, size_t)
+            {
+                ++delivered;
+            });
+
+        for (size_t message = 0; message < messages; ++message)
+            subscriber->invoke(error::success, message);
+
+        keep(delivered);
+    });
+
+    pool.shutdown();
+    pool.join();
+}
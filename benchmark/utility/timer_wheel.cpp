@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+
+static const size_t channels = 10000;
+static const size_t iterations = 100000;
+static const asio::duration inactivity(0, 30, 0);
+static const asio::duration expiration(0, 90, 0);
+
+// Each simulated channel restarts its inactivity timer upon every message,
+// as channels did with a deadline each, and as they now touch a timer in a
+// shared wheel. Ticks are measured with three timers pending per channel.
+void benchmark_timer_wheel()
+{
+    threadpool pool(1);
+    const auto prefix = std::to_string(channels) + " channels ";
+    const auto ignore = [](const code&) {};
+
+    std::vector<deadline::ptr> deadlines;
+    for (size_t channel = 0; channel < channels; ++channel)
+    {
+        deadlines.push_back(std::make_shared<deadline>(pool, inactivity));
+        deadlines.back()->start(ignore);
+    }
+
+    size_t next = 0;
+    measure(prefix + "deadline restart", iterations, [&]()
+    {
+        deadlines[next++ % channels]->start(ignore);
+    });
+
+    for (const auto& deadline: deadlines)
+        deadline->cancel();
+
+    const auto wheel = std::make_shared<timer_wheel>(pool,
+        asio::duration(0, 0, 1));
+
+    std::vector<timer_wheel::handle> timers;
+    for (size_t channel = 0; channel < channels; ++channel)
+    {
+        wheel->schedule(expiration, ignore);
+        wheel->schedule(asio::duration(0, 5, 0), ignore);
+        timers.push_back(wheel->schedule(inactivity, ignore));
+    }
+
+    measure(prefix + "wheel touch", iterations, [&]()
+    {
+        wheel->touch(timers[next++ % channels], inactivity);
+    });
+
+    measure(prefix + "wheel tick", iterations / 100, [&]()
+    {
+        wheel->tick();
+    });
+
+    measure(prefix + "wheel schedule and cancel", iterations, [&]()
+    {
+        wheel->cancel(wheel->schedule(inactivity, ignore));
+    });
+
+    wheel->stop();
+    pool.shutdown();
+    pool.join();
+}
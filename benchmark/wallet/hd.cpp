@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::wallet;
+
+static const size_t iterations = 100;
+static const size_t children = 1000;
+
+// An address gap scan derives consecutive external children of an account.
+void benchmark_hd()
+{
+    const data_chunk seed(32, 0x42);
+    const hd_private master(seed, hd_private::mainnet);
+    const hd_public account = master.derive_public(hd_first_hardened_key);
+
+    measure("derive_public (1000 x single)", iterations, [&]()
+    {
+        for (uint32_t index = 0; index < children; ++index)
+            keep(account.derive_public(index));
+    });
+
+    std::vector<hd_public> keys(children);
+    measure("derive_public (range of 1000)", iterations, [&]()
+    {
+        account.derive_public(keys.data(), 0, children);
+        keep(keys);
+    });
+
+    std::vector<short_hash> hashes(children);
+    measure("derive_address_hashes (range of 1000)", iterations, [&]()
+    {
+        account.derive_address_hashes(hashes.data(), 0, children);
+        keep(hashes);
+    });
+
+    threadpool pool(4);
+    measure("derive_address_hashes (range of 1000, 4 threads)", iterations,
+        [&]()
+    {
+        std::promise<void> promise;
+        account.derive_address_hashes(pool, hashes.data(), 0, children,
+            [&promise]() { promise.set_value(); });
+
+        promise.get_future().wait();
+        keep(hashes);
+    });
+
+    pool.shutdown();
+    pool.join();
+
+    measure("derive_private (1000 x single)", iterations, [&]()
+    {
+        for (uint32_t index = 0; index < children; ++index)
+            keep(master.derive_private(index));
+    });
+
+    std::vector<hd_private> secrets(children);
+    measure("derive_private (range of 1000)", iterations, [&]()
+    {
+        master.derive_private(secrets.data(), 0, children);
+        keep(secrets);
+    });
+}
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include "../benchmark.hpp"
+
+using namespace bc;
+using namespace bc::wallet;
+
+static const size_t iterations = 10;
+static const size_t mnemonics = 16;
+static const size_t rounds = 2048;
+
+// The derivation as previously implemented, the full hmac (including the
+// hashing of the key into its pads) being computed for every round.
+static long_hash rekeyed_seed(data_slice sentence, data_slice salt)
+{
+    static const data_chunk first_block{ 0, 0, 0, 1 };
+    auto digest = hmac_sha512_hash(build_chunk({ salt, first_block }),
+        sentence);
+    auto seed = digest;
+
+    for (size_t round = 1; round < rounds; ++round)
+    {
+        digest = hmac_sha512_hash(digest, sentence);
+        for (size_t byte = 0; byte < seed.size(); ++byte)
+            seed[byte] ^= digest[byte];
+    }
+
+    return seed;
+}
+
+// Seeds per second is the number of mnemonics over each reported duration.
+void benchmark_mnemonic()
+{
+    std::vector<word_list> words;
+    for (size_t index = 0; index < mnemonics; ++index)
+    {
+        data_chunk entropy(16, static_cast<uint8_t>(index));
+        words.push_back(create_mnemonic(entropy));
+    }
+
+    const auto salt = to_chunk(std::string("mnemonic"));
+    measure("rekeyed hmac (16 seeds)", iterations, [&]()
+    {
+        for (const auto& mnemonic: words)
+            keep(rekeyed_seed(to_chunk(join(mnemonic)), salt));
+    });
+
+    measure("decode_mnemonic (16 x single)", iterations, [&]()
+    {
+        for (const auto& mnemonic: words)
+            keep(decode_mnemonic(mnemonic));
+    });
+
+    measure("decode_mnemonics (16 seeds)", iterations, [&]()
+    {
+        keep(decode_mnemonics(words));
+    });
+}
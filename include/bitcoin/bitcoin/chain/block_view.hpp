@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+#define LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/**
+ * A block parsed in place over borrowed bytes, such as a network payload or
+ * a memory mapped file. Transactions, inputs and outputs are recorded as
+ * slices of the bytes, in three flat lists for the whole block, so that
+ * parsing allocates only those lists. Scripts are not parsed, and owned
+ * objects are materialized only on demand.
+ * The bytes must outlive the view and remain unchanged.
+ */
+class BC_API block_view
+{
+public:
+    struct input
+    {
+        /// The serialized previous output point (hash and index).
+        data_slice previous_output;
+        data_slice script;
+        uint32_t sequence;
+    };
+
+    struct output
+    {
+        uint64_t value;
+        data_slice script;
+    };
+
+    struct transaction
+    {
+        /// The serialized transaction.
+        data_slice data;
+        uint32_t version;
+        uint32_t locktime;
+
+        /// The positions of the transaction's inputs and outputs within the
+        /// inputs and outputs of the block.
+        size_t first_input;
+        size_t input_count;
+        size_t first_output;
+        size_t output_count;
+    };
+
+    bool from_data(data_slice data);
+    void reset();
+
+    const chain::header& header() const;
+    const std::vector<transaction>& transactions() const;
+    const std::vector<input>& inputs() const;
+    const std::vector<output>& outputs() const;
+
+    /// Materialize an owned copy of the transaction at index.
+    chain::transaction to_transaction(size_t index) const;
+
+    /// Materialize an owned copy of the block.
+    block to_block() const;
+
+    /// The hashes of the transactions, from their bytes.
+    hash_list transaction_hashes() const;
+    hash_digest generate_merkle_root() const;
+
+private:
+    chain::header header_;
+    std::vector<transaction> transactions_;
+    std::vector<input> inputs_;
+    std::vector<output> outputs_;
+};
+
+} // namspace chain
+} // namspace libbitcoin
+
+#endif
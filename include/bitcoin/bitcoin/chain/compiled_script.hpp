@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_COMPILED_SCRIPT_HPP
+#define LIBBITCOIN_CHAIN_COMPILED_SCRIPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/opcode.hpp>
+#include <bitcoin/bitcoin/chain/operation.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/**
+ * A script flattened for repeated evaluation.
+ * The serialized script is held in one contiguous buffer and each operation
+ * is reduced to a fixed size instruction referencing its push data within
+ * that buffer, so evaluation copies no operations. Limits that do not depend
+ * upon execution (script size, push size, disabled opcodes and operation
+ * count) are checked once here, and the script pattern is retained.
+ * Compiling into an existing instance reuses its allocations.
+ */
+class BC_API compiled_script
+{
+public:
+    static BC_CONSTEXPR size_t max_script_size = 10000;
+    static BC_CONSTEXPR size_t max_push_data_size = 520;
+    static BC_CONSTEXPR size_t max_operation_count = 201;
+
+    struct instruction
+    {
+        opcode code;
+
+        /// Offset of the serialized operation within the buffer.
+        uint32_t begin;
+
+        /// Offset and size of the operation data within the buffer.
+        uint32_t data;
+        uint32_t size;
+    };
+
+    typedef std::vector<instruction> program;
+
+    compiled_script();
+    compiled_script(const script& script);
+
+    void compile(const script& script);
+
+    /// False if evaluation of the script must fail.
+    bool is_valid() const;
+    bool is_push_only() const;
+    script_pattern pattern() const;
+
+    const program& instructions() const;
+
+    /// The serialized script (without length prefix).
+    const data_chunk& buffer() const;
+
+    /// The data of the instruction.
+    data_slice data(const instruction& instruction) const;
+
+    /// The serialization of the instructions in [first, last).
+    data_slice code(size_t first, size_t last) const;
+
+private:
+    data_chunk buffer_;
+    program instructions_;
+    script_pattern pattern_;
+    bool push_only_;
+    bool valid_;
+};
+
+} // namspace chain
+} // namspace libbitcoin
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_HASH_CACHE_HPP
+#define LIBBITCOIN_CHAIN_HASH_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/**
+ * The memoized hash of a value type. The hash may be set from concurrent
+ * const accessors (the first to claim it writes it, and the rest continue
+ * with their own identical result). Copies carry the hash, and clearing
+ * requires exclusive access, as does any mutation of the owner.
+ */
+class BC_API hash_cache
+{
+public:
+    hash_cache();
+    hash_cache(const hash_cache& other);
+    hash_cache& operator=(const hash_cache& other);
+
+    /// Obtain the cached hash, returns false if not cached.
+    bool get(hash_digest& out) const;
+
+    /// Cache the hash, unless it is cached or being cached.
+    void set(const hash_digest& hash) const;
+
+    void clear();
+
+private:
+    enum state : uint8_t
+    {
+        empty,
+        writing,
+        cached
+    };
+
+    mutable std::atomic<uint8_t> state_;
+    mutable hash_digest hash_;
+};
+
+} // namspace chain
+} // namspace libbitcoin
+
+#endif
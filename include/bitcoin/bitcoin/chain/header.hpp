@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/hash_cache.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -45,6 +46,11 @@ public:
     static header factory_from_data(reader& source,
         bool with_transaction_count = true);
 
+    header();
+    header(uint32_t version, const hash_digest& previous_block_hash,
+        const hash_digest& merkle, uint32_t timestamp, uint32_t bits,
+        uint32_t nonce, uint64_t transaction_count = 0);
+
     bool from_data(const data_chunk& data, bool with_transaction_count = true);
     bool from_data(std::istream& stream, bool with_transaction_count = true);
     bool from_data(reader& source, bool with_transaction_count = true);
@@ -52,6 +58,13 @@ public:
     void to_data(std::ostream& stream, bool with_transaction_count = true) const;
     void to_data(writer& sink, bool with_transaction_count = true) const;
     hash_digest hash() const;
+
+    /// The hash, memoized on first use and captured from the bytes read by
+    /// from_data. The fields are public, so a caller that changes them once
+    /// the hash is cached must invalidate it (reset and from_data do so).
+    hash_digest cached_hash() const;
+    void invalidate_hash();
+
     bool is_valid() const;
     void reset();
     uint64_t serialized_size(bool with_transaction_count = true) const;
@@ -65,6 +78,9 @@ public:
     uint32_t bits;
     uint32_t nonce;
     uint64_t transaction_count;
+
+private:
+    hash_cache hash_cache_;
 };
 
 BC_API bool operator==(const header& left, const header& right);
@@ -31,8 +31,14 @@
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
+
+class evaluation_context;
+
 namespace chain {
 
+class compiled_script;
+class script_verifier;
+class signature_hash_cache;
 class BC_API transaction;
 
 /// Signature hash types.
@@ -103,11 +109,29 @@ public:
     static bool verify(const script& input_script,
         const script& output_script, const transaction& parent_tx,
         uint32_t input_index, bool bip16_enabled=true);
-    static hash_digest generate_signature_hash(transaction parent_tx,
+    static hash_digest generate_signature_hash(const transaction& parent_tx,
         uint32_t input_index, const script& script_code, uint32_t hash_type);
     static bool check_signature(data_slice signature,
         const data_chunk& point, const script& script_code,
         const transaction& parent_tx, uint32_t input_index);
+
+    // These share the signature hash cache across all inputs of one tx.
+    static bool verify(const script& input_script,
+        const script& output_script, const signature_hash_cache& cache,
+        uint32_t input_index, bool bip16_enabled=true);
+    static hash_digest generate_signature_hash(
+        const signature_hash_cache& cache, uint32_t input_index,
+        const script& script_code, uint32_t hash_type);
+    static bool check_signature(data_slice signature,
+        const data_chunk& point, const script& script_code,
+        const signature_hash_cache& cache, uint32_t input_index);
+
+    // This evaluates scripts precompiled for repeated evaluation.
+    static bool verify(const compiled_script& input_script,
+        const compiled_script& output_script,
+        const signature_hash_cache& cache, uint32_t input_index,
+        bool bip16_enabled=true);
+
     static bool create_signature(endorsement& signature,
         const ec_secret& secret, const script& prevout_script,
         const transaction& tx, uint32_t input_index, uint32_t hash_type);
@@ -131,6 +155,15 @@ public:
     operation::stack operations;
 
 private:
+    friend class script_verifier;
+
+    // Evaluates within the given contexts so that their stacks may be reused.
+    static bool verify(const compiled_script& input_script,
+        const compiled_script& output_script,
+        const signature_hash_cache& cache, uint32_t input_index,
+        bool bip16_enabled, evaluation_context& input_context,
+        evaluation_context& output_context);
+
     bool deserialize(const data_chunk& raw_script, parse_mode mode);
     bool parse(const data_chunk& raw_script);
 };
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_SCRIPT_VERIFIER_HPP
+#define LIBBITCOIN_CHAIN_SCRIPT_VERIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/**
+ * Verifies the input scripts of a transaction or block in parallel.
+ * Inputs are distributed over the threads of the pool, each of which reuses
+ * its own compiled scripts and evaluation stacks across the inputs it
+ * verifies. Signature hashes are shared across the inputs of each transaction.
+ * Given a signature cache, which must outlive the verifier, signatures found
+ * in it are not verified again and valid signatures are added to it.
+ * Once an input fails no input following it (in block order) is started,
+ * and the reported failure is always the first failing input in block order,
+ * independent of thread scheduling. The transaction or block must remain
+ * unchanged until the handler is invoked.
+ */
+class BC_API script_verifier
+{
+public:
+    /// Obtain the output script of the previous output. Return false if the
+    /// previous output cannot be found. Invoked concurrently from the pool.
+    typedef std::function<bool(const output_point&, script&)> prevout_fetcher;
+
+    /// Invoked once, from a pool thread (or from the calling thread if the
+    /// pool has no threads), with the first failing input on failure, or
+    /// with error::success and zero indexes on success.
+    typedef std::function<void(const code&, size_t tx_index,
+        uint32_t input_index)> result_handler;
+
+    script_verifier(threadpool& pool);
+
+    /// Verify signatures through the cache, which must outlive the verifier.
+    script_verifier(threadpool& pool, signature_cache& signatures);
+
+    /// This class is not copyable.
+    script_verifier(const script_verifier&) = delete;
+    void operator=(const script_verifier&) = delete;
+
+    /// Verify all inputs of all non-coinbase transactions of the block.
+    void verify(const block& block, prevout_fetcher fetch,
+        result_handler handler, bool bip16_enabled=true);
+
+    /// Verify all inputs of the transaction (tx_index is always zero).
+    void verify(const transaction& tx, prevout_fetcher fetch,
+        result_handler handler, bool bip16_enabled=true);
+
+private:
+    class batch;
+
+    void start(std::shared_ptr<batch> work);
+
+    threadpool& pool_;
+    signature_cache* const signatures_;
+};
+
+} // namspace chain
+} // namspace libbitcoin
+
+#endif
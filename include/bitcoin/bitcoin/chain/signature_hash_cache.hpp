@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_SIGNATURE_HASH_CACHE_HPP
+#define LIBBITCOIN_CHAIN_SIGNATURE_HASH_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+class script;
+class transaction;
+
+/**
+ * Signature hash generator for the inputs of a single transaction.
+ * The serialized outpoints and outputs are computed once on construction and
+ * streamed into sha256 for each signature hash, so the transaction is never
+ * copied or reserialized. For sighash::all the hash state of each preceding
+ * input sequence is also cached (on first use), so the common prefix is
+ * hashed only once across all inputs of the transaction.
+ * The transaction must remain unchanged for the lifetime of this object.
+ * Signatures checked through the object are verified against the signature
+ * cache if one is given, which must outlive it.
+ * Instances are safe for concurrent generation once constructed.
+ */
+class BC_API signature_hash_cache
+{
+public:
+    signature_hash_cache(const transaction& parent_tx);
+    signature_hash_cache(const transaction& parent_tx,
+        signature_cache& signatures);
+
+    /// Copying the cache would not share the lazily computed midstates.
+    signature_hash_cache(const signature_hash_cache&) = delete;
+    void operator=(const signature_hash_cache&) = delete;
+
+    const transaction& parent_tx() const;
+
+    /// Equivalent to script::generate_signature_hash over the parent tx.
+    hash_digest generate(uint32_t input_index, const script& script_code,
+        uint32_t hash_type) const;
+
+    /// As above, given the script code serialized without length prefix.
+    hash_digest generate(uint32_t input_index, data_slice script_code,
+        uint32_t hash_type) const;
+
+    /// Verify a signature of the parent tx, through the cache if present.
+    bool verify_signature(const data_chunk& point, const hash_digest& hash,
+        const endorsement& signature) const;
+
+private:
+    signature_hash_cache(const transaction& parent_tx,
+        signature_cache* signatures);
+
+    void write_point(sha256_context& context, uint32_t input_index) const;
+    void write_blank_input(sha256_context& context, uint32_t input_index,
+        bool zero_sequence) const;
+    void write_outputs(sha256_context& context, uint32_t input_index,
+        uint32_t hash_type) const;
+    void initialize_midstates() const;
+
+    const transaction& parent_tx_;
+    data_chunk points_;
+    data_chunk outputs_;
+    std::vector<size_t> output_offsets_;
+    signature_cache* const signatures_;
+
+    mutable std::once_flag mutex_;
+    mutable std::vector<sha256_context> midstates_;
+};
+
+} // namspace chain
+} // namspace libbitcoin
+
+#endif
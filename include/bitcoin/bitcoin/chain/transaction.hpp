@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/hash_cache.hpp>
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -44,6 +45,10 @@ public:
     static transaction factory_from_data(reader& source);
     static uint64_t satoshi_fixed_size();
 
+    transaction();
+    transaction(uint32_t version, uint32_t locktime,
+        const input::list& inputs, const output::list& outputs);
+
     bool from_data(const data_chunk& data);
     bool from_data(std::istream& stream);
     bool from_data(reader& source);
@@ -55,6 +60,12 @@ public:
     void reset();
     hash_digest hash() const;
 
+    /// The hash, memoized on first use and captured from the bytes read by
+    /// from_data. The fields are public, so a caller that changes them once
+    /// the hash is cached must invalidate it (reset and from_data do so).
+    hash_digest cached_hash() const;
+    void invalidate_hash();
+
     // hash_type_code is used by OP_CHECKSIG
     hash_digest hash(uint32_t hash_type_code) const;
     bool is_coinbase() const;
@@ -69,6 +80,9 @@ public:
     uint32_t locktime;
     input::list inputs;
     output::list outputs;
+
+private:
+    hash_cache hash_cache_;
 };
 
 } // namspace chain
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <boost/functional/hash.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
 #include <bitcoin/bitcoin/network/asio.hpp>
@@ -171,4 +172,21 @@ private:
 } // namespace config
 } // namespace libbitcoin
 
+// Allow authority to be indexed in std::unordered_* classes.
+namespace std
+{
+    template <>
+    struct hash<bc::config::authority>
+    {
+        size_t operator()(const bc::config::authority& authority) const
+        {
+            const auto ip = authority.ip();
+            auto seed = boost::hash_range(ip.begin(), ip.end());
+            boost::hash_combine(seed, authority.port());
+            return seed;
+        }
+    };
+
+} // namespace std
+
 #endif
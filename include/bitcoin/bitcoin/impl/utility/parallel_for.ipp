@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_FOR_IPP
+#define LIBBITCOIN_PARALLEL_FOR_IPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+template <typename State, typename Body>
+void parallel_for(threadpool& pool, size_t count, size_t grain, Body body,
+    std::function<void()> complete)
+{
+    grain = std::max(grain, size_t(1));
+    const auto next = std::make_shared<std::atomic<size_t>>(0);
+
+    const auto task = [=]()
+    {
+        State state;
+
+        for (auto first = next->fetch_add(grain); first < count;
+            first = next->fetch_add(grain))
+            body(state, first, std::min(first + grain, count));
+    };
+
+    // Without pool threads nothing posted would run.
+    const auto threads = pool.size();
+    if (threads == 0)
+    {
+        task();
+        complete();
+        return;
+    }
+
+    // Tasks beyond the number of pool threads would only queue.
+    const auto ranges = (count + grain - 1) / grain;
+    const auto tasks = std::max(std::min(threads, ranges), size_t(1));
+    const auto remaining = std::make_shared<std::atomic<size_t>>(tasks);
+
+    for (size_t index = 0; index < tasks; ++index)
+    {
+        pool.service().post([=]()
+        {
+            task();
+
+            if (--*remaining == 0)
+                complete();
+        });
+    }
+}
+
+// The state of a body that needs none.
+struct parallel_for_stateless
+{
+};
+
+template <typename Body>
+void parallel_for(threadpool& pool, size_t count, size_t grain, Body body,
+    std::function<void()> complete)
+{
+    const auto stateless = [body](parallel_for_stateless&, size_t first,
+        size_t last)
+    {
+        body(first, last);
+    };
+
+    parallel_for<parallel_for_stateless>(pool, count, grain, stateless,
+        complete);
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PERSISTENT_SUBSCRIBER_IPP
+#define LIBBITCOIN_PERSISTENT_SUBSCRIBER_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+template <typename... Args>
+persistent_subscriber<Args...>::persistent_subscriber(threadpool& pool)
+  : dispatch_(pool), next_token_(0), subscriptions_(std::make_shared<list>())
+{
+}
+
+template <typename... Args>
+typename persistent_subscriber<Args...>::token
+    persistent_subscriber<Args...>::subscribe(handler notifier)
+{
+    const auto subscription = next_token_++;
+    auto current = std::atomic_load(&subscriptions_);
+    list_ptr next;
+
+    // Publish a copy with the handler added, retrying if raced.
+    do
+    {
+        auto updated = std::make_shared<list>(*current);
+        updated->emplace_back(subscription, notifier);
+        next = updated;
+    } while (!std::atomic_compare_exchange_weak(&subscriptions_, &current,
+        next));
+
+    return subscription;
+}
+
+template <typename... Args>
+bool persistent_subscriber<Args...>::unsubscribe(token subscription)
+{
+    const auto match = [subscription](const typename list::value_type& value)
+    {
+        return value.first == subscription;
+    };
+
+    auto current = std::atomic_load(&subscriptions_);
+    list_ptr next;
+
+    // Publish a copy with the handler removed, retrying if raced.
+    do
+    {
+        const auto it = std::find_if(current->begin(), current->end(), match);
+        if (it == current->end())
+            return false;
+
+        auto updated = std::make_shared<list>(*current);
+        updated->erase(updated->begin() + (it - current->begin()));
+        next = updated;
+    } while (!std::atomic_compare_exchange_weak(&subscriptions_, &current,
+        next));
+
+    return true;
+}
+
+template <typename... Args>
+void persistent_subscriber<Args...>::relay(Args... args)
+{
+    dispatch_.concurrent(&persistent_subscriber<Args...>::invoke,
+        this->shared_from_this(), std::move(args)...);
+}
+
+template <typename... Args>
+void persistent_subscriber<Args...>::invoke(Args... args) const
+{
+    // The snapshot remains valid while handlers change subscriptions.
+    const auto subscriptions = std::atomic_load(&subscriptions_);
+    for (const auto& subscription: *subscriptions)
+        subscription.second(args...);
+}
+
+template <typename... Args>
+size_t persistent_subscriber<Args...>::size() const
+{
+    return std::atomic_load(&subscriptions_)->size();
+}
+
+} // namespace libbitcoin
+
+#endif
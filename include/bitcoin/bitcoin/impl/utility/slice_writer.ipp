@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SLICE_WRITER_IPP
+#define LIBBITCOIN_SLICE_WRITER_IPP
+
+#include <cstddef>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+template <typename Write>
+data_chunk write_sized(size_t size, Write write)
+{
+    data_chunk data(size);
+
+    while (true)
+    {
+        slice_writer sink(data);
+        write(sink);
+
+        if (sink)
+        {
+            data.resize(sink.position());
+            return data;
+        }
+
+        // The size was too small, retry with room to spare.
+        data.resize(2 * data.size() + 64);
+    }
+}
+
+template <typename Serializable>
+data_chunk to_sized_data(const Serializable& value)
+{
+    return write_sized(value.serialized_size(), [&value](slice_writer& sink)
+    {
+        value.to_data(sink);
+    });
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
@@ -42,11 +43,12 @@ void subscriber<Args...>::subscribe(handler notifier)
         this->shared_from_this(), notifier);
 }
 
+// The arguments are moved into the job, a shared pointer is not deep copied.
 template <typename... Args>
 void subscriber<Args...>::relay(Args... args)
 {
     dispatch_.ordered(&subscriber<Args...>::do_relay,
-        this->shared_from_this(), args...);
+        this->shared_from_this(), std::move(args)...);
 }
 
 template <typename... Args>
@@ -61,9 +63,10 @@ void subscriber<Args...>::do_relay(Args... args)
     if (subscriptions_.empty())
         return;
 
-    const auto subscriptions_copy = subscriptions_;
-    subscriptions_.clear();
-    for (const auto notifier: subscriptions_copy)
+    // Take the subscriptions, handlers may resubscribe during notification.
+    list subscriptions;
+    subscriptions.swap(subscriptions_);
+    for (const auto& notifier: subscriptions)
         notifier(args...);
 }
 
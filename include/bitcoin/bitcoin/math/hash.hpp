@@ -20,7 +20,9 @@
 #ifndef LIBBITCOIN_HASH_HPP
 #define LIBBITCOIN_HASH_HPP
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
@@ -97,6 +99,31 @@ BC_API hash_digest sha256_hash(data_slice data);
  */
 BC_API hash_digest sha256_hash(data_slice first, data_slice second);
 
+/**
+ * Incremental sha256 hashing of non-contiguous data. The context is a value
+ * type, so a common prefix can be hashed once and the resulting midstate
+ * copied and resumed for each distinct suffix.
+ */
+class BC_API sha256_context
+{
+public:
+    sha256_context();
+
+    /// Append data to the hashed message.
+    void update(data_slice data);
+    void update(const uint8_t* data, size_t size);
+
+    /// Obtain sha256 of the data appended so far, context is unchanged.
+    hash_digest digest() const;
+
+private:
+    static BC_CONSTEXPR size_t block_size = 64;
+
+    uint64_t size_;
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, block_size> buffer_;
+};
+
 /**
  * Generate a hmac sha256 hash. This hash function is used in deterministic
  * signing.
@@ -119,6 +146,34 @@ BC_API long_hash sha512_hash(data_slice data);
  */
 BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 
+/**
+ * Incremental hmac sha512 of non-contiguous data. The key is hashed into the
+ * inner and outer midstates once, on construction. The context is a value
+ * type, so a keyed context can be copied for each message under the key.
+ */
+class BC_API hmac_sha512_context
+{
+public:
+    hmac_sha512_context(data_slice key);
+
+    /// Append data to the authenticated message.
+    void update(data_slice data);
+    void update(const uint8_t* data, size_t size);
+
+    /// Obtain hmac sha512 of the data appended so far, context is unchanged.
+    long_hash digest() const;
+
+private:
+    static BC_CONSTEXPR size_t block_size = 128;
+
+    long_hash finish();
+
+    uint64_t size_;
+    std::array<uint64_t, 8> state_;
+    std::array<uint64_t, 8> outer_;
+    std::array<uint8_t, block_size> buffer_;
+};
+
 /**
  * Generate a pkcs5 pbkdf2 hmac sha512 hash. This hash function is used in
  * bip39 mnemonics.
@@ -128,6 +183,16 @@ BC_API long_hash hmac_sha512_hash(data_slice data, data_slice key);
 BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations);
 
+/**
+ * Generate the pkcs5 pbkdf2 hmac sha512 hash of each passphrase with the salt
+ * of the same position, as pkcs5_pbkdf2_hmac_sha512. The lists must be of
+ * equal size. Where the processor supports it the derivations are iterated
+ * in parallel vector lanes.
+ */
+BC_API long_hash_list pkcs5_pbkdf2_hmac_sha512_many(
+    const std::vector<data_slice>& passphrases,
+    const std::vector<data_slice>& salts, size_t iterations);
+
 /**
  * Generate a typical bitcoin hash. This is the most widely used
  * hash function in Bitcoin.
@@ -136,6 +201,36 @@ BC_API long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
  */
 BC_API hash_digest bitcoin_hash(data_slice data);
 
+/**
+ * Generate the bitcoin hash of each item, as bitcoin_hash(item). Where the
+ * processor supports it the items are hashed in parallel vector lanes.
+ *
+ * sha256(sha256(item)) for each item
+ */
+BC_API hash_list bitcoin_hash_many(const std::vector<data_slice>& items);
+
+/**
+ * Generate the bitcoin hash of each of count consecutive pairs of hashes, as
+ * for a level of a merkle tree, writing count hashes to out. The output may
+ * be the same as the input, in which case the level is reduced in place.
+ *
+ * sha256(sha256(in[2 * i] + in[2 * i + 1])) for each i in [0, count)
+ */
+BC_API void bitcoin_hash_pairs(hash_digest* out, const hash_digest* in,
+    size_t count);
+
+/**
+ * The sha256 implementations supported by this processor, in order of
+ * preference. The first is used unless another is selected.
+ */
+BC_API std::vector<std::string> sha256_implementations();
+
+/**
+ * Select the named sha256 implementation for all subsequent hashing, for
+ * testing and benchmarking. Returns false if it is not supported here.
+ */
+BC_API bool select_sha256_implementation(const std::string& name);
+
 /**
  * Generate a bitcoin short hash. This hash function is used in a
  * few specific cases where short hashes are desired.
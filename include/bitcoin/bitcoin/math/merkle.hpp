@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MERKLE_HPP
+#define LIBBITCOIN_MERKLE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Generate the merkle root of the leaves, or null_hash if there are none.
+ * Where a level has an odd number of nodes the last is paired with itself.
+ */
+BC_API hash_digest merkle_root(const hash_list& leaves);
+
+/**
+ * Generate the merkle root of the leaves, reducing each level in place over
+ * the list. The list is not resized, but its contents are consumed.
+ */
+BC_API hash_digest reduce_merkle_root(hash_list& leaves);
+
+/**
+ * Generate the merkle branch of the leaf at index, the sibling of each node
+ * on the path from the leaf to the root. Empty if index is out of range.
+ */
+BC_API hash_list merkle_branch(const hash_list& leaves, size_t index);
+
+/**
+ * Generate the merkle root implied by a leaf at index and its branch.
+ */
+BC_API hash_digest merkle_branch_root(const hash_digest& leaf,
+    const hash_list& branch, size_t index);
+
+/**
+ * Generate the partial merkle tree (bip37) of the leaves, which proves the
+ * inclusion of each matched leaf. Nodes are traversed depth first, with a
+ * flag for each (set if it is an ancestor of a match, or is a matched leaf)
+ * and a hash for each node that is not descended (unmatched or a leaf).
+ * @param[out] out_hashes  The hashes of the partial tree.
+ * @param[out] out_flags   The flags of the partial tree, packed lsb first.
+ * @param[in]  leaves      The leaves of the full tree.
+ * @param[in]  matches     A match flag for each leaf (missing is unmatched).
+ */
+BC_API void partial_merkle_tree(hash_list& out_hashes, data_chunk& out_flags,
+    const hash_list& leaves, const std::vector<bool>& matches);
+
+} // namespace libbitcoin
+
+#endif
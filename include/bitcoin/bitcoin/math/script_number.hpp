@@ -47,7 +47,7 @@ public:
 
     // Undefined state. set_data() must be called after.
     BC_API script_number();
-    BC_API bool set_data(const data_chunk& data);
+    BC_API bool set_data(data_slice data);
 
     BC_API data_chunk data() const;
     BC_API int32_t int32() const;
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRYPT_HPP
+#define LIBBITCOIN_SCRYPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Scrypt with fixed parameters, retaining its working memory (128 * r * N
+ * bytes for each block mixed at once) from one hash to the next. The p blocks
+ * are mixed in the vector lanes of the selected implementation and, given a
+ * pool, concurrently on the calling thread and the threads of the pool.
+ * A context may not be used concurrently, use one for each thread.
+ */
+class BC_API scrypt_context
+{
+public:
+    /// Throws as scrypt if the parameters are invalid.
+    scrypt_context(uint64_t N, uint32_t p, uint32_t r);
+
+    /// As above, mixing on the threads of the pool as well.
+    scrypt_context(uint64_t N, uint32_t p, uint32_t r, threadpool& pool);
+
+    /// This class is not copyable.
+    scrypt_context(const scrypt_context&) = delete;
+    void operator=(const scrypt_context&) = delete;
+
+    /// Generate a scrypt hash of specified length.
+    data_chunk hash(data_slice data, data_slice salt, size_t length);
+
+    /// Generate a scrypt hash to fill a byte array.
+    template <size_t Size>
+    byte_array<Size> hash(data_slice data, data_slice salt);
+
+    /// Write a scrypt hash of specified length to out.
+    void hash(uint8_t* out, size_t length, data_slice data, data_slice salt);
+
+private:
+    class job;
+
+    scrypt_context(uint64_t N, uint32_t p, uint32_t r, threadpool* pool);
+
+    void mix();
+
+    const uint64_t N_;
+    const uint32_t p_;
+    const uint32_t r_;
+    threadpool* const pool_;
+    data_chunk blocks_;
+
+    // Each participant in the mixing has its own memory and scratch.
+    std::vector<std::vector<uint32_t>> memory_;
+};
+
+/**
+ * The scrypt implementations supported by this processor, in order of
+ * preference. The first is used unless another is selected.
+ */
+BC_API std::vector<std::string> scrypt_implementations();
+
+/**
+ * Select the named scrypt implementation for all subsequent hashing, for
+ * testing and benchmarking. Returns false if it is not supported here.
+ */
+BC_API bool select_scrypt_implementation(const std::string& name);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/math/scrypt.ipp>
+
+#endif
@@ -20,9 +20,13 @@
 #ifndef LIBBITCOIN_SECP256K1_INITIALIZER_HPP
 #define LIBBITCOIN_SECP256K1_INITIALIZER_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <mutex>
 #include <secp256k1.h>
+#include <boost/thread/tss.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 
 namespace libbitcoin {
 
@@ -31,11 +35,20 @@ namespace libbitcoin {
  * This class holds no static state but will only initialize its state once for
  * the given mutex. This can be assigned to a static or otherwise. It lazily
  * inits the context once and destroys the context on destruct as necessary.
+ * Optionally each calling thread obtains its own clone of the context, so
+ * threads never share mutable context state, and the blinding of per-thread
+ * signing contexts is periodically re-randomized.
  */
 class BC_API secp256k1_initializer
 {
-private:
-    static void set_context(secp256k1_context** context, int flags);
+public:
+    /// Times taken to create, clone and re-randomize contexts.
+    struct statistics
+    {
+        histogram create;
+        histogram clone;
+        histogram randomize;
+    };
 
 protected:
     int flags_;
@@ -54,12 +67,48 @@ public:
 
     /**
      * Call to obtain the secp256k1 context, initialized on first call.
+     * With per thread contexts this is the calling thread's clone.
      */
     secp256k1_context* context();
 
+    /**
+     * Create the context now, so that its precomputed tables are not
+     * generated on first use in a latency sensitive path.
+     */
+    void initialize();
+
+    /**
+     * Give each calling thread its own clone of the context (or not).
+     * Clones are made on the first subsequent call to context() by a thread.
+     */
+    void set_per_thread(bool enabled);
+
+    /**
+     * Re-randomize the blinding of a per-thread signing context after the
+     * given number of uses of it, zero to disable.
+     */
+    void set_randomize_interval(size_t uses);
+
+    /**
+     * The context creation and randomization times of this initializer.
+     */
+    const statistics& metrics() const;
+
 private:
+    struct local;
+
+    static void release(local* instance);
+
+    void create();
+    void randomize(secp256k1_context* context);
+    secp256k1_context* local_context();
+
     std::once_flag mutex_;
     secp256k1_context* context_;
+    std::atomic<bool> per_thread_;
+    std::atomic<size_t> randomize_interval_;
+    boost::thread_specific_ptr<local> locals_;
+    statistics statistics_;
 };
 
 /**
@@ -98,6 +147,13 @@ extern secp256k1_signing signing;
  */
 extern secp256k1_verification verification;
 
+/**
+ * Create the signing and verification contexts at startup rather than on
+ * first use, optionally giving each thread its own clone of each context.
+ * @param[in]  per_thread  Give each thread its own clone of the contexts.
+ */
+BC_API void initialize_secp256k1(bool per_thread=false);
+
 } // namespace libbitcoin
 
 #endif
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIGNATURE_BATCH_HPP
+#define LIBBITCOIN_SIGNATURE_BATCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Queue of (point, signature hash, signature) triples verified together.
+ * Each distinct point is stored and checked for structure once, however many
+ * signatures refer to it. Verification is spread over the threads of a pool
+ * and, given a cache, skips cached signatures and caches valid ones.
+ */
+class BC_API signature_batch
+{
+public:
+    /// Invoked once, from a pool thread (or from the calling thread if the
+    /// pool has no threads), with the validity of each triple in the order
+    /// added.
+    typedef std::function<void(const std::vector<bool>& valid)>
+        result_handler;
+
+    /// Verify every signature.
+    signature_batch();
+
+    /// Skip cached signatures and cache valid ones. The cache must outlive
+    /// the batch and any verification it starts.
+    signature_batch(signature_cache& cache);
+
+    /// This class is not copyable.
+    signature_batch(const signature_batch&) = delete;
+    void operator=(const signature_batch&) = delete;
+
+    /// Queue a triple, returning its index in the results.
+    size_t add(const data_chunk& point, const hash_digest& hash,
+        const endorsement& signature);
+
+    /// The number of queued triples.
+    size_t size() const;
+
+    /// Verify the queued triples on the pool, leaving this batch empty.
+    void verify(threadpool& pool, result_handler handler);
+
+    /// Verify the queued triples on the calling thread, leaving this batch
+    /// empty.
+    std::vector<bool> verify();
+
+private:
+    class job;
+
+    signature_cache* const cache_;
+    std::shared_ptr<job> job_;
+};
+
+} // namespace libbitcoin
+
+#endif
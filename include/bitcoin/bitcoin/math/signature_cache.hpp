@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIGNATURE_CACHE_HPP
+#define LIBBITCOIN_SIGNATURE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <boost/thread/shared_mutex.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A bounded set of successfully verified signatures, so that a signature
+ * verified once (such as in the memory pool) is not verified again (such as
+ * when its transaction arrives in a block). Entries are keyed by the sha256
+ * of a random salt and the signature hash, point and signature, so the key
+ * space cannot be targeted. When full a random entry is evicted.
+ * Instances are safe for concurrent use.
+ */
+class BC_API signature_cache
+{
+public:
+    signature_cache(size_t capacity);
+
+    /// This class is not copyable.
+    signature_cache(const signature_cache&) = delete;
+    void operator=(const signature_cache&) = delete;
+
+    /// True if the triple has been verified and is still cached.
+    bool contains(data_slice point, const hash_digest& hash,
+        const endorsement& signature) const;
+
+    /// Record a triple that has been verified successfully.
+    void insert(data_slice point, const hash_digest& hash,
+        const endorsement& signature);
+
+    /// Verify the signature unless it is cached, caching it if valid.
+    bool verify(const data_chunk& point, const hash_digest& hash,
+        const endorsement& signature);
+
+    /// Remove all entries.
+    void clear();
+
+    size_t capacity() const;
+    size_t size() const;
+
+private:
+    // The key is a salted digest, so any of its words is a uniform hash.
+    struct key_hash
+    {
+        size_t operator()(const hash_digest& key) const;
+    };
+
+    typedef std::unordered_map<hash_digest, size_t, key_hash> map;
+
+    hash_digest key(data_slice point, const hash_digest& hash,
+        const endorsement& signature) const;
+
+    const size_t capacity_;
+    const uint64_t salt_;
+    map positions_;
+    std::vector<hash_digest> keys_;
+    mutable boost::shared_mutex mutex_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -22,7 +22,9 @@
 
 #include <istream>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -40,6 +42,11 @@ public:
     static merkle_block factory_from_data(std::istream& stream);
     static merkle_block factory_from_data(reader& source);
 
+    /// Construct the partial merkle tree of the block proving the matched
+    /// transactions, with a match flag for each transaction of the block.
+    static merkle_block factory_from_block(const chain::block& block,
+        const std::vector<bool>& matches);
+
     bool from_data(const data_chunk& data);
     bool from_data(std::istream& stream);
     bool from_data(reader& source);
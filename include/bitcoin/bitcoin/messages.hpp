@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_MESSAGES_HPP
 #define LIBBITCOIN_MESSAGES_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
@@ -47,7 +48,10 @@
 #include <bitcoin/bitcoin/message/reject.hpp>
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/math/checksum.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 // List of bitcoin messages
 // ------------------------
@@ -85,25 +89,65 @@ typedef bc::chain::block block;
 typedef bc::chain::transaction transaction;
 
 /**
-* Serialize a message object to the Bitcoin wire protocol encoding.
-*/
+ * Serialize a message object to the Bitcoin wire protocol encoding, into
+ * caller provided memory (such as a socket buffer). The payload is written
+ * in place and checksummed there, so nothing is copied. Returns the number
+ * of bytes written, or zero if the message does not fit or its payload is
+ * not of its serialized_size.
+ */
 template <typename Message>
-data_chunk serialize(const Message& packet, uint32_t magic)
+size_t serialize(const Message& packet, uint32_t magic, uint8_t* begin,
+    uint8_t* end)
 {
-    // Serialize the payload (required for header size).
-    auto payload = packet.to_data();
+    const uint64_t head_size = heading::serialized_size();
+    const uint64_t payload_size = packet.serialized_size();
+    const auto size = head_size + payload_size;
+
+    if (size > static_cast<uint64_t>(end - begin))
+        return 0;
+
+    // Serialize the payload after the space reserved for the header.
+    const auto payload = begin + head_size;
+    slice_writer payload_sink(payload, payload + payload_size);
+    packet.to_data(payload_sink);
+    if (!payload_sink.is_exhausted())
+        return 0;
 
     // Construct the payload header.
+    heading head;
+    head.magic = magic;
+    head.command = Message::command;
+    head.payload_size = static_cast<uint32_t>(payload_size);
+    head.checksum = bitcoin_checksum(
+        data_slice(payload, payload + payload_size));
+
+    // Serialize the header in front of the payload.
+    slice_writer head_sink(begin, payload);
+    head.to_data(head_sink);
+    BITCOIN_ASSERT(head_sink.is_exhausted());
+    return static_cast<size_t>(size);
+}
+
+/**
+ * Serialize a message object to the Bitcoin wire protocol encoding.
+ */
+template <typename Message>
+data_chunk serialize(const Message& packet, uint32_t magic)
+{
+    data_chunk message(heading::serialized_size() + packet.serialized_size());
+    const auto end = message.data() + message.size();
+    if (serialize(packet, magic, message.data(), end) != 0)
+        return message;
+
+    // The payload is not of its serialized_size, so frame it as written.
+    const auto payload = to_sized_data(packet);
+
     heading head;
     head.magic = magic;
     head.command = Message::command;
     head.payload_size = static_cast<uint32_t>(payload.size());
     head.checksum = bitcoin_checksum(payload);
-
-    // Serialize header and copy the payload into a single message buffer.
-    auto message = head.to_data();
-    extend_data(message, payload);
-    return message;
+    return build_chunk({ head.to_data(), payload });
 }
 
 } // namespace message
@@ -40,6 +40,7 @@
 #include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/utility/timer_wheel.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -59,7 +60,9 @@ public:
     channel(const channel&) = delete;
     void operator=(const channel&) = delete;
 
-    void talk();
+    /// Start reading, with expiration, inactivity and revival timers
+    /// registered with the timer wheel.
+    void talk(timer_wheel::ptr timers);
     void start();
 
     uint64_t nonce() const;
@@ -94,9 +97,13 @@ private:
     hash_digest located_start_;
     hash_digest located_stop_;
     message::version version_;
-    deadline::ptr expiration_;
-    deadline::ptr inactivity_;
-    deadline::ptr revival_;
+    const asio::duration expiration_period_;
+    const asio::duration inactivity_period_;
+    const asio::duration revival_period_;
+    timer_wheel::ptr timers_;
+    timer_wheel::handle expiration_;
+    timer_wheel::handle inactivity_;
+    timer_wheel::handle revival_;
     result_handler revival_handler_;
 };
 
@@ -26,18 +26,21 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include <boost/thread/shared_mutex.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
-#include <bitcoin/bitcoin/utility/dispatcher.hpp>
-#include <bitcoin/bitcoin/utility/synchronizer.hpp>
-#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
+/**
+ * A registry of connected channels indexed by authority. Lookups take a
+ * shared lock and handlers are invoked on the calling thread.
+ */
 class BC_API connections
 {
 public:
@@ -47,24 +50,27 @@ public:
     typedef std::function<void(const code&)> result_handler;
     typedef std::function<void(const code&, channel::ptr)> channel_handler;
 
-    connections(threadpool& pool);
+    connections();
     ~connections();
 
     /// This class is not copyable.
     connections(const connections&) = delete;
     void operator=(const connections&) = delete;
 
+    /// The message is serialized once and the buffer shared by all channels.
     /// handle_complete returns operation_failed if send to any channel failed.
     template <typename Message>
-    void broadcast(const Message& message, channel_handler handle_channel,
-        result_handler handle_complete) const
+    void broadcast(const Message& message, uint32_t magic,
+        channel_handler handle_channel, result_handler handle_complete) const
     {
-        const auto size = buffer_.size();
+        const auto buffer = proxy::serialize_message(message, magic);
+        const auto channels = snapshot();
+        const auto size = channels.size();
         const auto counter = std::make_shared<std::atomic<size_t>>(size);
         const auto result = std::make_shared<std::atomic<error::error_code_t>>(
             error::success);
 
-        for (const auto channel: buffer_)
+        for (const auto channel: channels)
         {
             const auto handle_send = [=](const code ec)
             {
@@ -77,32 +83,32 @@ public:
                     handle_complete(result->load());
             };
 
-            channel->send(message, handle_send);
+            channel->send(buffer, Message::command, handle_send);
         }
     }
 
+    /// Stop all channels, which remain registered until removed.
     void stop(const code& ec);
-    void count(count_handler handler);
+
+    /// The number of channels.
+    size_t count() const;
+
+    /// Determine if a channel to the authority is registered.
+    bool exists(const authority& authority) const;
+
+    void count(count_handler handler) const;
     void store(const channel::ptr& channel, result_handler handler);
     void remove(const channel::ptr& channel, result_handler handler);
-    void exists(const authority& authority, truth_handler handler);
+    void exists(const authority& authority, truth_handler handler) const;
 
 private:
     typedef std::vector<channel::ptr> list;
-    typedef list::const_iterator iterator;
-
-    iterator find(const uint64_t nonce) const;
-    iterator find(const channel::ptr& channel) const;
-    iterator find(const authority& authority) const;
+    typedef std::unordered_map<authority, channel::ptr> map;
 
-    void do_stop(const code& ec);
-    void do_count(count_handler handler) const;
-    void do_store(const channel::ptr& channel, result_handler handler);
-    void do_remove(const channel::ptr& channel, result_handler handler);
-    void do_exists(const authority& authority, truth_handler handler) const;
+    list snapshot() const;
 
-    list buffer_;
-    dispatcher dispatch_;
+    map channels_;
+    mutable boost::shared_mutex mutex_;
 };
 
 } // namespace network
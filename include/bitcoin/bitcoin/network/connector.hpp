@@ -20,8 +20,11 @@
 #ifndef LIBBITCOIN_NETWORK_CONNECTOR_HPP
 #define LIBBITCOIN_NETWORK_CONNECTOR_HPP
 
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/config/endpoint.hpp>
@@ -30,6 +33,8 @@
 #include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/network/network_settings.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
@@ -42,14 +47,26 @@ public:
     typedef std::shared_ptr<connector> ptr;
     typedef std::function<void(const code&, channel::ptr)> connect_handler;
 
-    /// Construct the connector.
-    connector(threadpool& pool, const settings& settings);
+    /// Latency of the stages of establishing an outbound channel.
+    struct statistics
+    {
+        histogram resolve;
+        histogram connect;
+        histogram handshake;
+    };
+
+    /// Construct the connector, recording resolve and connect latency.
+    /// At most settings.connect_limit attempts are in flight at once (zero
+    /// is unlimited), others are queued in order of request.
+    connector(threadpool& pool, const settings& settings,
+        statistics& statistics);
 
     /// This class is not copyable.
     connector(const connector&) = delete;
     void operator=(const connector&) = delete;
 
-    /// Cancel all outstanding connection attempt.
+    /// Cancel all outstanding connection attempts.
+    /// Queued attempts are invoked with error::service_stopped.
     void cancel();
 
     /// Try to connect to the endpoint.
@@ -60,21 +77,46 @@ public:
     void connect(const config::authority& authority,
         connect_handler handler);
 
-    /// Try to connect to host:port.
+    /// Try to connect to host:port, a numeric host is not resolved.
     void connect(const std::string& hostname, uint16_t port,
         connect_handler handler);
 
+    /// The number of attempts started and not yet complete.
+    size_t in_flight() const;
+
 private:
-    void handle_resolve(const boost_code& ec, asio::iterator iterator,
+    typedef histogram::clock clock;
+
+    struct dial
+    {
+        std::function<void()> start;
+        connect_handler handler;
+    };
+
+    void acquire(const dial& attempt);
+    void release();
+
+    void start(const std::string& hostname, uint16_t port,
         connect_handler handler);
+    void handle_resolve(const boost_code& ec, asio::iterator iterator,
+        clock::time_point started, connect_handler handler);
     void handle_timer(const code& ec, asio::socket_ptr socket,
         connect_handler handler);
-    void handle_connect(const boost_code& ec, asio::iterator iterator,
-        asio::socket_ptr socket, deadline::ptr timer, connect_handler handler);
+    void handle_connect(const boost_code& ec, asio::socket_ptr socket,
+        deadline::ptr timer, clock::time_point started,
+        connect_handler handler);
+
+    deadline::ptr start_timer(asio::socket_ptr socket,
+        connect_handler handler);
 
     threadpool& pool_;
     const settings& settings_;
+    statistics& statistics_;
     std::shared_ptr<asio::resolver> resolver_;
+
+    mutable std::mutex mutex_;
+    size_t in_flight_;
+    std::deque<dial> queue_;
 };
 
 } // namespace network
@@ -24,22 +24,31 @@
 #include <cstdint>
 #include <string>
 #include <functional>
+#include <unordered_map>
 #include <vector>
-#include <boost/circular_buffer.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
 /// The hosts class manages a thread-safe dynamic store of network addresses.
+/// Addresses are held in a new table until a connection to them succeeds,
+/// and are then moved to a tried table. Each table is divided into buckets
+/// by address group (/16 for IPv4, /32 for IPv6), which limits the share of
+/// a table that any one network range can occupy. Fetch prefers tried hosts
+/// and, within a table, hosts with fewer failed connection attempts.
 /// The store can be loaded and saved from/to the specified file path.
-/// The file is a line-oriented set of config::authority serializations.
+/// The file is binary, though a line-oriented set of config::authority
+/// serializations (the former format) is also accepted on load.
 /// Duplicate addresses and those with zero-valued ports are disacarded.
 class BC_API hosts
 {
@@ -51,40 +60,86 @@ public:
     typedef std::function<void(const code&)> result_handler;
     typedef std::function<void(const code&, const address&)> fetch_handler;
 
+    /// The disposition of the addresses of a store call.
+    struct store_counts
+    {
+        size_t accepted;
+        size_t duplicate;
+        size_t invalid;
+        size_t evicted;
+    };
+
+    typedef std::function<void(const code&, const store_counts&)>
+        store_handler;
+
     hosts(threadpool& pool, const settings& settings);
 
     /// This class is not copyable.
     hosts(const hosts&) = delete;
     void operator=(const hosts&) = delete;
 
-    void count(count_handler handler);
+    void count(count_handler handler) const;
     void store(const address& host, result_handler handler);
-    void store(const address::list& hosts, result_handler handler);
+    void store(const address::list& hosts, store_handler handler);
     void remove(const address& host, result_handler handler);
     void load(result_handler handler);
     void save(result_handler handler);
-    void fetch(fetch_handler handler);
+    void fetch(fetch_handler handler) const;
+
+    /// Record a connection attempt to the host, which is dropped from the
+    /// new table after repeated attempts without success.
+    void attempt(const address& host, result_handler handler);
+
+    /// Record a successful connection to the host, moving it to tried.
+    void confirm(const address& host, result_handler handler);
 
 private:
-    typedef boost::circular_buffer<address> list;
-    typedef list::iterator iterator;
+    typedef config::authority key;
+
+    struct record
+    {
+        address host;
+        uint32_t attempts;
+        bool tried;
+        size_t bucket;
+        size_t position;
+    };
+
+    typedef std::unordered_map<key, record> map;
 
-    iterator find(const address& host);
+    // Map elements are not moved by rehashing, so tables refer to them.
+    typedef map::value_type* entry;
+
+    struct table
+    {
+        size_t capacity;
+        std::vector<entry> entries;
+        std::vector<std::vector<entry>> buckets;
+    };
+
+    static table create_table(size_t capacity);
+    static bool better(const record& left, const record& right);
+
+    size_t bucket(const address& host, const table& table) const;
+    entry select(const table& table) const;
+    size_t insert(const address& host, uint32_t attempts, bool tried);
+    size_t evict(table& table, size_t bucket);
+    void erase(entry host);
+    void ingest(const address& host, store_counts& counts);
 
-    void do_count(count_handler handler);
-    void do_store(const address& host, result_handler handler);
-    void do_remove(const address& host, result_handler handler);
     void do_load(const path& file_path, result_handler handler);
     void do_save(const path& file_path, result_handler handler);
-    void do_fetch(fetch_handler handler);
-    size_t select_random_host();
+    void load_text(const std::string& text);
+    bool load_binary(reader& source);
+
+    map records_;
+    table new_;
+    table tried_;
+    const uint64_t salt_;
+    mutable boost::shared_mutex mutex_;
 
-    list buffer_;
     dispatcher dispatch_;
     boost::filesystem::path file_path_;
-
-    // HACK: we use this because the buffer capacity cannot be set to zero.
-    const bool disabled_;
 };
 
 } // namespace network
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/log.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -32,9 +33,12 @@ namespace network {
 BC_CONSTEXPR std::ofstream::openmode log_open_mode =
     std::ofstream::out | std::ofstream::app;
 
-/// Set up global logging.
+/// Set up global logging, for levels at or above the minimum.
+/// Lines are written asynchronously by a log_writer, which is flushed and
+/// stopped by log::clear(). This must be called before the streams close.
 BC_API void initialize_logging(std::ofstream& debug, std::ofstream& error,
-    std::ostream& output_stream, std::ostream& error_stream);
+    std::ostream& output_stream, std::ostream& error_stream,
+    log::level minimum=log::level::debug);
 
 } // namespace network
 } // namespace libbitcoin
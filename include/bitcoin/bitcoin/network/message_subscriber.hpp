@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/messages.hpp>
+#include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
@@ -35,8 +36,8 @@ namespace libbitcoin {
 namespace network {
 
 #define DEFINE_SUBSCRIBER_TYPE(value) \
-    typedef subscriber<const bc::code&, const message::value&> \
-        value##_subscriber_type
+    typedef subscriber<const bc::code&, \
+        std::shared_ptr<const message::value>> value##_subscriber_type
 
 #define DEFINE_SUBSCRIBER_OVERLOAD(value) \
     template <typename Handler> \
@@ -96,16 +97,17 @@ public:
     }
         
     /**
-     * Load a stream into a message instance and notify subscribers.
-     * @param[in]  stream      The stream from which to load the message.
+     * Load a reader into a message instance and notify subscribers.
+     * The message is allocated once and shared by all subscribers.
+     * @param[in]  source      The reader from which to load the message.
      * @param[in]  subscriber  The subscriber for the message type.
      * @return                 Returns error::bad_stream if failed.
      */
     template <class Message, class Subscriber>
-    code load(std::istream& stream, Subscriber subscriber) const
+    code load(reader& source, Subscriber subscriber) const
     {
-        Message message;
-        const bool parsed = message.from_data(stream);
+        const auto message = std::make_shared<Message>();
+        const bool parsed = message->from_data(source);
         const code ec(parsed ? error::success : error::bad_stream);
         subscriber->relay(ec, message);
         return ec;
@@ -127,6 +129,17 @@ public:
      */
     code load(message::message_type type, std::istream& stream) const;
 
+    /*
+     * Load a reader of the specified command type, such as a slice_reader
+     * over a received payload, without copying the payload.
+     * Creates an instance of the indicated message type.
+     * Sends the message instance to each subscriber of the type.
+     * @param[in]  type    The message type identifier.
+     * @param[in]  source  The reader from which to load the message.
+     * @return             Returns error::bad_stream if failed.
+     */
+    code load(message::message_type type, reader& source) const;
+
 private:
     DEFINE_SUBSCRIBER_OVERLOAD(address);
     DEFINE_SUBSCRIBER_OVERLOAD(alert);
@@ -36,6 +36,8 @@ namespace network {
 #define NETWORK_OUTBOUND_CONNECTIONS        8
 #define NETWORK_CONNECT_ATTEMPTS            0
 #define NETWORK_CONNECT_TIMEOUT_SECONDS     5
+#define NETWORK_CONNECT_BATCH_SIZE          3
+#define NETWORK_CONNECT_LIMIT               32
 #define NETWORK_CHANNEL_HANDSHAKE_SECONDS   30
 #define NETWORK_CHANNEL_REVIVAL_MINUTES     5
 #define NETWORK_CHANNEL_HEARTBEAT_MINUTES   5
@@ -86,6 +88,8 @@ struct BC_API settings
     uint32_t outbound_connections;
     uint16_t connect_attempts;
     uint32_t connect_timeout_seconds;
+    uint32_t connect_batch_size;
+    uint32_t connect_limit;
     uint32_t channel_handshake_seconds;
     uint32_t channel_revival_minutes;
     uint32_t channel_heartbeat_minutes;
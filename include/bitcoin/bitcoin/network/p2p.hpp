@@ -31,11 +31,13 @@
 #include <bitcoin/bitcoin/message/network_address.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/network/connections.hpp>
+#include <bitcoin/bitcoin/network/connector.hpp>
 #include <bitcoin/bitcoin/network/hosts.hpp>
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/network/pending.hpp>
 #include <bitcoin/bitcoin/network/session_manual.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/utility/timer_wheel.hpp>
 
 namespace libbitcoin {
 namespace network {
@@ -54,6 +56,8 @@ public:
     typedef std::function<void(const code&)> result_handler;
     typedef std::function<void(const code&, channel::ptr)> channel_handler;
     typedef std::function<void(const code&, const address&)> address_handler;
+    typedef hosts::store_counts store_counts;
+    typedef hosts::store_handler store_handler;
 
     /// Construct the p2p networking instance.
     p2p(const settings& settings=mainnet);
@@ -71,6 +75,13 @@ public:
     /// Set the current block height, for use in version messages.
     virtual void set_height(size_t value);
 
+    /// Latency of the resolve, connect and handshake stages of all outbound
+    /// connection attempts, safe to read at any time.
+    connector::statistics& connect_statistics();
+
+    /// The timer wheel shared by channels for their timeouts.
+    timer_wheel::ptr timers();
+
     /// Start connecting.
     /// Handler returns the result of host file load and seeding operations.
     // This must be called from the thread that constructed this class.
@@ -124,7 +135,9 @@ public:
     virtual void store(const address& address, result_handler handler);
 
     /// Store a collection of addresses.
-    virtual void store(const address::list& addresses, result_handler handler);
+    /// The handler is given counts of accepted, duplicate, invalid and
+    /// evicted addresses.
+    virtual void store(const address::list& addresses, store_handler handler);
 
     /// Remove an address.
     virtual void remove(const address& address, result_handler handler);
@@ -132,6 +145,14 @@ public:
     /// Get the number of addresses.
     virtual void address_count(count_handler handler);
 
+    /// Record a connection attempt to an address.
+    virtual void attempt_address(const address& address,
+        result_handler handler);
+
+    /// Record a successful connection to an address.
+    virtual void confirm_address(const address& address,
+        result_handler handler);
+
     // ------------------------------------------------------------------------
 
     /// Maintain a connection to hostname:port.
@@ -172,7 +193,8 @@ private:
     void do_broadcast(const Message& message, channel_handler handle_channel,
         result_handler handle_complete) const
     {
-        connections_.broadcast(message, handle_channel, handle_complete);
+        connections_.broadcast(message, settings_.identifier, handle_channel,
+            handle_complete);
     }
 
     bool stopped() const;
@@ -188,6 +210,8 @@ private:
     pending pending_;
     connections connections_;
     hosts hosts_;
+    connector::statistics statistics_;
+    timer_wheel::ptr timers_;
     channel::channel_subscriber::ptr subscriber_;
     session_manual::ptr manual_;
 };
@@ -20,18 +20,23 @@
 #ifndef LIBBITCOIN_NETWORK_PENDING_HPP
 #define LIBBITCOIN_NETWORK_PENDING_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <vector>
+#include <unordered_map>
+#include <boost/thread/shared_mutex.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
-#include <bitcoin/bitcoin/utility/dispatcher.hpp>
-#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
+/**
+ * A registry of pending channels indexed by version nonce. The nonce of a
+ * channel may be reset before it is removed, so channels are also indexed.
+ * Lookups take a shared lock and handlers are invoked on the calling thread.
+ */
 class BC_API pending
 {
 public:
@@ -39,34 +44,34 @@ public:
     typedef std::function<void(size_t)> count_handler;
     typedef std::function<void(const code&)> result_handler;
 
-    pending(threadpool& pool);
+    pending();
     ~pending();
 
     /// This class is not copyable.
     pending(const pending&) = delete;
     void operator=(const pending&) = delete;
 
+    /// Stop and remove all channels.
     void clear(const code& ec);
-    void count(count_handler handler);
+
+    /// The number of channels.
+    size_t count() const;
+
+    /// Determine if a channel with the (non-zero) nonce is registered.
+    bool exists(uint64_t version_nonce) const;
+
+    void count(count_handler handler) const;
     void store(const channel::ptr& channel, result_handler handler);
     void remove(const channel::ptr& channel, result_handler handler);
-    void exists(uint64_t version_nonce, truth_handler handler);
+    void exists(uint64_t version_nonce, truth_handler handler) const;
 
 private:
-    typedef std::vector<channel::ptr> list;
-    typedef list::const_iterator iterator;
-
-    iterator find(const uint64_t nonce) const;
-    iterator find(const channel::ptr& channel) const;
-
-    void do_clear(const code& ec);
-    void do_count(count_handler handler) const;
-    void do_store(const channel::ptr& channel, result_handler handler);
-    void do_remove(const channel::ptr& channel, result_handler handler);
-    void do_exists(uint64_t version_nonce, truth_handler handler) const;
+    typedef std::unordered_map<uint64_t, channel::ptr> nonce_map;
+    typedef std::unordered_map<channel::ptr, uint64_t> channel_map;
 
-    list buffer_;
-    dispatcher dispatch_;
+    nonce_map nonces_;
+    channel_map channels_;
+    mutable boost::shared_mutex mutex_;
 };
 
 } // namespace network
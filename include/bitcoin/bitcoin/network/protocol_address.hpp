@@ -61,12 +61,13 @@ public:
 
 private:
     void handle_receive_address(const code& ec,
-        const message::address& address);
+        std::shared_ptr<const message::address> message);
     void handle_receive_get_address(const code& ec,
-        const message::get_address& message);
+        std::shared_ptr<const message::get_address> message);
     void handle_send_address(const code& ec);
     void handle_send_get_address(const code& ec);
-    void handle_store_addresses(const code& ec);
+    void handle_store_addresses(const code& ec,
+        const p2p::store_counts& counts);
 
     p2p& network_;
     message::address self_;
@@ -59,8 +59,10 @@ public:
 
 private:
     void send_ping(const code& ec);
-    void handle_receive_ping(const code& ec, const message::ping& message);
-    void handle_receive_pong(const code& ec, const message::pong& message,
+    void handle_receive_ping(const code& ec,
+        std::shared_ptr<const message::ping> message);
+    void handle_receive_pong(const code& ec,
+        std::shared_ptr<const message::pong> message,
         uint64_t nonce);
     void handle_send_ping(const code& ec);
     void handle_send_pong(const code& ec);
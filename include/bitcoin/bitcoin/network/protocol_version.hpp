@@ -65,8 +65,9 @@ private:
         uint64_t nonce, size_t height);
 
     void handle_receive_version(const code& ec,
-        const message::version& version);
-    void handle_receive_verack(const code& ec, const message::verack&);
+        std::shared_ptr<const message::version> message);
+    void handle_receive_verack(const code& ec,
+        std::shared_ptr<const message::verack>);
     void handle_version_sent(const code& ec);
     void handle_verack_sent(const code& ec);
     void handle_handshake_complete(const code& ec, event_handler handler);
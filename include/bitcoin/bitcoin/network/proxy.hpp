@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_NETWORK_PROXY_HPP
 #define LIBBITCOIN_NETWORK_PROXY_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -27,7 +28,6 @@
 #include <string>
 #include <boost/array.hpp>
 #include <boost/date_time.hpp>
-#include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -35,7 +35,9 @@
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/messages.hpp>
 #include <bitcoin/bitcoin/network/message_subscriber.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/network/shared_const_buffer.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/deadline.hpp>
@@ -66,6 +68,28 @@ public:
     proxy(const proxy&) = delete;
     void operator=(const proxy&) = delete;
 
+    /// Serialize a message once, into a pooled buffer, so that it may be sent
+    /// to any number of channels without further copying.
+    template <class Message>
+    static shared_const_buffer serialize_message(const Message& packet,
+        uint32_t magic)
+    {
+        const auto size = message::heading::serialized_size() +
+            packet.serialized_size();
+        const std::shared_ptr<data_chunk> buffer =
+            send_buffer(static_cast<size_t>(size));
+        const auto begin = buffer->data();
+        const auto end = begin + buffer->size();
+        if (message::serialize(packet, magic, begin, end) != 0)
+            return shared_const_buffer(buffer);
+
+        // The payload is not of its serialized_size, so frame it as written.
+        const auto framed = message::serialize(packet, magic);
+        const std::shared_ptr<data_chunk> copy = send_buffer(framed.size());
+        std::copy(framed.begin(), framed.end(), copy->begin());
+        return shared_const_buffer(copy);
+    }
+
     template <class Message, typename Handler>
     void send(Message&& packet, Handler&& handler)
     {
@@ -75,19 +99,20 @@ public:
             return;
         }
 
-        using namespace message;
-        const auto bytes = serialize(std::forward<Message>(packet), magic_);
-        const auto handle_send = std::forward<Handler>(handler);
-        dispatch_.ordered(&proxy::do_send,
-            shared_from_this(), bytes, handle_send, packet.command);
+        const auto message = serialize_message(packet, magic_);
+        send(message, packet.command, std::forward<Handler>(handler));
     }
 
+    /// Send a message obtained from serialize_message.
+    void send(const shared_const_buffer& message, const std::string& command,
+        result_handler handler);
+
     template <class Message, typename Handler>
     void subscribe(Handler&& handler)
     {
         if (stopped())
         {
-            handler(error::channel_stopped, Message());
+            handler(error::channel_stopped, std::make_shared<Message>());
             return;
         }
 
@@ -107,13 +132,8 @@ protected:
     virtual void handle_stopping() = 0;
 
 private:
-    typedef byte_source<message::heading::buffer> heading_source;
-    typedef boost::iostreams::stream<heading_source> heading_stream;
-
-    typedef byte_source<data_chunk> payload_source;
-    typedef boost::iostreams::stream<payload_source> payload_stream;
-
     static config::authority authority_factory(asio::socket_ptr socket);
+    static buffer_pool::ptr send_buffer(size_t size);
 
     void stop(const boost_code& ec);
     void do_stop(const code& ec);
@@ -123,10 +143,11 @@ private:
 
     void read_payload(const message::heading& head);
     void handle_read_payload(const boost_code& ec, size_t,
-        const message::heading& heading);
+        const message::heading& heading,
+        std::shared_ptr<data_chunk> payload);
 
     void call_handle_send(const boost_code& ec, result_handler handler);
-    void do_send(const data_chunk& message, result_handler handler,
+    void do_send(const shared_const_buffer& message, result_handler handler,
         const std::string& command);
 
     bool stopped_;
@@ -137,7 +158,7 @@ private:
     message_subscriber message_subscriber_;
     stop_subscriber::ptr stop_subscriber_;
     message::heading::buffer heading_buffer_;
-    data_chunk payload_buffer_;
+    buffer_pool payload_buffers_;
 };
 
 } // namespace network
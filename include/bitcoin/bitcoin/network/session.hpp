@@ -33,6 +33,7 @@
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/network/proxy.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
@@ -93,8 +94,11 @@ protected:
 
     void address_count(count_handler handler);
     void fetch_address(host_handler handler);
+    void attempt_address(const authority& host, result_handler handler);
+    void confirm_address(const authority& host, result_handler handler);
     
     bool blacklisted(const authority& authority) const;
+    const connector::statistics& connect_statistics() const;
     void connection_count(count_handler handler);
     void register_channel(channel::ptr channel, result_handler handle_started,
         result_handler handle_stopped);
@@ -110,7 +114,7 @@ private:
     void handle_pend(const code& ec, channel::ptr channel,
         result_handler handle_started);
     void handle_handshake(const code& ec, channel::ptr channel,
-        result_handler handle_started);
+        histogram::clock::time_point started, result_handler handle_started);
     void handle_is_pending(bool pending, channel::ptr channel,
         result_handler handle_started);
     void handle_stored(const code& ec, channel::ptr channel,
@@ -26,8 +26,10 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/message/network_address.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
+#include <bitcoin/bitcoin/network/connector.hpp>
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/network/session.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
@@ -35,6 +37,9 @@ namespace network {
 
 class p2p;
 
+/// Maintains settings.outbound_connections channels to pooled addresses.
+/// Each open slot races connections to settings.connect_batch_size candidate
+/// addresses, the first to connect fills the slot and the others are closed.
 class BC_API session_outbound
   : public session, track<session_outbound>
 {
@@ -46,15 +51,34 @@ public:
     void start() override;
 
 private:
+    // The candidates raced to fill one slot, accessed only on the strand.
+    struct batch
+    {
+        size_t remaining;
+        bool connected;
+        bool exhausted;
+        authority::list hosts;
+    };
+
+    typedef std::shared_ptr<batch> batch_ptr;
+
     void new_connection(connector::ptr connect);
     void start_connect(const code& ec, const authority& host,
-        connector::ptr connect);
+        connector::ptr connect, batch_ptr race);
     void handle_connect(const code& ec, channel::ptr channel,
-        const authority& host, connector::ptr connect);
-    
+        const authority& host, connector::ptr connect, batch_ptr race);
+    void handle_failure(connector::ptr connect, batch_ptr race);
+    void record_attempt(const authority& host);
+    void handle_address(const code& ec, const authority& host);
+
     void handle_channel_stop(const code& ec, connector::ptr connect);
     void handle_channel_start(const code& ec, connector::ptr connect,
         channel::ptr channel);
+    void report_established();
+
+    size_t connected_;
+    bool established_;
+    histogram::clock::time_point started_;
 };
 
 } // namespace network
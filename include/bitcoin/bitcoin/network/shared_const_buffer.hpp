@@ -20,6 +20,7 @@
 #ifndef LIBBITCOIN_NETWORK_SHARED_CONST_BUFFER_HPP
 #define LIBBITCOIN_NETWORK_SHARED_CONST_BUFFER_HPP
 
+#include <cstddef>
 #include <memory>
 #include <boost/asio.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
@@ -42,6 +43,17 @@ public:
     {
     }
 
+    // Share an existing buffer, without copying.
+    explicit shared_const_buffer(std::shared_ptr<const data_chunk> data)
+      : data_(data), buffer_(boost::asio::buffer(*data_))
+    {
+    }
+
+    size_t size() const
+    {
+        return boost::asio::buffer_size(buffer_);
+    }
+
     const_iterator begin() const
     {
         return &buffer_;
@@ -53,7 +65,7 @@ public:
     }
 
 private:
-    std::shared_ptr<data_chunk> data_;
+    std::shared_ptr<const data_chunk> data_;
     value_type buffer_;
 };
 
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BUFFER_POOL_HPP
+#define LIBBITCOIN_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A thread safe pool of reusable data chunks. A chunk obtained from the pool
+ * returns to the pool (retaining its capacity) when it is released, so that
+ * repeated serialization of similar sized messages does not reallocate. A
+ * chunk may be moved into a shared pointer, in which case it returns when
+ * the last reference is released. Chunks may outlive the pool.
+ */
+class BC_API buffer_pool
+{
+private:
+    class store;
+
+public:
+    /// The deleter of a chunk, which returns it to the pool, or frees it if
+    /// the pool no longer exists.
+    class BC_API recycle
+    {
+    public:
+        recycle();
+        recycle(std::weak_ptr<store> store);
+
+        void operator()(data_chunk* chunk) const;
+
+    private:
+        std::weak_ptr<store> store_;
+    };
+
+    typedef std::unique_ptr<data_chunk, recycle> ptr;
+
+    /**
+     * Construct a pool.
+     * @param[in]   limit     The number of idle chunks retained.
+     * @param[in]   max_size  The largest capacity retained, larger chunks
+     *                        are freed on release.
+     */
+    buffer_pool(size_t limit, size_t max_size);
+
+    /// This class is not copyable.
+    buffer_pool(const buffer_pool&) = delete;
+    void operator=(const buffer_pool&) = delete;
+
+    /// Obtain a chunk of the given size, with unspecified contents.
+    ptr get(size_t size);
+
+    /// The number of idle chunks currently retained.
+    size_t size() const;
+
+private:
+    std::shared_ptr<store> store_;
+};
+
+} // namespace libbitcoin
+
+#endif
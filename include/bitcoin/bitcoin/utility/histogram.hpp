@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_HISTOGRAM_HPP
+#define LIBBITCOIN_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A thread safe histogram of elapsed times. Samples are counted in buckets
+ * of power of two microseconds, so recording is a few atomic increments and
+ * may be used on any thread without a lock. Percentiles are reported as the
+ * upper bound of the bucket in which they fall.
+ */
+class BC_API histogram
+{
+public:
+    typedef std::chrono::microseconds duration;
+    typedef std::chrono::steady_clock clock;
+
+    /// Bucket n counts samples below 2^n microseconds (the last is unbounded).
+    static BC_CONSTEXPR size_t buckets = 32;
+
+    histogram();
+
+    /// This class is not copyable.
+    histogram(const histogram&) = delete;
+    void operator=(const histogram&) = delete;
+
+    /// Record a sample.
+    void record(const duration& elapsed);
+
+    /// Record the time elapsed since start.
+    void record(const clock::time_point& start);
+
+    /// The number of samples recorded.
+    size_t count() const;
+
+    /// The number of samples recorded in the bucket.
+    size_t count(size_t bucket) const;
+
+    /// The mean of the samples recorded, zero if none.
+    duration mean() const;
+
+    /// The upper bound of the bucket containing the fraction of samples.
+    duration percentile(double fraction) const;
+
+    /// Clear all samples.
+    void reset();
+
+private:
+    static size_t bucket(uint64_t microseconds);
+
+    std::atomic<uint64_t> total_;
+    std::array<std::atomic<size_t>, buckets> counts_;
+};
+
+/// Write the sample count, mean and 50/90/99 percentiles.
+BC_API std::ostream& operator<<(std::ostream& output,
+    const histogram& histogram);
+
+} // namespace libbitcoin
+
+#endif
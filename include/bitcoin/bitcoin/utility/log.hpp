@@ -61,21 +61,26 @@ public:
     static log error(const std::string& domain);
     static log fatal(const std::string& domain);
 
+    /// True if the level has an output function.
+    static bool enabled(level value);
+
+    /// Values are not formatted unless the level has an output function.
     template <typename Type>
     log& operator<<(Type const& value)
     {
-        stream_ << value;
+        if (enabled_)
+            stream_ << value;
+
         return *this;
     }
 
-    /// Set the output functor for this log instance.
+    /// Set the output functor for this log instance's level.
+    /// An empty functor disables the level.
     void set_output_function(functor value);
 
 private:
     typedef std::map<level, functor> destinations;
 
-    static void output_ignore(level value, const std::string& domain,
-        const std::string& body);
     static void output_cout(level value, const std::string& domain,
         const std::string& body);
     static void output_cerr(level value, const std::string& domain,
@@ -87,6 +92,7 @@ private:
     static destinations destinations_;
 
     level level_;
+    bool enabled_;
     std::string domain_;
     std::ostringstream stream_;
 };
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_LOG_WRITER_HPP
+#define LIBBITCOIN_LOG_WRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/log.hpp>
+
+namespace libbitcoin {
+
+/**
+ * An asynchronous log writer. Each logging thread copies its records into
+ * fixed size slots of a ring of its own, without locking or allocating, and
+ * a writer thread drains the rings, formats the records and passes them to
+ * the sink in batches. A record is dropped (and counted) if the ring of its
+ * thread is full, so logging never blocks on the sink.
+ */
+class BC_API log_writer
+{
+public:
+    typedef std::shared_ptr<log_writer> ptr;
+
+    /// The queue of one logging thread, defined privately.
+    class ring;
+    typedef std::shared_ptr<ring> ring_ptr;
+
+    /// Receives the formatted lines of one level from one batch, each line
+    /// terminated by a newline, and should flush its devices.
+    typedef std::function<void(log::level, const std::string&)> sink;
+
+    /// Records longer than this are truncated.
+    static BC_CONSTEXPR size_t record_text = 480;
+
+    /**
+     * Construct the writer and start its thread.
+     * @param[in]  output    The sink of formatted lines.
+     * @param[in]  capacity  The number of records in each thread's ring,
+     *                       rounded up to a power of two.
+     * @param[in]  interval  The period at which idle rings are polled.
+     */
+    log_writer(sink output, size_t capacity=4096,
+        std::chrono::milliseconds interval=std::chrono::milliseconds(10));
+
+    /// Write all records logged so far and stop the thread.
+    ~log_writer();
+
+    /// This class is not copyable.
+    log_writer(const log_writer&) = delete;
+    void operator=(const log_writer&) = delete;
+
+    /// Queue a record on the calling thread's ring, a log::functor target.
+    /// A record with an empty body is ignored.
+    void write(log::level level, const std::string& domain,
+        const std::string& body);
+
+    /// The number of records dropped because a ring was full.
+    size_t dropped() const;
+
+private:
+    ring_ptr local_ring();
+    size_t drain();
+    void run();
+
+    const uint64_t identity_;
+    const size_t capacity_;
+    const std::chrono::milliseconds interval_;
+    sink sink_;
+    std::atomic<size_t> dropped_;
+    size_t reported_;
+
+    std::mutex mutex_;
+    std::condition_variable stopping_;
+    bool stopped_;
+    std::vector<ring_ptr> rings_;
+    std::thread thread_;
+};
+
+} // namespace libbitcoin
+
+#endif
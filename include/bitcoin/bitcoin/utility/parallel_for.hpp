@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_FOR_HPP
+#define LIBBITCOIN_PARALLEL_FOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * Process the indexes [0, count) on the threads of the pool. Ranges of up to
+ * grain indexes are claimed in order from a shared cursor by at most one task
+ * for each pool thread. Each task default constructs its own State, reused
+ * across its ranges, and calls body(state, first, last) for each range it
+ * claims. Once every range has been processed complete is invoked once, from
+ * the thread of the last task to finish. If the pool has no threads all of
+ * the ranges are processed, and complete invoked, on the calling thread.
+ */
+template <typename State, typename Body>
+void parallel_for(threadpool& pool, size_t count, size_t grain, Body body,
+    std::function<void()> complete);
+
+/**
+ * As above, for a body(first, last) that needs no state of its own.
+ */
+template <typename Body>
+void parallel_for(threadpool& pool, size_t count, size_t grain, Body body,
+    std::function<void()> complete);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/parallel_for.ipp>
+
+#endif
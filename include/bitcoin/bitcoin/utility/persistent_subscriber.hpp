@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PERSISTENT_SUBSCRIBER_HPP
+#define LIBBITCOIN_PERSISTENT_SUBSCRIBER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A subscriber whose handlers remain subscribed until unsubscribed by the
+ * token returned from subscribe. Unlike subscriber, neither subscription nor
+ * notification is serialized through a strand. The handler list is copied
+ * on write and published atomically, so a relay reads a consistent snapshot
+ * without waiting on subscription changes.
+ *
+ * Handlers may be invoked concurrently (by concurrent relays) and so must be
+ * thread safe. A handler may subscribe or unsubscribe during notification,
+ * which affects subsequent notifications only.
+ */
+template <typename... Args>
+class persistent_subscriber
+  : public std::enable_shared_from_this<persistent_subscriber<Args...>>
+{
+public:
+    typedef std::function<void (Args...)> handler;
+    typedef std::shared_ptr<persistent_subscriber<Args...>> ptr;
+    typedef uint64_t token;
+
+    persistent_subscriber(threadpool& pool);
+
+    /// This class is not copyable.
+    persistent_subscriber(const persistent_subscriber&) = delete;
+    void operator=(const persistent_subscriber&) = delete;
+
+    /// Add a handler, returning the token with which to unsubscribe it.
+    token subscribe(handler notifier);
+
+    /// Remove a handler, returns false if the token is not subscribed.
+    bool unsubscribe(token subscription);
+
+    /// Notify each handler on the threadpool, not ordered with other relays.
+    void relay(Args... args);
+
+    /// Notify each handler on the calling thread.
+    void invoke(Args... args) const;
+
+    /// The number of subscribed handlers.
+    size_t size() const;
+
+private:
+    typedef std::pair<token, handler> subscription;
+    typedef std::vector<subscription> list;
+    typedef std::shared_ptr<const list> list_ptr;
+
+    dispatcher dispatch_;
+    std::atomic<token> next_token_;
+    list_ptr subscriptions_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/persistent_subscriber.ipp>
+
+#endif
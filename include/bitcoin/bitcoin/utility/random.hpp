@@ -20,15 +20,62 @@
 #ifndef LIBBITCOIN_RANDOM_HPP
 #define LIBBITCOIN_RANDOM_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <boost/date_time.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
+/**
+ * A source of uniformly distributed 64 bit values.
+ */
+class BC_API random_engine
+{
+public:
+    virtual ~random_engine();
+    virtual uint64_t next() = 0;
+};
+
+/**
+ * An engine that produces the ChaCha20 keystream (zero nonce). An engine
+ * constructed without a key is keyed from the operating system and rekeyed
+ * periodically. An engine constructed with a key is deterministic.
+ */
+class BC_API chacha20_engine
+  : public random_engine
+{
+public:
+    chacha20_engine();
+    chacha20_engine(const hash_digest& key);
+
+    uint64_t next() override;
+
+private:
+    void rekey(const hash_digest& key);
+    void generate();
+
+    const bool reseed_;
+    uint64_t counter_;
+    size_t index_;
+    std::array<uint32_t, 8> key_;
+    std::array<uint32_t, 16> block_;
+};
+
+/**
+ * Replace the engine used by the pseudo_random functions on the calling
+ * thread, or restore the default (OS keyed chacha20) engine with nullptr.
+ * The engine is not owned and must remain valid until it is replaced.
+ * @param[in]  engine  The engine to use on this thread, or nullptr.
+ */
+BC_API void set_pseudo_random_engine(random_engine* engine);
+
 /**
  * Generate a pseudo random number within the domain.
+ * Values are drawn from the engine of the calling thread.
  * @return  The 64 bit number (use % to subset domain).
  */
 BC_API uint64_t pseudo_random();
@@ -40,7 +87,7 @@ BC_API uint64_t pseudo_random();
 BC_API uint64_t nonzero_pseudo_random();
 
 /**
- * Fill a buffer with randomness using the default random engine.
+ * Fill a buffer with randomness using the engine of the calling thread.
  * @param[in]  chunk  The buffer to fill with randomness.
  */
 BC_API void pseudo_random_fill(data_chunk& chunk);
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SLICE_READER_HPP
+#define LIBBITCOIN_SLICE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/reader.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A reader over borrowed contiguous memory, without stream or per byte
+ * virtual overhead. As istream_reader, a read beyond the end fails the
+ * reader (and returns zeros) rather than throwing. The data must outlive
+ * the reader. Slices of the data may be read without copying.
+ */
+class BC_API slice_reader
+  : public reader
+{
+public:
+    slice_reader(data_slice data);
+
+    operator bool() const;
+    bool operator!() const;
+
+    bool is_exhausted() const;
+    uint8_t read_byte();
+    data_chunk read_data(size_t size);
+    size_t read_data(uint8_t* data, size_t size);
+    data_chunk read_data_to_eof();
+    hash_digest read_hash();
+    short_hash read_short_hash();
+
+    // These read data in little endian format:
+    uint16_t read_2_bytes_little_endian();
+    uint32_t read_4_bytes_little_endian();
+    uint64_t read_8_bytes_little_endian();
+    uint64_t read_variable_uint_little_endian();
+
+    // These read data in big endian format:
+    uint16_t read_2_bytes_big_endian();
+    uint32_t read_4_bytes_big_endian();
+    uint64_t read_8_bytes_big_endian();
+    uint64_t read_variable_uint_big_endian();
+
+    /**
+     * Read a fixed size string padded with zeroes.
+     */
+    std::string read_fixed_string(size_t length);
+
+    /**
+     * Read a variable length string.
+     */
+    std::string read_string();
+
+    /**
+     * Borrow the next size bytes of the data, without copying. Returns an
+     * empty slice (and fails the reader) if fewer remain.
+     */
+    data_slice read_slice(uint64_t size);
+
+    /// The offset of the next byte to be read.
+    size_t position() const;
+
+private:
+    // Obtain the next size bytes, or nullptr (failing the reader).
+    const uint8_t* advance(uint64_t size);
+    size_t available(size_t size) const;
+
+    template <typename Integer>
+    Integer read_little_endian();
+
+    template <typename Integer>
+    Integer read_big_endian();
+
+    const uint8_t* begin_;
+    const uint8_t* end_;
+    const uint8_t* position_;
+    bool valid_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SLICE_WRITER_HPP
+#define LIBBITCOIN_SLICE_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A writer into caller provided contiguous memory, such as a buffer sized
+ * from serialized_size(), a socket buffer or a mapped file. Values are
+ * stored directly, without stream overhead. A write that does not fit
+ * fails the writer and writes nothing. The memory must outlive the writer.
+ */
+class BC_API slice_writer
+  : public writer
+{
+public:
+    slice_writer(uint8_t* begin, uint8_t* end);
+
+    /// Write over the existing bytes of the chunk (it is not resized).
+    slice_writer(data_chunk& data);
+
+    operator bool() const;
+    bool operator!() const;
+
+    void write_byte(uint8_t value);
+    void write_data(const data_chunk& data);
+    void write_data(const uint8_t* data, size_t size);
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+
+    // These write data in little endian format:
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_uint_little_endian(uint64_t value);
+
+    // These write data in big endian format:
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_uint_big_endian(uint64_t value);
+
+    /**
+     * Write a fixed size string padded with zeroes.
+     */
+    void write_fixed_string(const std::string& value, size_t size);
+
+    /**
+     * Write a variable length string.
+     */
+    void write_string(const std::string& value);
+
+    /// The offset of the next byte to be written.
+    size_t position() const;
+
+    /// True if the writer is valid and all of the memory has been written.
+    bool is_exhausted() const;
+
+private:
+    // Obtain the next size bytes, or nullptr (failing the writer).
+    uint8_t* advance(size_t size);
+
+    template <typename Integer>
+    void write_little_endian(Integer value);
+
+    template <typename Integer>
+    void write_big_endian(Integer value);
+
+    uint8_t* begin_;
+    uint8_t* end_;
+    uint8_t* position_;
+    bool valid_;
+};
+
+/**
+ * Write into a chunk of the given size, that expected of the serialization,
+ * with write(slice_writer&). The chunk is resized to the bytes actually
+ * written should the size be wrong, so that the data is never truncated or
+ * padded with zeros.
+ */
+template <typename Write>
+data_chunk write_sized(size_t size, Write write);
+
+/**
+ * Serialize an object with to_data(writer&), as write_sized over its
+ * serialized_size().
+ */
+template <typename Serializable>
+data_chunk to_sized_data(const Serializable& value);
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/slice_writer.ipp>
+
+#endif
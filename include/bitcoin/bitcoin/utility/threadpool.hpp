@@ -20,9 +20,11 @@
 #ifndef LIBBITCOIN_THREADPOOL_HPP
 #define LIBBITCOIN_THREADPOOL_HPP
 
+#include <cstddef>
 #include <memory>
 #include <functional>
 #include <thread>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
@@ -85,6 +87,11 @@ public:
      */
     void join();
 
+    /**
+     * The number of threads currently owned by this threadpool.
+     */
+    size_t size() const;
+
     /**
      * Underlying boost::io_service object.
      */
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_TIMER_WHEEL_HPP
+#define LIBBITCOIN_TIMER_WHEEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A hierarchical timer wheel, which multiplexes any number of coarse timers
+ * onto a single deadline. Scheduling and cancellation are constant time
+ * under a lock, and touch (postponing a scheduled timer) is lock free, which
+ * suits timeouts that are extended upon every message received. Timers
+ * expire in batches, upon ticks of the wheel's resolution.
+ */
+class BC_API timer_wheel
+  : public std::enable_shared_from_this<timer_wheel>
+{
+public:
+    typedef std::shared_ptr<timer_wheel> ptr;
+    typedef std::function<void(const code&)> handler;
+
+    class timer;
+    typedef std::shared_ptr<timer> handle;
+
+    /**
+     * Construct a timer wheel.
+     * @param[in]  pool        The thread pool used by the tick deadline.
+     * @param[in]  resolution  The tick period, which is the granularity of
+     *                         expiry (a timer may expire up to one tick early).
+     */
+    timer_wheel(threadpool& pool, const asio::duration& resolution);
+
+    /// This class is not copyable.
+    timer_wheel(const timer_wheel&) = delete;
+    void operator=(const timer_wheel&) = delete;
+
+    /// Begin ticking on the thread pool.
+    void start();
+
+    /// Stop ticking and release all timers without invoking their handlers.
+    void stop();
+
+    /**
+     * Schedule a new timer.
+     * @param[in]  delay   The time period from now to expiration.
+     * @param[in]  handle  Invoked with success upon expiration, unless
+     *                     the timer is canceled first.
+     * @return             The timer, for use in touch, cancel and schedule.
+     */
+    handle schedule(const asio::duration& delay, handler handle);
+
+    /// Reschedule a pending, expired or canceled timer.
+    void schedule(const handle& timer, const asio::duration& delay,
+        handler handle);
+
+    /// Postpone the expiration of a pending timer to the delay from now.
+    /// A delay shorter than the time remaining may not take effect.
+    void touch(const handle& timer, const asio::duration& delay);
+
+    /// Cancel a timer. The handler is released and will not be invoked,
+    /// even if it has expired on a tick that has not yet invoked it, unless
+    /// its invocation has already begun.
+    void cancel(const handle& timer);
+
+    /// Advance the wheel by one tick, invoking the handlers of expired timers.
+    /// This is invoked by the deadline once started, or may be called directly.
+    void tick();
+
+    /// The number of pending timers.
+    size_t size() const;
+
+private:
+    typedef std::vector<handle> slot;
+
+    uint64_t ticks(const asio::duration& delay) const;
+    void insert(const handle& timer);
+    void remove(const handle& timer);
+    void cascade(size_t level);
+    void handle_tick(const code& ec);
+
+    const asio::duration resolution_;
+    deadline::ptr deadline_;
+    std::atomic<uint64_t> current_;
+
+    mutable std::mutex mutex_;
+    bool stopped_;
+    size_t size_;
+    std::vector<slot> slots_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -20,12 +20,15 @@
 #ifndef LIBBITCOIN_ENCRYPTED_KEYS_HPP
 #define LIBBITCOIN_ENCRYPTED_KEYS_HPP
 
+#include <functional>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
 
 namespace libbitcoin {
@@ -192,6 +195,62 @@ BC_API bool decrypt(ec_compressed& out_point, uint8_t& out_version,
     bool& out_compressed, const encrypted_public& key,
     const std::string& passphrase);
 
+/**
+ * The outcome of the encryption of an ec secret of a batch.
+ */
+struct ek_encryption
+{
+    bool valid;
+    encrypted_private key;
+};
+
+/**
+ * The outcome of the decryption of an encrypted private key of a batch.
+ */
+struct ek_decryption
+{
+    bool valid;
+    ec_secret secret;
+    uint8_t version;
+    bool compressed;
+};
+
+typedef std::vector<ek_encryption> ek_encryption_list;
+typedef std::vector<ek_decryption> ek_decryption_list;
+typedef std::function<void(const ek_encryption_list&)> ek_encryption_handler;
+typedef std::function<void(const ek_decryption_list&)> ek_decryption_handler;
+
+/**
+ * Encrypt each of many ec secrets, as encrypt, on the threads of the pool.
+ * Each thread retains its scrypt working memory from one key to the next.
+ * @param[in]  pool        The threads on which to encrypt.
+ * @param[in]  secrets     The ec secrets to encrypt.
+ * @param[in]  passphrase  A passphrase for use in each encryption.
+ * @param[in]  version     The coin address version byte.
+ * @param[in]  compressed  Set true to associate ec public key compression.
+ * @param[in]  handler     Invoked once, from a pool thread (or from the
+ *                         calling thread if the pool has no threads), with
+ *                         the outcome for each secret in order.
+ */
+BC_API void encrypt(threadpool& pool, const std::vector<ec_secret>& secrets,
+    const std::string& passphrase, uint8_t version, bool compressed,
+    ek_encryption_handler handler);
+
+/**
+ * Decrypt each of many encrypted private keys, as decrypt, on the threads of
+ * the pool. Each thread retains its scrypt working memory from one key to the
+ * next.
+ * @param[in]  pool        The threads on which to decrypt.
+ * @param[in]  keys        The encrypted private keys.
+ * @param[in]  passphrase  The passphrase from the encryption or token.
+ * @param[in]  handler     Invoked once, from a pool thread (or from the
+ *                         calling thread if the pool has no threads), with
+ *                         the outcome for each key in order.
+ */
+BC_API void decrypt(threadpool& pool,
+    const std::vector<encrypted_private>& keys, const std::string& passphrase,
+    ek_decryption_handler handler);
+
 #endif // WITH_ICU
 
 } // namespace wallet
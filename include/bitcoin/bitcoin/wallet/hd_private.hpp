@@ -19,11 +19,14 @@
 #ifndef LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PRIVATE_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
@@ -81,6 +84,19 @@ public:
     hd_key to_hd_key() const;
     hd_public to_public() const;
     hd_private derive_private(uint32_t index) const;
+
+    /// Derive the children [first, first + count), which may be hardened.
+    /// Children that cannot be derived are invalid keys.
+    std::vector<hd_private> derive_private(uint32_t first,
+        size_t count) const;
+
+    /// As above, into a buffer of count keys.
+    void derive_private(hd_private* out, uint32_t first, size_t count) const;
+
+    /// As above, over the threads of the pool. The buffer must remain valid
+    /// until the handler is invoked.
+    void derive_private(threadpool& pool, hd_private* out, uint32_t first,
+        size_t count, completion_handler handler) const;
     hd_public derive_public(uint32_t index) const;
 
 private:
@@ -94,6 +110,8 @@ private:
         uint32_t public_prefix);
     static hd_private from_string(const std::string& encoded,
         uint64_t prefixes);
+    static hd_private derive(const hd_parent& parent, const ec_secret& secret,
+        uint64_t index);
 
     hd_private(const ec_secret& secret, const hd_chain_code& chain_code,
         const hd_lineage& lineage);
@@ -19,11 +19,16 @@
 #ifndef LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 #define LIBBITCOIN_WALLET_HD_PUBLIC_KEY_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 
 namespace libbitcoin {
@@ -52,6 +57,7 @@ struct BC_API hd_lineage
     bool operator!=(const hd_lineage& other) const;
 };
 
+class hd_parent;
 class hd_private;
 
 /// An extended public key, as defined by BIP 32.
@@ -60,6 +66,10 @@ class BC_API hd_public
 public:
     static const uint32_t mainnet;
 
+    /// Invoked once, from a pool thread (or from the calling thread if the
+    /// pool has no threads), when a parallel derivation is done.
+    typedef std::function<void()> completion_handler;
+
     static inline uint32_t to_prefix(uint64_t prefixes)
     {
         return prefixes & 0x00000000FFFFFFFF;
@@ -97,6 +107,29 @@ public:
     hd_key to_hd_key() const;
     hd_public derive_public(uint32_t index) const;
 
+    /// Derive the children [first, first + count). Children that cannot be
+    /// derived, including hardened children, are invalid keys.
+    std::vector<hd_public> derive_public(uint32_t first, size_t count) const;
+
+    /// As above, into a buffer of count keys.
+    void derive_public(hd_public* out, uint32_t first, size_t count) const;
+
+    /// As above, over the threads of the pool. The buffer must remain valid
+    /// until the handler is invoked.
+    void derive_public(threadpool& pool, hd_public* out, uint32_t first,
+        size_t count, completion_handler handler) const;
+
+    /// Derive the payment address hashes of the children [first, first +
+    /// count) into a buffer of count hashes, without constructing the keys.
+    /// Children that cannot be derived have a null hash.
+    void derive_address_hashes(short_hash* out, uint32_t first,
+        size_t count) const;
+
+    /// As above, over the threads of the pool. The buffer must remain valid
+    /// until the handler is invoked.
+    void derive_address_hashes(threadpool& pool, short_hash* out,
+        uint32_t first, size_t count, completion_handler handler) const;
+
 protected:
     /// Factories.
     static hd_public from_secret(const ec_secret& secret,
@@ -117,6 +150,9 @@ private:
     static hd_public from_string(const std::string& encoded);
     static hd_public from_key(const hd_key& public_key, uint32_t prefix);
     static hd_public from_string(const std::string& encoded, uint32_t prefix);
+    static bool derive_point(ec_compressed& out, hd_chain_code& chain_code,
+        const hd_parent& parent, uint64_t index);
+    static hd_public derive(const hd_parent& parent, uint64_t index);
 
     hd_public(const ec_compressed& point,
         const hd_chain_code& chain_code, const hd_lineage& lineage);
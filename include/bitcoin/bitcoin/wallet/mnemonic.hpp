@@ -75,6 +75,14 @@ BC_API bool validate_mnemonic(const word_list& mnemonic,
  */
 BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 
+/**
+ * Convert each of many mnemonics with no passphrase to a wallet-generation
+ * seed, as decode_mnemonic. Where the processor supports it the seeds are
+ * derived in parallel vector lanes.
+ */
+BC_API long_hash_list decode_mnemonics(
+    const std::vector<word_list>& mnemonics);
+
 #ifdef WITH_ICU
 
 /**
@@ -84,6 +92,14 @@ BC_API long_hash decode_mnemonic(const word_list& mnemonic);
 BC_API long_hash decode_mnemonic(const word_list& mnemonic,
     const std::string& passphrase);
 
+/**
+ * Convert each of many mnemonics, with the passphrase of the same position,
+ * to a wallet-generation seed. The lists must be of equal size.
+ */
+BC_API long_hash_list decode_mnemonics(
+    const std::vector<word_list>& mnemonics,
+    const std::vector<std::string>& passphrases);
+
 #endif
 
 } // namespace wallet
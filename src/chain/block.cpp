@@ -21,10 +21,12 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
+#include <bitcoin/bitcoin/math/merkle.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -65,8 +67,8 @@ void block::reset()
 
 bool block::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool block::from_data(std::istream& stream)
@@ -100,12 +102,7 @@ bool block::from_data(reader& source)
 
 data_chunk block::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void block::to_data(std::ostream& stream) const
@@ -133,62 +130,16 @@ uint64_t block::serialized_size() const
     return block_size;
 }
 
-hash_digest build_merkle_tree(hash_list& merkle)
-{
-    // Stop if hash list is empty.
-    if (merkle.empty())
-        return null_hash;
-
-    // While there is more than 1 hash in the list, keep looping...
-    while (merkle.size() > 1)
-    {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0)
-            merkle.push_back(merkle.back());
-
-        // List size is now even.
-        BITCOIN_ASSERT(merkle.size() % 2 == 0);
-
-        // New hash list.
-        hash_list new_merkle;
-
-        // Loop through hashes 2 at a time.
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-        {
-            // Join both current hashes together (concatenate).
-            data_chunk concat_data;
-            data_sink concat_stream(concat_data);
-            ostream_writer concat_sink(concat_stream);
-            concat_sink.write_hash(*it);
-            concat_sink.write_hash(*(it + 1));
-            concat_stream.flush();
-
-            BITCOIN_ASSERT(concat_data.size() == (2 * hash_size));
-
-            // Hash both of the hashes.
-            const auto new_root = bitcoin_hash(concat_data);
-
-            // Add this to the new list.
-            new_merkle.push_back(new_root);
-        }
-
-        // This is the new list.
-        merkle = new_merkle;
-    }
-
-    // Finally we end up with a single item.
-    return merkle[0];
-}
-
 hash_digest block::generate_merkle_root(const transaction::list& transactions)
 {
     // Generate list of transaction hashes.
     hash_list tx_hashes;
+    tx_hashes.reserve(transactions.size());
     for (const auto& tx: transactions)
         tx_hashes.push_back(tx.hash());
 
-    // Build merkle tree.
-    return build_merkle_tree(tx_hashes);
+    // Reduce the tree in place over the hashes.
+    return reduce_merkle_root(tx_hashes);
 }
 
 } // namspace chain
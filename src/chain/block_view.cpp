@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/block_view.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/merkle.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+// The smallest possible serializations, which bound the list reservations.
+static BC_CONSTEXPR size_t min_transaction_size = 10;
+static BC_CONSTEXPR size_t point_size = hash_size + sizeof(uint32_t);
+
+static bool read_transaction(slice_reader& source, data_slice data,
+    std::vector<block_view::transaction>& transactions,
+    std::vector<block_view::input>& inputs,
+    std::vector<block_view::output>& outputs)
+{
+    const auto begin = source.position();
+    block_view::transaction tx
+    {
+        data_slice(nullptr, nullptr), 0, 0, inputs.size(), 0,
+        outputs.size(), 0
+    };
+
+    tx.version = source.read_4_bytes_little_endian();
+    const auto input_count = source.read_variable_uint_little_endian();
+
+    for (uint64_t index = 0; index < input_count && source; ++index)
+    {
+        const auto point = source.read_slice(point_size);
+        const auto script_size = source.read_variable_uint_little_endian();
+        const auto script = source.read_slice(script_size);
+        const auto sequence = source.read_4_bytes_little_endian();
+        inputs.push_back({ point, script, sequence });
+    }
+
+    const auto output_count = source.read_variable_uint_little_endian();
+
+    for (uint64_t index = 0; index < output_count && source; ++index)
+    {
+        const auto value = source.read_8_bytes_little_endian();
+        const auto script_size = source.read_variable_uint_little_endian();
+        const auto script = source.read_slice(script_size);
+        outputs.push_back({ value, script });
+    }
+
+    tx.locktime = source.read_4_bytes_little_endian();
+
+    if (!source)
+        return false;
+
+    tx.input_count = inputs.size() - tx.first_input;
+    tx.output_count = outputs.size() - tx.first_output;
+    tx.data = data_slice(data.data() + begin,
+        data.data() + source.position());
+    transactions.push_back(tx);
+    return true;
+}
+
+bool block_view::from_data(data_slice data)
+{
+    reset();
+    slice_reader source(data);
+    auto result = header_.from_data(source, false);
+    uint64_t count = 0;
+
+    if (result)
+    {
+        count = source.read_variable_uint_little_endian();
+        result = source;
+    }
+
+    if (result)
+    {
+        // The count is untrusted, so reserve no more than could be present.
+        const auto remaining = data.size() - source.position();
+        const auto bound = remaining / min_transaction_size;
+        const auto reserve = static_cast<size_t>(
+            std::min(count, static_cast<uint64_t>(bound)));
+
+        header_.transaction_count = count;
+        transactions_.reserve(reserve);
+        inputs_.reserve(2 * reserve);
+        outputs_.reserve(2 * reserve);
+    }
+
+    for (uint64_t index = 0; index < count && result; ++index)
+        result = read_transaction(source, data, transactions_, inputs_,
+            outputs_);
+
+    if (!result)
+        reset();
+
+    return result;
+}
+
+void block_view::reset()
+{
+    header_.reset();
+    header_.transaction_count = 0;
+    transactions_.clear();
+    inputs_.clear();
+    outputs_.clear();
+}
+
+const chain::header& block_view::header() const
+{
+    return header_;
+}
+
+const std::vector<block_view::transaction>& block_view::transactions() const
+{
+    return transactions_;
+}
+
+const std::vector<block_view::input>& block_view::inputs() const
+{
+    return inputs_;
+}
+
+const std::vector<block_view::output>& block_view::outputs() const
+{
+    return outputs_;
+}
+
+chain::transaction block_view::to_transaction(size_t index) const
+{
+    BITCOIN_ASSERT(index < transactions_.size());
+    slice_reader source(transactions_[index].data);
+    return chain::transaction::factory_from_data(source);
+}
+
+block block_view::to_block() const
+{
+    block instance;
+    instance.header = header_;
+    instance.transactions.reserve(transactions_.size());
+
+    for (size_t index = 0; index < transactions_.size(); ++index)
+        instance.transactions.push_back(to_transaction(index));
+
+    return instance;
+}
+
+hash_list block_view::transaction_hashes() const
+{
+    std::vector<data_slice> items;
+    items.reserve(transactions_.size());
+
+    for (const auto& tx: transactions_)
+        items.push_back(tx.data);
+
+    return bitcoin_hash_many(items);
+}
+
+hash_digest block_view::generate_merkle_root() const
+{
+    auto hashes = transaction_hashes();
+    return reduce_merkle_root(hashes);
+}
+
+} // namspace chain
+} // namspace libbitcoin
@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/compiled_script.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/opcode.hpp>
+#include <bitcoin/bitcoin/chain/operation.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static bool is_counted(opcode code)
+{
+    return static_cast<uint8_t>(code) > static_cast<uint8_t>(opcode::op_16);
+}
+
+static bool is_disabled(opcode code)
+{
+    switch (code)
+    {
+        case opcode::cat:
+        case opcode::substr:
+        case opcode::left:
+        case opcode::right:
+        case opcode::invert:
+        case opcode::and_:
+        case opcode::or_:
+        case opcode::xor_:
+        case opcode::op_2mul:
+        case opcode::op_2div:
+        case opcode::mul:
+        case opcode::div:
+        case opcode::mod:
+        case opcode::lshift:
+        case opcode::rshift:
+            return true;
+
+        // These opcodes aren't in the main Satoshi EvalScript
+        // switch-case so the script loop always fails regardless of
+        // whether these are executed or not.
+        case opcode::verif:
+        case opcode::vernotif:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+// This matches operation::to_data, without the intermediate data_chunk.
+static void write_prefix(data_chunk& buffer, const operation& op)
+{
+    const auto size = op.data.size();
+
+    switch (op.code)
+    {
+        case opcode::raw_data:
+            return;
+
+        case opcode::special:
+            buffer.push_back(static_cast<uint8_t>(size));
+            return;
+
+        case opcode::pushdata1:
+            buffer.push_back(static_cast<uint8_t>(op.code));
+            buffer.push_back(static_cast<uint8_t>(size));
+            return;
+
+        case opcode::pushdata2:
+            buffer.push_back(static_cast<uint8_t>(op.code));
+            extend_data(buffer,
+                to_little_endian(static_cast<uint16_t>(size)));
+            return;
+
+        case opcode::pushdata4:
+            buffer.push_back(static_cast<uint8_t>(op.code));
+            extend_data(buffer,
+                to_little_endian(static_cast<uint32_t>(size)));
+            return;
+
+        default:
+            buffer.push_back(static_cast<uint8_t>(op.code));
+            return;
+    }
+}
+
+compiled_script::compiled_script()
+  : pattern_(script_pattern::non_standard), push_only_(true), valid_(true)
+{
+}
+
+compiled_script::compiled_script(const script& script)
+{
+    compile(script);
+}
+
+void compiled_script::compile(const script& script)
+{
+    const auto& operations = script.operations;
+    buffer_.clear();
+    instructions_.clear();
+    instructions_.reserve(operations.size());
+    valid_ = true;
+
+    size_t counted = 0;
+    for (const auto& op: operations)
+    {
+        instruction instruction;
+        instruction.code = op.code;
+        instruction.begin = static_cast<uint32_t>(buffer_.size());
+        write_prefix(buffer_, op);
+        instruction.data = static_cast<uint32_t>(buffer_.size());
+        instruction.size = static_cast<uint32_t>(op.data.size());
+        extend_data(buffer_, op.data);
+        instructions_.push_back(instruction);
+
+        if (op.data.size() > max_push_data_size || is_disabled(op.code))
+            valid_ = false;
+
+        if (is_counted(op.code))
+            ++counted;
+    }
+
+    // Multisig may add to the count during evaluation, but never subtract.
+    if (buffer_.size() > max_script_size || counted > max_operation_count)
+        valid_ = false;
+
+    push_only_ = operation::is_push_only(operations);
+    pattern_ = script.pattern();
+}
+
+bool compiled_script::is_valid() const
+{
+    return valid_;
+}
+
+bool compiled_script::is_push_only() const
+{
+    return push_only_;
+}
+
+script_pattern compiled_script::pattern() const
+{
+    return pattern_;
+}
+
+const compiled_script::program& compiled_script::instructions() const
+{
+    return instructions_;
+}
+
+const data_chunk& compiled_script::buffer() const
+{
+    return buffer_;
+}
+
+data_slice compiled_script::data(const instruction& instruction) const
+{
+    const auto begin = buffer_.data() + instruction.data;
+    return data_slice(begin, begin + instruction.size);
+}
+
+data_slice compiled_script::code(size_t first, size_t last) const
+{
+    size_t begin = buffer_.size();
+    size_t end = buffer_.size();
+
+    if (first < instructions_.size())
+        begin = instructions_[first].begin;
+
+    if (last < instructions_.size())
+        end = instructions_[last].begin;
+
+    return data_slice(buffer_.data() + begin, buffer_.data() + end);
+}
+
+} // namspace chain
+} // namspace libbitcoin
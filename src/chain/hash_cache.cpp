@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/hash_cache.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <bitcoin/bitcoin/math/hash.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+hash_cache::hash_cache()
+  : state_(state::empty)
+{
+}
+
+hash_cache::hash_cache(const hash_cache& other)
+  : state_(state::empty)
+{
+    hash_digest hash;
+    if (other.get(hash))
+        set(hash);
+}
+
+hash_cache& hash_cache::operator=(const hash_cache& other)
+{
+    hash_digest hash;
+    const auto cached = other.get(hash);
+    clear();
+
+    if (cached)
+        set(hash);
+
+    return *this;
+}
+
+bool hash_cache::get(hash_digest& out) const
+{
+    if (state_.load(std::memory_order_acquire) != state::cached)
+        return false;
+
+    out = hash_;
+    return true;
+}
+
+void hash_cache::set(const hash_digest& hash) const
+{
+    uint8_t expected = state::empty;
+    if (!state_.compare_exchange_strong(expected, state::writing,
+        std::memory_order_acquire))
+        return;
+
+    hash_ = hash;
+    state_.store(state::cached, std::memory_order_release);
+}
+
+void hash_cache::clear()
+{
+    state_.store(state::empty, std::memory_order_relaxed);
+}
+
+} // namspace chain
+} // namspace libbitcoin
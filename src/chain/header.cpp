@@ -21,10 +21,12 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
+#include "../utility/hashing_reader.hpp"
 
 namespace libbitcoin {
 namespace chain {
@@ -55,6 +57,20 @@ header header::factory_from_data(reader& source,
     return instance;
 }
 
+header::header()
+  : header(0, null_hash, null_hash, 0, 0, 0, 0)
+{
+}
+
+header::header(uint32_t version, const hash_digest& previous_block_hash,
+    const hash_digest& merkle, uint32_t timestamp, uint32_t bits,
+    uint32_t nonce, uint64_t transaction_count)
+  : version(version), previous_block_hash(previous_block_hash),
+    merkle(merkle), timestamp(timestamp), bits(bits), nonce(nonce),
+    transaction_count(transaction_count)
+{
+}
+
 bool header::is_valid() const
 {
     return (version != 0) ||
@@ -73,13 +89,14 @@ void header::reset()
     timestamp = 0;
     bits = 0;
     nonce = 0;
+    hash_cache_.clear();
 }
 
 bool header::from_data(const data_chunk& data,
     bool with_transaction_count)
 {
-    data_source istream(data);
-    return from_data(istream, with_transaction_count);
+    slice_reader source(data);
+    return from_data(source, with_transaction_count);
 }
 
 bool header::from_data(std::istream& stream, bool with_transaction_count)
@@ -92,12 +109,15 @@ bool header::from_data(reader& source, bool with_transaction_count)
 {
     auto result = true;
     reset();
-    version = source.read_4_bytes_little_endian();
-    previous_block_hash = source.read_hash();
-    merkle = source.read_hash();
-    timestamp = source.read_4_bytes_little_endian();
-    bits = source.read_4_bytes_little_endian();
-    nonce = source.read_4_bytes_little_endian();
+
+    // The hash is of the 80 byte header, without the transaction count.
+    hashing_reader hashed(source);
+    version = hashed.read_4_bytes_little_endian();
+    previous_block_hash = hashed.read_hash();
+    merkle = hashed.read_hash();
+    timestamp = hashed.read_4_bytes_little_endian();
+    bits = hashed.read_4_bytes_little_endian();
+    nonce = hashed.read_4_bytes_little_endian();
     transaction_count = 0;
     if (with_transaction_count)
         transaction_count = source.read_variable_uint_little_endian();
@@ -105,18 +125,19 @@ bool header::from_data(reader& source, bool with_transaction_count)
     result = source;
     if (!result)
         reset();
+    else
+        hash_cache_.set(hashed.hash());
 
     return result;
 }
 
 data_chunk header::to_data(bool with_transaction_count) const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream, with_transaction_count);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size(with_transaction_count));
-    return data;
+    const auto size = serialized_size(with_transaction_count);
+    return write_sized(size, [&](slice_writer& sink)
+    {
+        to_data(sink, with_transaction_count);
+    });
 }
 
 void header::to_data(std::ostream& stream,
@@ -153,6 +174,23 @@ hash_digest header::hash() const
     return bitcoin_hash(to_data(false));
 }
 
+hash_digest header::cached_hash() const
+{
+    hash_digest value;
+    if (!hash_cache_.get(value))
+    {
+        value = hash();
+        hash_cache_.set(value);
+    }
+
+    return value;
+}
+
+void header::invalidate_hash()
+{
+    hash_cache_.clear();
+}
+
 bool operator==(const header& left, const header& right)
 {
     return (left.version == right.version)
@@ -22,10 +22,11 @@
 #include <sstream>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -67,8 +68,8 @@ void input::reset()
 
 bool input::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool input::from_data(std::istream& stream)
@@ -106,12 +107,7 @@ bool input::from_data(reader& source)
 
 data_chunk input::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void input::to_data(std::ostream& stream) const
@@ -21,10 +21,11 @@
 
 #include <sstream>
 #include <boost/iostreams/stream.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -63,8 +64,8 @@ void output::reset()
 
 bool output::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool output::from_data(std::istream& stream)
@@ -91,12 +92,7 @@ bool output::from_data(reader& source)
 
 data_chunk output::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void output::to_data(std::ostream& stream) const
@@ -19,24 +19,31 @@
  */
 #include <bitcoin/bitcoin/chain/script.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
 #include <boost/algorithm/string.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/chain/compiled_script.hpp>
 #include <bitcoin/bitcoin/chain/operation.hpp>
+#include <bitcoin/bitcoin/chain/signature_hash_cache.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/formats/base16.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/script_number.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/utility/variable_uint_size.hpp>
 #include "../utility/conditional_stack.hpp"
 #include "../utility/evaluation_context.hpp"
+#include "../utility/stack_element.hpp"
 
 namespace libbitcoin {
 namespace chain {
@@ -44,8 +51,8 @@ namespace chain {
 // False is an empty stack.
 static const data_chunk stack_false_value;
 static const data_chunk stack_true_value{ 1 };
-static constexpr uint32_t five_bits = 0x0000001f;
-static constexpr uint64_t op_counter_limit = 201;
+static constexpr uint64_t op_counter_limit =
+    compiled_script::max_operation_count;
 
 script script::factory_from_data(const data_chunk& data, bool prefix,
     parse_mode mode)
@@ -178,12 +185,11 @@ bool script::from_data(reader& source, bool prefix, parse_mode mode)
 
 data_chunk script::to_data(bool prefix) const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream, prefix);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size(prefix));
-    return data;
+    const auto size = serialized_size(prefix);
+    return write_sized(size, [&](slice_writer& sink)
+    {
+        to_data(sink, prefix);
+    });
 }
 
 void script::to_data(std::ostream& stream, bool prefix) const
@@ -335,84 +341,19 @@ bool script::parse(const data_chunk& raw_script)
     return success;
 }
 
-inline hash_digest one_hash()
-{
-    return hash_digest
-    {
-        {
-            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-        }
-    };
-}
-
-inline void nullify_input_sequences(input::list& inputs,
-    uint32_t except_input)
+hash_digest script::generate_signature_hash(const transaction& parent_tx,
+    uint32_t input_index, const script& script_code, uint32_t hash_type)
 {
-    for (size_t index = 0; index < inputs.size(); ++index)
-        if (index != except_input)
-            inputs[index].sequence = 0;
+    const signature_hash_cache cache(parent_tx);
+    return generate_signature_hash(cache, input_index, script_code,
+        hash_type);
 }
 
-hash_digest script::generate_signature_hash(transaction parent_tx,
+hash_digest script::generate_signature_hash(const signature_hash_cache& cache,
     uint32_t input_index, const script& script_code, uint32_t hash_type)
 {
-    // This is NOT considered an error result and callers should not test
-    // for one_hash. This is a bitcoind bug we perpetuate.
-    if (input_index >= parent_tx.inputs.size())
-        return one_hash();
-
     // FindAndDelete(OP_CODESEPARATOR) done in op_checksigverify(...)
-
-    // Blank all other inputs' signatures
-    for (auto& input: parent_tx.inputs)
-        input.script.reset();
-
-    parent_tx.inputs[input_index].script = script_code;
-
-    // The default sighash::all signs all outputs, and the current input.
-    // Transaction cannot be updated without resigning the input.
-    // (note the lack of nullify_input_sequences() call)
-
-    // sighash::none signs no outputs so they can be changed.
-    if ((hash_type & five_bits) == signature_hash_algorithm::none)
-    {
-        parent_tx.outputs.clear();
-        nullify_input_sequences(parent_tx.inputs, input_index);
-    }
-
-    // Sign the single corresponding output to our index.
-    // We don't care about additional inputs or outputs to the tx.
-    else if ((hash_type & five_bits) == signature_hash_algorithm::single)
-    {
-        auto& outputs = parent_tx.outputs;
-        uint32_t output_index = input_index;
-
-        // This is NOT considered an error result and callers should not test
-        // for one_hash. This is a bitcoind bug we perpetuate.
-        if (output_index >= outputs.size())
-            return one_hash();
-
-        outputs.resize(output_index + 1);
-
-        // Loop through outputs except the last one.
-        for (auto it = outputs.begin(); it != outputs.end() - 1; ++it)
-        {
-            it->value = std::numeric_limits<uint64_t>::max();
-            it->script.reset();
-        }
-
-        nullify_input_sequences(parent_tx.inputs, input_index);
-    }
-
-    // Modifier to ignore the other inputs except our own.
-    if (hash_type & signature_hash_algorithm::anyone_can_pay)
-    {
-        parent_tx.inputs[0] = parent_tx.inputs[input_index];
-        parent_tx.inputs.resize(1);
-    }
-
-    return parent_tx.hash(hash_type);
+    return cache.generate(input_index, script_code, hash_type);
 }
 
 // This uses the deterministic nonce technique.
@@ -439,7 +380,17 @@ bool script::check_signature(data_slice signature, const data_chunk& point,
     const script& script_code, const transaction& parent_tx,
     uint32_t input_index)
 {
-    if (!is_point(point))
+    const signature_hash_cache cache(parent_tx);
+    return check_signature(signature, point, script_code, cache,
+        input_index);
+}
+
+// The script code is serialized without length prefix.
+bool check_endorsement(data_slice signature, data_slice point,
+    data_slice script_code, const signature_hash_cache& cache,
+    uint32_t input_index)
+{
+    if (!is_point(point) || signature.empty())
         return false;
 
     // Remove the sighash type from the end of the signature.
@@ -448,14 +399,21 @@ bool script::check_signature(data_slice signature, const data_chunk& point,
     ec_signature.pop_back();
 
     // This always produces a valid signature hash.
-    const auto sighash = generate_signature_hash(parent_tx, input_index,
-        script_code, hash_type);
+    const auto sighash = cache.generate(input_index, script_code, hash_type);
 
     // Validate the EC signature.
-    return verify_signature(point, sighash, ec_signature);
+    return cache.verify_signature(to_chunk(point), sighash, ec_signature);
+}
+
+bool script::check_signature(data_slice signature, const data_chunk& point,
+    const script& script_code, const signature_hash_cache& cache,
+    uint32_t input_index)
+{
+    return check_endorsement(signature, point, script_code.to_data(false),
+        cache, input_index);
 }
 
-inline bool cast_to_bool(const data_chunk& values)
+inline bool cast_to_bool(data_slice values)
 {
     for (auto it = values.begin(); it != values.end(); ++it)
     {
@@ -479,9 +437,9 @@ void stack_swap(DataStack& stack, size_t index_a, size_t index_b)
 }
 
 template <typename DataStack>
-data_chunk pop_item(DataStack& stack)
+stack_element pop_item(DataStack& stack)
 {
-    data_chunk value = stack.back();
+    stack_element value = stack.back();
     stack.pop_back();
     return value;
 }
@@ -568,18 +526,18 @@ bool greater_op_16(opcode code)
 
 bool op_negative_1(evaluation_context& context)
 {
-    script_number neg1(-1);
-    context.primary.push_back(neg1.data());
+    static const auto negative_1 = script_number(-1).data();
+    context.primary.push_back(negative_1);
     return true;
 }
 
 bool op_x(evaluation_context& context, opcode code)
 {
-    const auto difference = static_cast<uint8_t>(code) -
+    const uint8_t value = static_cast<uint8_t>(code) -
         static_cast<uint8_t>(opcode::op_1) + 1;
 
-    script_number value(difference);
-    context.primary.push_back(value.data());
+    // The numbers 1 through 16 serialize to a single byte of their value.
+    context.primary.push_back(data_slice(&value, &value + 1));
     return true;
 }
 
@@ -1143,7 +1101,7 @@ bool op_ripemd160(evaluation_context& context)
         return false;
 
     const auto hash = ripemd160_hash(context.pop_primary());
-    context.primary.push_back(to_chunk(hash));
+    context.primary.push_back(hash);
     return true;
 }
 
@@ -1153,7 +1111,7 @@ bool op_sha1(evaluation_context& context)
         return false;
 
     const auto hash = sha1_hash(context.pop_primary());
-    context.primary.push_back(to_chunk(hash));
+    context.primary.push_back(hash);
     return true;
 }
 
@@ -1163,7 +1121,7 @@ bool op_sha256(evaluation_context& context)
         return false;
 
     const auto hash = sha256_hash(context.pop_primary());
-    context.primary.push_back(to_chunk(hash));
+    context.primary.push_back(hash);
     return true;
 }
 
@@ -1173,7 +1131,7 @@ bool op_hash160(evaluation_context& context)
         return false;
 
     const auto hash = bitcoin_short_hash(context.pop_primary());
-    context.primary.push_back(to_chunk(hash));
+    context.primary.push_back(hash);
     return true;
 }
 
@@ -1183,37 +1141,74 @@ bool op_hash256(evaluation_context& context)
         return false;
 
     const auto hash = bitcoin_hash(context.pop_primary());
-    context.primary.push_back(to_chunk(hash));
+    context.primary.push_back(hash);
     return true;
 }
 
-bool op_checksigverify(evaluation_context& context, const script& script,
-    const transaction& parent_tx, uint32_t input_index)
+inline bool is_equal(data_slice left, data_slice right)
+{
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
+}
+
+// The script code is the script following the last codeseparator, less any
+// codeseparators and operations with data matching a signature (bitcoind's
+// FindAndDelete). This is a slice of the compiled script unless something is
+// removed, in which case it is assembled in the given buffer.
+template <typename Predicate>
+data_slice script_code(const compiled_script& script, size_t first,
+    Predicate is_signature, data_chunk& buffer)
+{
+    const auto& program = script.instructions();
+    const auto is_removed = [&script, &is_signature](
+        const compiled_script::instruction& op)
+    {
+        return op.code == opcode::codeseparator ||
+            is_signature(script.data(op));
+    };
+
+    const auto begin = program.begin() + first;
+    if (std::none_of(begin, program.end(), is_removed))
+        return script.code(first, program.size());
+
+    buffer.clear();
+    for (auto index = first; index < program.size(); ++index)
+    {
+        if (!is_removed(program[index]))
+        {
+            const auto code = script.code(index, index + 1);
+            buffer.insert(buffer.end(), code.begin(), code.end());
+        }
+    }
+
+    return buffer;
+}
+
+bool op_checksigverify(evaluation_context& context,
+    const compiled_script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
 {
     if (context.primary.size() < 2)
         return false;
 
     const auto point = context.pop_primary();
     const auto signature = context.pop_primary();
-
-    chain::script script_code;
-    for (auto it = context.codehash_begin; it != script.operations.end(); ++it)
+    const auto is_signature = [&signature](data_slice data)
     {
-        const auto op = *it;
-        if (op.data == signature || op.code == opcode::codeseparator)
-            continue;
+        return is_equal(data, signature);
+    };
 
-        script_code.operations.push_back(op);
-    }
+    data_chunk buffer;
+    const auto code = script_code(script, context.codehash_begin,
+        is_signature, buffer);
 
-    return script::check_signature(signature, point, script_code, parent_tx,
-        input_index);
+    return check_endorsement(signature, point, code, cache, input_index);
 }
 
-bool op_checksig(evaluation_context& context, const script& script,
-    const transaction& parent_tx, uint32_t input_index)
+bool op_checksig(evaluation_context& context, const compiled_script& script,
+    const signature_hash_cache& cache, uint32_t input_index)
 {
-    if (op_checksigverify(context, script, parent_tx, input_index))
+    if (op_checksigverify(context, script, cache, input_index))
         context.primary.push_back(stack_true_value);
     else
         context.primary.push_back(stack_false_value);
@@ -1228,13 +1223,14 @@ bool read_section(evaluation_context& context, data_stack& section,
         return false;
 
     for (size_t i = 0; i < count; ++i)
-        section.push_back(context.pop_primary());
+        section.push_back(to_chunk(context.pop_primary()));
 
     return true;
 }
 
-bool op_checkmultisigverify(evaluation_context& context, const script& script,
-    const transaction& parent_tx, uint32_t input_index)
+bool op_checkmultisigverify(evaluation_context& context,
+    const compiled_script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
 {
     int32_t pubkeys_count;
     if (!read_value(context.primary, pubkeys_count))
@@ -1268,25 +1264,19 @@ bool op_checkmultisigverify(evaluation_context& context, const script& script,
         return false;
 
     context.primary.pop_back();
-    const auto is_signature = [&signatures](const data_chunk& data)
-    {
-        return std::find(signatures.begin(), signatures.end(), data) != 
-            signatures.end();
-    };
-
-    chain::script script_code;
-    for (auto it = context.codehash_begin; it != script.operations.end(); ++it)
+    const auto is_signature = [&signatures](data_slice data)
     {
-        const operation op = *it;
-
-        if (op.code == opcode::codeseparator)
-            continue;
+        const auto equals = [&data](const data_chunk& signature)
+        {
+            return is_equal(data, signature);
+        };
 
-        if (is_signature(op.data))
-            continue;
+        return std::any_of(signatures.begin(), signatures.end(), equals);
+    };
 
-        script_code.operations.push_back(op);
-    }
+    data_chunk buffer;
+    const auto code = script_code(script, context.codehash_begin,
+        is_signature, buffer);
 
     // The exact number of signatures are required and must be in order.
     // One key can validate more than one script. So we always advance 
@@ -1294,11 +1284,20 @@ bool op_checkmultisigverify(evaluation_context& context, const script& script,
     auto pubkey_iterator = pubkeys.begin();
     for (const auto& signature: signatures)
     {
+        if (signature.empty())
+            return false;
+
+        // The signature hash does not depend on the key, so it is generated
+        // once per signature instead of once per (signature, key) attempt.
+        const auto hash_type = signature.back();
+        const endorsement ec_signature(signature.begin(), signature.end() - 1);
+        const auto sighash = cache.generate(input_index, code, hash_type);
+
         while (true)
         {
             const auto& point = *pubkey_iterator;
-            if (script::check_signature(signature, point, script_code,
-                parent_tx, input_index))
+            if (is_point(point) &&
+                cache.verify_signature(point, sighash, ec_signature))
                 break;
 
             ++pubkey_iterator;
@@ -1310,10 +1309,11 @@ bool op_checkmultisigverify(evaluation_context& context, const script& script,
     return true;
 }
 
-bool op_checkmultisig(evaluation_context& context, const script& script,
-    const transaction& parent_tx, uint32_t input_index)
+bool op_checkmultisig(evaluation_context& context,
+    const compiled_script& script, const signature_hash_cache& cache,
+    uint32_t input_index)
 {
-    if (op_checkmultisigverify(context, script, parent_tx, input_index))
+    if (op_checkmultisigverify(context, script, cache, input_index))
         context.primary.push_back(stack_true_value);
     else
         context.primary.push_back(stack_false_value);
@@ -1321,292 +1321,165 @@ bool op_checkmultisig(evaluation_context& context, const script& script,
     return true;
 }
 
-bool run_operation(const operation& op, const transaction& parent_tx,
-    uint32_t input_index, const script& script, evaluation_context& context)
+// The state shared by the operations of one script evaluation.
+struct machine
 {
-    switch (op.code)
-    {
-        case opcode::zero:
-        case opcode::special:
-        case opcode::pushdata1:
-        case opcode::pushdata2:
-        case opcode::pushdata4:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Invalid push operation in run_operation");
-            return true;
-
-        case opcode::negative_1:
-            return op_negative_1(context);
-
-        case opcode::reserved:
-            return false;
-
-        case opcode::op_1:
-        case opcode::op_2:
-        case opcode::op_3:
-        case opcode::op_4:
-        case opcode::op_5:
-        case opcode::op_6:
-        case opcode::op_7:
-        case opcode::op_8:
-        case opcode::op_9:
-        case opcode::op_10:
-        case opcode::op_11:
-        case opcode::op_12:
-        case opcode::op_13:
-        case opcode::op_14:
-        case opcode::op_15:
-        case opcode::op_16:
-            return op_x(context, op.code);
-
-        case opcode::nop:
-            return true;
-
-        case opcode::ver:
-            return false;
-
-        case opcode::if_:
-            return op_if(context);
-
-        case opcode::notif:
-            return op_notif(context);
-
-        case opcode::verif:
-        case opcode::vernotif:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled opcodes (verif/vernotif) in run_operation");
-            return false;
-
-        case opcode::else_:
-            return op_else(context);
-
-        case opcode::endif:
-            return op_endif(context);
-
-        case opcode::verify:
-            return op_verify(context);
-
-        case opcode::return_:
-            return false;
-
-        case opcode::toaltstack:
-            return op_toaltstack(context);
-
-        case opcode::fromaltstack:
-            return op_fromaltstack(context);
-
-        case opcode::op_2drop:
-            return op_2drop(context);
-
-        case opcode::op_2dup:
-            return op_2dup(context);
-
-        case opcode::op_3dup:
-            return op_3dup(context);
-
-        case opcode::op_2over:
-            return op_2over(context);
-
-        case opcode::op_2rot:
-            return op_2rot(context);
-
-        case opcode::op_2swap:
-            return op_2swap(context);
-
-        case opcode::ifdup:
-            return op_ifdup(context);
-
-        case opcode::depth:
-            return op_depth(context);
-
-        case opcode::drop:
-            return op_drop(context);
-
-        case opcode::dup:
-            return op_dup(context);
-
-        case opcode::nip:
-            return op_nip(context);
-
-        case opcode::over:
-            return op_over(context);
-
-        case opcode::pick:
-            return op_pick(context);
-
-        case opcode::roll:
-            return op_roll(context);
-
-        case opcode::rot:
-            return op_rot(context);
+    const compiled_script& script;
+    const signature_hash_cache& cache;
+    const uint32_t input_index;
+    evaluation_context& context;
+};
 
-        case opcode::swap:
-            return op_swap(context);
+// Operations are dispatched through a table indexed by opcode value.
+typedef bool (*operation_handler)(machine& machine, size_t index);
+typedef std::array<operation_handler, 256> operation_table;
 
-        case opcode::cat:
-        case opcode::substr:
-        case opcode::left:
-        case opcode::right:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled splice operations in run_operation");
-            return false;
-
-        case opcode::tuck:
-            return op_tuck(context);
-
-        case opcode::size:
-            return op_size(context);
-
-        case opcode::invert:
-        case opcode::and_:
-        case opcode::or_:
-        case opcode::xor_:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled bit logic operations in run_operation");
-            return false;
-
-        case opcode::equal:
-            return op_equal(context);
-
-        case opcode::equalverify:
-            return op_equalverify(context);
-
-        case opcode::reserved1:
-        case opcode::reserved2:
-            return false;
-
-        case opcode::op_1add:
-            return op_1add(context);
-
-        case opcode::op_1sub:
-            return op_1sub(context);
-
-        case opcode::op_2mul:
-        case opcode::op_2div:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled opcodes (2mul/2div) in run_operation");
-            return false;
-
-        case opcode::negate:
-            return op_negate(context);
-
-        case opcode::abs:
-            return op_abs(context);
-
-        case opcode::not_:
-            return op_not(context);
-
-        case opcode::op_0notequal:
-            return op_0notequal(context);
-
-        case opcode::add:
-            return op_add(context);
-
-        case opcode::sub:
-            return op_sub(context);
-
-        case opcode::mul:
-        case opcode::div:
-        case opcode::mod:
-        case opcode::lshift:
-        case opcode::rshift:
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Disabled numeric operations in run_operation");
-            return false;
-
-        case opcode::booland:
-            return op_booland(context);
-
-        case opcode::boolor:
-            return op_boolor(context);
-
-        case opcode::numequal:
-            return op_numequal(context);
-
-        case opcode::numequalverify:
-            return op_numequalverify(context);
-
-        case opcode::numnotequal:
-            return op_numnotequal(context);
-
-        case opcode::lessthan:
-            return op_lessthan(context);
-
-        case opcode::greaterthan:
-            return op_greaterthan(context);
-
-        case opcode::lessthanorequal:
-            return op_lessthanorequal(context);
-
-        case opcode::greaterthanorequal:
-            return op_greaterthanorequal(context);
-
-        case opcode::min:
-            return op_min(context);
-
-        case opcode::max:
-            return op_max(context);
-
-        case opcode::within:
-            return op_within(context);
-
-        case opcode::ripemd160:
-            return op_ripemd160(context);
-
-        case opcode::sha1:
-            return op_sha1(context);
-
-        case opcode::sha256:
-            return op_sha256(context);
+template <bool (*Operation)(evaluation_context&)>
+bool run(machine& machine, size_t)
+{
+    return Operation(machine.context);
+}
 
-        case opcode::hash160:
-            return op_hash160(context);
+template <bool (*Operation)(evaluation_context&, const compiled_script&,
+    const signature_hash_cache&, uint32_t)>
+bool run_signature(machine& machine, size_t)
+{
+    return Operation(machine.context, machine.script, machine.cache,
+        machine.input_index);
+}
 
-        case opcode::hash256:
-            return op_hash256(context);
+bool run_push_data(machine& machine, size_t index)
+{
+    const auto& op = machine.script.instructions()[index];
+    const auto data = machine.script.data(op);
+    machine.context.primary.push_back(data);
+    return true;
+}
 
-        case opcode::codeseparator:
-            // This is set in the main run(...) loop
-            // codehash_begin_ is updated to the current
-            // operations_ iterator
-            BITCOIN_ASSERT_MSG(op.code == opcode::bad_operation,
-                "Invalid operation (codeseparator) in run_operation");
-            return true;
+bool run_op_x(machine& machine, size_t index)
+{
+    const auto code = machine.script.instructions()[index].code;
+    return op_x(machine.context, code);
+}
 
-        case opcode::checksig:
-            return op_checksig(context, script, parent_tx, input_index);
+bool run_codeseparator(machine& machine, size_t index)
+{
+    machine.context.codehash_begin = index;
+    return true;
+}
 
-        case opcode::checksigverify:
-            return op_checksigverify(context, script, parent_tx, input_index);
+bool run_nop(machine&, size_t)
+{
+    return true;
+}
 
-        case opcode::checkmultisig:
-            return op_checkmultisig(context, script, parent_tx, input_index);
+// Includes reserved, ver, return and raw_data. Disabled operations are
+// rejected by the compiled script and never reach dispatch.
+bool run_fail(machine&, size_t)
+{
+    return false;
+}
 
-        case opcode::checkmultisigverify:
-            return op_checkmultisigverify(context, script, parent_tx, input_index);
+bool run_unimplemented(machine& machine, size_t index)
+{
+    const auto code = machine.script.instructions()[index].code;
+    log::fatal(LOG_SCRIPT) << "Unimplemented operation <none "
+        << static_cast<int>(code) << ">";
+    return false;
+}
 
-        case opcode::op_nop1:
-        case opcode::op_nop2:
-        case opcode::op_nop3:
-        case opcode::op_nop4:
-        case opcode::op_nop5:
-        case opcode::op_nop6:
-        case opcode::op_nop7:
-        case opcode::op_nop8:
-        case opcode::op_nop9:
-        case opcode::op_nop10:
-            return true;
+operation_table make_operation_table()
+{
+    operation_table table;
+    table.fill(run_unimplemented);
 
-        case opcode::raw_data:
-            return false;
+    const auto set = [&table](opcode code, operation_handler handler)
+    {
+        table[base_value(code)] = handler;
+    };
 
-        default:
-            log::fatal(LOG_SCRIPT) << "Unimplemented operation <none "
-                << static_cast<int>(op.code) << ">";
-            return false;
-    }
+    const auto set_range = [&table](opcode first, opcode last,
+        operation_handler handler)
+    {
+        for (auto code = base_value(first); code <= base_value(last); ++code)
+            table[code] = handler;
+    };
 
-    return false;
+    set(opcode::zero, run_push_data);
+    set(opcode::special, run_push_data);
+    set(opcode::pushdata1, run_push_data);
+    set(opcode::pushdata2, run_push_data);
+    set(opcode::pushdata4, run_push_data);
+    set(opcode::negative_1, run<op_negative_1>);
+    set(opcode::reserved, run_fail);
+    set_range(opcode::op_1, opcode::op_16, run_op_x);
+    set(opcode::nop, run_nop);
+    set(opcode::ver, run_fail);
+    set(opcode::if_, run<op_if>);
+    set(opcode::notif, run<op_notif>);
+    set(opcode::verif, run_fail);
+    set(opcode::vernotif, run_fail);
+    set(opcode::else_, run<op_else>);
+    set(opcode::endif, run<op_endif>);
+    set(opcode::verify, run<op_verify>);
+    set(opcode::return_, run_fail);
+    set(opcode::toaltstack, run<op_toaltstack>);
+    set(opcode::fromaltstack, run<op_fromaltstack>);
+    set(opcode::op_2drop, run<op_2drop>);
+    set(opcode::op_2dup, run<op_2dup>);
+    set(opcode::op_3dup, run<op_3dup>);
+    set(opcode::op_2over, run<op_2over>);
+    set(opcode::op_2rot, run<op_2rot>);
+    set(opcode::op_2swap, run<op_2swap>);
+    set(opcode::ifdup, run<op_ifdup>);
+    set(opcode::depth, run<op_depth>);
+    set(opcode::drop, run<op_drop>);
+    set(opcode::dup, run<op_dup>);
+    set(opcode::nip, run<op_nip>);
+    set(opcode::over, run<op_over>);
+    set(opcode::pick, run<op_pick>);
+    set(opcode::roll, run<op_roll>);
+    set(opcode::rot, run<op_rot>);
+    set(opcode::swap, run<op_swap>);
+    set(opcode::tuck, run<op_tuck>);
+    set(opcode::size, run<op_size>);
+    set(opcode::equal, run<op_equal>);
+    set(opcode::equalverify, run<op_equalverify>);
+    set(opcode::reserved1, run_fail);
+    set(opcode::reserved2, run_fail);
+    set(opcode::op_1add, run<op_1add>);
+    set(opcode::op_1sub, run<op_1sub>);
+    set(opcode::negate, run<op_negate>);
+    set(opcode::abs, run<op_abs>);
+    set(opcode::not_, run<op_not>);
+    set(opcode::op_0notequal, run<op_0notequal>);
+    set(opcode::add, run<op_add>);
+    set(opcode::sub, run<op_sub>);
+    set(opcode::booland, run<op_booland>);
+    set(opcode::boolor, run<op_boolor>);
+    set(opcode::numequal, run<op_numequal>);
+    set(opcode::numequalverify, run<op_numequalverify>);
+    set(opcode::numnotequal, run<op_numnotequal>);
+    set(opcode::lessthan, run<op_lessthan>);
+    set(opcode::greaterthan, run<op_greaterthan>);
+    set(opcode::lessthanorequal, run<op_lessthanorequal>);
+    set(opcode::greaterthanorequal, run<op_greaterthanorequal>);
+    set(opcode::min, run<op_min>);
+    set(opcode::max, run<op_max>);
+    set(opcode::within, run<op_within>);
+    set(opcode::ripemd160, run<op_ripemd160>);
+    set(opcode::sha1, run<op_sha1>);
+    set(opcode::sha256, run<op_sha256>);
+    set(opcode::hash160, run<op_hash160>);
+    set(opcode::hash256, run<op_hash256>);
+    set(opcode::codeseparator, run_codeseparator);
+    set(opcode::checksig, run_signature<op_checksig>);
+    set(opcode::checksigverify, run_signature<op_checksigverify>);
+    set(opcode::checkmultisig, run_signature<op_checkmultisig>);
+    set(opcode::checkmultisigverify, run_signature<op_checkmultisigverify>);
+    set_range(opcode::op_nop1, opcode::op_nop10, run_nop);
+    set(opcode::raw_data, run_fail);
+    return table;
 }
 
 bool increment_op_counter(opcode code, evaluation_context& context)
@@ -1620,115 +1493,90 @@ bool increment_op_counter(opcode code, evaluation_context& context)
     return true;
 }
 
-bool opcode_is_disabled(opcode code)
-{
-    switch (code)
-    {
-        case opcode::cat:
-        case opcode::substr:
-        case opcode::left:
-        case opcode::right:
-        case opcode::invert:
-        case opcode::and_:
-        case opcode::or_:
-        case opcode::xor_:
-        case opcode::op_2mul:
-        case opcode::op_2div:
-        case opcode::mul:
-        case opcode::div:
-        case opcode::mod:
-        case opcode::lshift:
-        case opcode::rshift:
-            return true;
-
-        // These opcodes aren't in the main Satoshi EvalScript
-        // switch-case so the script loop always fails regardless of
-        // whether these are executed or not.
-        case opcode::verif:
-        case opcode::vernotif:
-            return true;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-bool next_step(const transaction& parent_tx, uint32_t input_index,
-    operation::stack::const_iterator it, const script& script,
+bool evaluate(const compiled_script& script,
+    const signature_hash_cache& cache, uint32_t input_index,
     evaluation_context& context)
 {
-    const auto& op = *it;
+    static const auto handlers = make_operation_table();
 
-    if (op.data.size() > 520)
+    // Script size, push size, disabled opcode and operation count limits.
+    if (!script.is_valid())
         return false;
 
-    if (!increment_op_counter(op.code, context))
-        return false;
+    const auto& program = script.instructions();
+    machine machine{ script, cache, input_index, context };
+    context.operation_counter = 0;
+    context.codehash_begin = 0;
 
-    if (opcode_is_disabled(op.code))
-        return false;
+    for (size_t index = 0; index < program.size(); ++index)
+    {
+        const auto code = program[index].code;
 
-    bool allow_execution = !context.conditional.has_failed_branches();
+        if (!increment_op_counter(code, context))
+            return false;
 
-    // continue onwards to next command.
-    if (!allow_execution && !is_condition_opcode(op.code))
-        return true;
+        // Only conditionals are evaluated within a failed branch.
+        if (context.conditional.has_failed_branches() &&
+            !is_condition_opcode(code))
+            continue;
 
-    // push data to the stack
-    if (op.code == opcode::zero)
-        context.primary.push_back(data_chunk());
+        if (!handlers[base_value(code)](machine, index))
+            return false;
 
-    // These operations may also push empty data (opcode zero)
-    // Hence we check the opcode over the shorter !op.data.empty()
-    else if (op.code == opcode::special
-        || op.code == opcode::pushdata1
-        || op.code == opcode::pushdata2
-        || op.code == opcode::pushdata4)
-    {
-        context.primary.push_back(op.data);
+        if (context.primary.size() + context.secondary.size() > 1000)
+            return false;
     }
-    else if (op.code == opcode::codeseparator)
-        context.codehash_begin = it;
-    // opcodes above should assert 9;,sinside run_operation
-    else if (!run_operation(op, parent_tx, input_index, script, context))
-        return false;
-    //log::debug() << "--------------------";
-    //log::debug() << "Run: " << opcode_to_string(op.code);
-    //log::debug() << "Stack:";
-    //for (auto s: stack_)
-    //    log::debug() << "[" << encode_base16(s) << "]";
-    if (context.primary.size() + context.secondary.size() > 1000)
-        return false;
 
-    return true;
+    return context.conditional.closed();
 }
 
-bool evaluate(const transaction& parent_tx, uint32_t input_index,
-    const script& script, evaluation_context& context)
+bool script::verify(const script& input_script, const script& output_script,
+    const transaction& parent_tx, uint32_t input_index, bool bip16_enabled)
 {
-    if (script.satoshi_content_size() > 10000)
-        return false;
-
-    context.operation_counter = 0;
-    context.codehash_begin = script.operations.begin();
-    for (auto it = script.operations.begin(); it != script.operations.end(); ++it)
-        if (!next_step(parent_tx, input_index, it, script, context))
-            return false;
-
-    return context.conditional.closed();
+    const signature_hash_cache cache(parent_tx);
+    return verify(input_script, output_script, cache, input_index,
+        bip16_enabled);
 }
 
 bool script::verify(const script& input_script, const script& output_script,
-    const transaction& parent_tx, uint32_t input_index, bool bip16_enabled)
+    const signature_hash_cache& cache, uint32_t input_index,
+    bool bip16_enabled)
+{
+    const compiled_script input(input_script);
+    const compiled_script output(output_script);
+    return verify(input, output, cache, input_index, bip16_enabled);
+}
+
+bool script::verify(const compiled_script& input_script,
+    const compiled_script& output_script, const signature_hash_cache& cache,
+    uint32_t input_index, bool bip16_enabled)
 {
     evaluation_context input_context;
     evaluation_context output_context;
-    if (!evaluate(parent_tx, input_index, input_script, input_context))
+    return verify(input_script, output_script, cache, input_index,
+        bip16_enabled, input_context, output_context);
+}
+
+bool script::verify(const compiled_script& input_script,
+    const compiled_script& output_script, const signature_hash_cache& cache,
+    uint32_t input_index, bool bip16_enabled,
+    evaluation_context& input_context, evaluation_context& output_context)
+{
+    input_context.clear();
+    output_context.clear();
+    if (!evaluate(input_script, cache, input_index, input_context))
         return false;
 
-    output_context.primary = input_context.primary;
-    if (!evaluate(parent_tx, input_index, output_script, output_context))
+    // The input stack is only needed again for pay-to-script-hash.
+    const auto pay_script_hash = bip16_enabled &&
+        (output_script.pattern() == script_pattern::pay_script_hash);
+
+    if (pay_script_hash)
+        output_context.primary.assign(input_context.primary);
+    else
+        output_context.primary.swap(input_context.primary);
+
+    if (!evaluate(output_script, cache, input_index, output_context))
         return false;
 
     if (output_context.primary.empty())
@@ -1738,27 +1586,30 @@ bool script::verify(const script& input_script, const script& output_script,
         return false;
 
     // Additional validation for spend-to-script-hash transactions
-    if (bip16_enabled &&
-        (output_script.pattern() == script_pattern::pay_script_hash))
+    if (pay_script_hash)
     {
-        if (!operation::is_push_only(input_script.operations))
+        if (!input_script.is_push_only())
             return false;
 
         // Load last input_script stack item as a script
-        evaluation_context eval_context;
-        eval_context.primary = input_context.primary;
         script eval_script;
 
         // Invalid script - parse-able only as raw_data
-        if (!eval_script.from_data(input_context.primary.back(), false,
+        const auto redeem = to_chunk(input_context.primary.back());
+        if (!eval_script.from_data(redeem, false,
             parse_mode::raw_data_fallback))
             return false;
 
-        // Pop last item and copy as starting stack to eval script
+        // The input stack is no longer needed, so evaluate in its place.
+        // Pop last item and use the remainder as starting stack.
+        auto& eval_context = input_context;
         eval_context.primary.pop_back();
+        eval_context.secondary.clear();
+        eval_context.conditional.clear();
 
         // Run script
-        if (!evaluate(parent_tx, input_index, eval_script, eval_context))
+        const compiled_script redeem_script(eval_script);
+        if (!evaluate(redeem_script, cache, input_index, eval_context))
             return false;
 
         if (eval_context.primary.empty())
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/script_verifier.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/compiled_script.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/signature_hash_cache.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/secp256k1_initializer.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/parallel_for.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include "../utility/evaluation_context.hpp"
+
+namespace libbitcoin {
+namespace chain {
+
+// The scripts and stacks of one task, reused across the inputs it verifies.
+struct verify_state
+{
+    evaluation_context input_context;
+    evaluation_context output_context;
+    compiled_script input_script;
+    compiled_script output_script;
+    script prevout_script;
+};
+
+// The state of one verification, shared by the tasks processing it.
+class script_verifier::batch
+{
+public:
+    batch(prevout_fetcher fetch, result_handler handler, bool bip16_enabled,
+        signature_cache* signatures)
+      : fetch_(fetch), handler_(handler), bip16_enabled_(bip16_enabled),
+        signatures_(signatures), failed_(0)
+    {
+    }
+
+    void add(const transaction& tx, size_t tx_index)
+    {
+        caches_.emplace_back(signatures_ == nullptr ?
+            new signature_hash_cache(tx) :
+            new signature_hash_cache(tx, *signatures_));
+        const auto cache = caches_.back().get();
+
+        for (uint32_t index = 0; index < tx.inputs.size(); ++index)
+            jobs_.push_back({ tx_index, index, cache });
+    }
+
+    size_t size() const
+    {
+        return jobs_.size();
+    }
+
+    void prepare()
+    {
+        failed_ = jobs_.size();
+    }
+
+    // Jobs are claimed in order, so every job preceding the first failure is
+    // always run and that failure is independent of scheduling.
+    void run(verify_state& state, size_t index)
+    {
+        if (index > failed_.load())
+            return;
+
+        const auto& job = jobs_[index];
+        const auto& input = job.cache->parent_tx().inputs[job.input_index];
+
+        if (!fetch_(input.previous_output, state.prevout_script))
+        {
+            fail(index, error::input_not_found);
+            return;
+        }
+
+        state.input_script.compile(input.script);
+        state.output_script.compile(state.prevout_script);
+
+        if (!script::verify(state.input_script, state.output_script,
+            *job.cache, job.input_index, bip16_enabled_, state.input_context,
+            state.output_context))
+            fail(index, error::validate_inputs_failed);
+    }
+
+    void complete()
+    {
+        const auto index = failed_.load();
+
+        if (index == jobs_.size())
+        {
+            handler_(error::success, 0, 0);
+            return;
+        }
+
+        const auto& job = jobs_[index];
+        handler_(failure_, job.tx_index, job.input_index);
+    }
+
+private:
+    struct job
+    {
+        size_t tx_index;
+        uint32_t input_index;
+        const signature_hash_cache* cache;
+    };
+
+    void fail(size_t index, const code& ec)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (index < failed_.load())
+        {
+            failed_ = index;
+            failure_ = ec;
+        }
+    }
+
+    const prevout_fetcher fetch_;
+    const result_handler handler_;
+    const bool bip16_enabled_;
+    signature_cache* const signatures_;
+    std::vector<std::unique_ptr<signature_hash_cache>> caches_;
+    std::vector<job> jobs_;
+    std::atomic<size_t> failed_;
+    std::mutex mutex_;
+    code failure_;
+};
+
+script_verifier::script_verifier(threadpool& pool)
+  : pool_(pool), signatures_(nullptr)
+{
+    // Generate the verification tables now rather than in the first worker.
+    verification.initialize();
+}
+
+script_verifier::script_verifier(threadpool& pool,
+    signature_cache& signatures)
+  : pool_(pool), signatures_(&signatures)
+{
+    verification.initialize();
+}
+
+void script_verifier::verify(const block& block, prevout_fetcher fetch,
+    result_handler handler, bool bip16_enabled)
+{
+    const auto work = std::make_shared<batch>(fetch, handler, bip16_enabled,
+        signatures_);
+
+    for (size_t index = 0; index < block.transactions.size(); ++index)
+        if (!block.transactions[index].is_coinbase())
+            work->add(block.transactions[index], index);
+
+    start(work);
+}
+
+void script_verifier::verify(const transaction& tx, prevout_fetcher fetch,
+    result_handler handler, bool bip16_enabled)
+{
+    const auto work = std::make_shared<batch>(fetch, handler, bip16_enabled,
+        signatures_);
+    work->add(tx, 0);
+    start(work);
+}
+
+void script_verifier::start(std::shared_ptr<batch> work)
+{
+    work->prepare();
+
+    const auto run = [work](verify_state& state, size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            work->run(state, index);
+    };
+
+    const auto complete = [work]()
+    {
+        work->complete();
+    };
+
+    // Claim one input at a time, as inputs vary widely in cost.
+    parallel_for<verify_state>(pool_, work->size(), 1, run, complete);
+}
+
+} // namspace chain
+} // namspace libbitcoin
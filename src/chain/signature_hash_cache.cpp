@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/signature_hash_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static constexpr uint32_t five_bits = 0x0000001f;
+
+// An output that is blanked by sighash::single, value -1 and empty script.
+static const data_chunk blank_output
+{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00
+};
+
+inline hash_digest one_hash()
+{
+    return hash_digest
+    {
+        {
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+        }
+    };
+}
+
+template <typename Integer>
+void write_little_endian(sha256_context& context, Integer value)
+{
+    context.update(to_little_endian(value));
+}
+
+static void write_variable_uint(sha256_context& context, uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_little_endian(context, static_cast<uint8_t>(value));
+    }
+    else if (value <= 0xffff)
+    {
+        write_little_endian<uint8_t>(context, 0xfd);
+        write_little_endian(context, static_cast<uint16_t>(value));
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_little_endian<uint8_t>(context, 0xfe);
+        write_little_endian(context, static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_little_endian<uint8_t>(context, 0xff);
+        write_little_endian(context, value);
+    }
+}
+
+signature_hash_cache::signature_hash_cache(const transaction& parent_tx)
+  : signature_hash_cache(parent_tx, nullptr)
+{
+}
+
+signature_hash_cache::signature_hash_cache(const transaction& parent_tx,
+    signature_cache& signatures)
+  : signature_hash_cache(parent_tx, &signatures)
+{
+}
+
+signature_hash_cache::signature_hash_cache(const transaction& parent_tx,
+    signature_cache* signatures)
+  : parent_tx_(parent_tx), signatures_(signatures)
+{
+    const auto point_size = point::satoshi_fixed_size();
+    points_.reserve(point_size * parent_tx_.inputs.size());
+    for (const auto& input: parent_tx_.inputs)
+    {
+        extend_data(points_, input.previous_output.hash);
+        extend_data(points_, to_little_endian(input.previous_output.index));
+    }
+
+    size_t size = 0;
+    for (const auto& output: parent_tx_.outputs)
+        size += output.serialized_size();
+
+    // The offsets are those actually written, whatever the expected sizes.
+    output_offsets_.reserve(parent_tx_.outputs.size() + 1);
+    outputs_ = write_sized(size, [this](slice_writer& sink)
+    {
+        output_offsets_.clear();
+        for (const auto& output: parent_tx_.outputs)
+        {
+            output_offsets_.push_back(sink.position());
+            output.to_data(sink);
+        }
+
+        output_offsets_.push_back(sink.position());
+    });
+}
+
+const transaction& signature_hash_cache::parent_tx() const
+{
+    return parent_tx_;
+}
+
+void signature_hash_cache::write_point(sha256_context& context,
+    uint32_t input_index) const
+{
+    const auto point_size = point::satoshi_fixed_size();
+    const auto point = points_.data() + point_size * input_index;
+    context.update(point, point_size);
+}
+
+// Write an input other than the one being signed, which has an empty script.
+void signature_hash_cache::write_blank_input(sha256_context& context,
+    uint32_t input_index, bool zero_sequence) const
+{
+    uint32_t sequence = 0;
+    if (!zero_sequence)
+        sequence = parent_tx_.inputs[input_index].sequence;
+
+    write_point(context, input_index);
+    write_variable_uint(context, 0);
+    write_little_endian(context, sequence);
+}
+
+void signature_hash_cache::write_outputs(sha256_context& context,
+    uint32_t input_index, uint32_t hash_type) const
+{
+    const auto& outputs = parent_tx_.outputs;
+
+    // sighash::none signs no outputs so they can be changed.
+    if ((hash_type & five_bits) == signature_hash_algorithm::none)
+    {
+        write_variable_uint(context, 0);
+        return;
+    }
+
+    // Sign the single corresponding output to our index, blanking the rest.
+    if ((hash_type & five_bits) == signature_hash_algorithm::single)
+    {
+        BITCOIN_ASSERT(input_index < outputs.size());
+        write_variable_uint(context, input_index + 1);
+        for (uint32_t index = 0; index < input_index; ++index)
+            context.update(blank_output);
+
+        const auto begin = output_offsets_[input_index];
+        const auto end = output_offsets_[input_index + 1];
+        context.update(outputs_.data() + begin, end - begin);
+        return;
+    }
+
+    write_variable_uint(context, outputs.size());
+    context.update(outputs_);
+}
+
+// The midstate at each index covers the version, input count and all prior
+// inputs with empty scripts and unmodified sequences (sighash::all).
+void signature_hash_cache::initialize_midstates() const
+{
+    const auto& inputs = parent_tx_.inputs;
+    midstates_.reserve(inputs.size());
+
+    sha256_context context;
+    write_little_endian(context, parent_tx_.version);
+    write_variable_uint(context, inputs.size());
+
+    for (uint32_t index = 0; index < inputs.size(); ++index)
+    {
+        midstates_.push_back(context);
+        write_blank_input(context, index, false);
+    }
+}
+
+hash_digest signature_hash_cache::generate(uint32_t input_index,
+    const script& script_code, uint32_t hash_type) const
+{
+    return generate(input_index, script_code.to_data(false), hash_type);
+}
+
+hash_digest signature_hash_cache::generate(uint32_t input_index,
+    data_slice script_code, uint32_t hash_type) const
+{
+    const auto& inputs = parent_tx_.inputs;
+
+    // This is NOT considered an error result and callers should not test
+    // for one_hash. This is a bitcoind bug we perpetuate.
+    if (input_index >= inputs.size())
+        return one_hash();
+
+    const auto base_type = hash_type & five_bits;
+    const auto is_none = (base_type == signature_hash_algorithm::none);
+    const auto is_single = (base_type == signature_hash_algorithm::single);
+    const auto anyone_can_pay =
+        (hash_type & signature_hash_algorithm::anyone_can_pay) != 0;
+
+    // This is NOT considered an error result and callers should not test
+    // for one_hash. This is a bitcoind bug we perpetuate.
+    if (is_single && input_index >= parent_tx_.outputs.size())
+        return one_hash();
+
+    // Other inputs' sequences are signed unless outputs may change.
+    const auto zero_sequences = is_none || is_single;
+    // Write the inputs preceding our own (or resume from the cached state).
+    sha256_context context;
+    if (anyone_can_pay)
+    {
+        write_little_endian(context, parent_tx_.version);
+        write_variable_uint(context, 1);
+    }
+    else if (!zero_sequences)
+    {
+        std::call_once(mutex_, &signature_hash_cache::initialize_midstates,
+            this);
+        context = midstates_[input_index];
+    }
+    else
+    {
+        write_little_endian(context, parent_tx_.version);
+        write_variable_uint(context, inputs.size());
+        for (uint32_t index = 0; index < input_index; ++index)
+            write_blank_input(context, index, true);
+    }
+
+    // Our own input carries the script code and its actual sequence.
+    write_point(context, input_index);
+    write_variable_uint(context, script_code.size());
+    context.update(script_code);
+    write_little_endian(context, inputs[input_index].sequence);
+
+    // Write the inputs following our own.
+    if (!anyone_can_pay)
+        for (auto index = input_index + 1; index < inputs.size(); ++index)
+            write_blank_input(context, index, zero_sequences);
+
+    write_outputs(context, input_index, hash_type);
+    write_little_endian(context, parent_tx_.locktime);
+    write_little_endian(context, hash_type);
+
+    // The signature hash is the bitcoin (double sha256) hash of the preimage.
+    return sha256_hash(context.digest());
+}
+
+bool signature_hash_cache::verify_signature(const data_chunk& point,
+    const hash_digest& hash, const endorsement& signature) const
+{
+    if (signatures_ != nullptr)
+        return signatures_->verify(point, hash, signature);
+
+    return bc::verify_signature(point, hash, signature);
+}
+
+} // namspace chain
+} // namspace libbitcoin
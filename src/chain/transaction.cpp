@@ -22,10 +22,12 @@
 #include <sstream>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
+#include "../utility/hashing_reader.hpp"
 
 namespace libbitcoin {
 namespace chain {
@@ -53,6 +55,17 @@ transaction transaction::factory_from_data(reader& source)
     return instance;
 }
 
+transaction::transaction()
+  : version(0), locktime(0)
+{
+}
+
+transaction::transaction(uint32_t version, uint32_t locktime,
+    const input::list& inputs, const output::list& outputs)
+  : version(version), locktime(locktime), inputs(inputs), outputs(outputs)
+{
+}
+
 bool transaction::is_valid() const
 {
     return (version != 0) || (locktime != 0) || !inputs.empty() ||
@@ -65,12 +78,13 @@ void transaction::reset()
     locktime = 0;
     inputs.clear();
     outputs.clear();
+    hash_cache_.clear();
 }
 
 bool transaction::from_data(const data_chunk& data)
 {
-    data_source istream(data);
-    return from_data(istream);
+    slice_reader source(data);
+    return from_data(source);
 }
 
 bool transaction::from_data(std::istream& stream)
@@ -82,54 +96,51 @@ bool transaction::from_data(std::istream& stream)
 bool transaction::from_data(reader& source)
 {
     reset();
-    version = source.read_4_bytes_little_endian();
+    hashing_reader hashed(source);
+    version = hashed.read_4_bytes_little_endian();
     auto result = static_cast<bool>(source);
 
     if (result)
     {
-        uint64_t tx_in_count = source.read_variable_uint_little_endian();
+        uint64_t tx_in_count = hashed.read_variable_uint_little_endian();
         result = source;
 
         for (uint64_t i = 0; (i < tx_in_count) && result; ++i)
         {
             inputs.emplace_back();
-            result = inputs.back().from_data(source);
+            result = inputs.back().from_data(hashed);
         }
     }
 
     if (result)
     {
-        auto tx_out_count = source.read_variable_uint_little_endian();
+        auto tx_out_count = hashed.read_variable_uint_little_endian();
         result = source;
 
         for (uint64_t i = 0; (i < tx_out_count) && result; ++i)
         {
             outputs.emplace_back();
-            result = outputs.back().from_data(source);
+            result = outputs.back().from_data(hashed);
         }
     }
 
     if (result)
     {
-        locktime = source.read_4_bytes_little_endian();
+        locktime = hashed.read_4_bytes_little_endian();
         result = source;
     }
 
     if (!result)
         reset();
+    else
+        hash_cache_.set(hashed.hash());
 
     return result;
 }
 
 data_chunk transaction::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-
-    return data;
+    return to_sized_data(*this);
 }
 
 void transaction::to_data(std::ostream& stream) const
@@ -190,6 +201,23 @@ hash_digest transaction::hash() const
     return bitcoin_hash(to_data());
 }
 
+hash_digest transaction::cached_hash() const
+{
+    hash_digest value;
+    if (!hash_cache_.get(value))
+    {
+        value = hash();
+        hash_cache_.set(value);
+    }
+
+    return value;
+}
+
+void transaction::invalidate_hash()
+{
+    hash_cache_.clear();
+}
+
 hash_digest transaction::hash(uint32_t hash_type_code) const
 {
     data_chunk serialized = to_data();
@@ -22,17 +22,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <errno.h>
-#include <new>
-#include <stdexcept>
-#include "../math/external/crypto_scrypt.h"
+#include <bitcoin/bitcoin/math/scrypt.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
-#include "../math/external/pkcs5_pbkdf2.h"
 #include "../math/external/ripemd160.h"
 #include "../math/external/sha1.h"
-#include "../math/external/sha256.h"
 #include "../math/external/sha512.h"
+#include "../math/sha256_engine.hpp"
+#include "../math/sha512_engine.hpp"
 
 namespace libbitcoin {
 
@@ -53,19 +52,82 @@ short_hash sha1_hash(data_slice data)
 hash_digest sha256_hash(data_slice data)
 {
     hash_digest hash;
-    SHA256_(data.data(), data.size(), hash.data());
+    sha256_single(data.data(), data.size(), hash.data());
     return hash;
 }
 
 hash_digest sha256_hash(data_slice first, data_slice second)
 {
-    hash_digest hash;
+    sha256_context context;
+    context.update(first);
+    context.update(second);
+    return context.digest();
+}
+
+sha256_context::sha256_context()
+  : size_(0)
+{
+    std::copy(sha256_initial_state, sha256_initial_state + state_.size(),
+        state_.begin());
+}
+
+void sha256_context::update(data_slice data)
+{
+    update(data.data(), data.size());
+}
+
+void sha256_context::update(const uint8_t* data, size_t size)
+{
+    const auto transform = sha256_selected().transform;
+    auto used = static_cast<size_t>(size_ % block_size);
+    size_ += size;
+
+    // Complete a previously buffered partial block.
+    if (used > 0)
+    {
+        const auto fill = std::min(size, block_size - used);
+        std::copy(data, data + fill, buffer_.begin() + used);
+        data += fill;
+        size -= fill;
+        used += fill;
 
-    SHA256CTX context;
-    SHA256Init(&context);
-    SHA256Update(&context, first.data(), first.size());
-    SHA256Update(&context, second.data(), second.size());
-    SHA256Final(&context, hash.data());
+        if (used < block_size)
+            return;
+
+        transform(state_.data(), buffer_.data(), 1);
+    }
+
+    // Transform whole blocks directly from the source.
+    const auto blocks = size / block_size;
+    transform(state_.data(), data, blocks);
+    data += blocks * block_size;
+    size -= blocks * block_size;
+
+    std::copy(data, data + size, buffer_.begin());
+}
+
+hash_digest sha256_context::digest() const
+{
+    // Pad a copy so that the midstate remains resumable.
+    auto copy = *this;
+    const auto bits = to_big_endian<uint64_t>(size_ * 8);
+    const auto used = static_cast<size_t>(size_ % block_size);
+    const auto zeros = (used < 56 ? 56 : 120) - used - 1;
+
+    static const uint8_t terminator = 0x80;
+    static const std::array<uint8_t, block_size> padding{ {} };
+    copy.update(&terminator, 1);
+    copy.update(padding.data(), zeros);
+    copy.update(bits.data(), bits.size());
+    BITCOIN_ASSERT(copy.size_ % block_size == 0);
+
+    hash_digest hash;
+    for (size_t word = 0; word < copy.state_.size(); ++word)
+    {
+        const auto bytes = to_big_endian(copy.state_[word]);
+        std::copy(bytes.begin(), bytes.end(),
+            hash.begin() + word * sizeof(uint32_t));
+    }
 
     return hash;
 }
@@ -91,55 +153,210 @@ long_hash hmac_sha512_hash(data_slice data, data_slice key)
     return hash;
 }
 
+hmac_sha512_context::hmac_sha512_context(data_slice key)
+  : size_(0)
+{
+    hmac_sha512_key(state_.data(), outer_.data(), key.data(), key.size());
+}
+
+void hmac_sha512_context::update(data_slice data)
+{
+    update(data.data(), data.size());
+}
+
+void hmac_sha512_context::update(const uint8_t* data, size_t size)
+{
+    auto used = static_cast<size_t>(size_ % block_size);
+    size_ += size;
+
+    // Complete a previously buffered partial block.
+    if (used > 0)
+    {
+        const auto fill = std::min(size, block_size - used);
+        std::copy(data, data + fill, buffer_.begin() + used);
+        data += fill;
+        size -= fill;
+        used += fill;
+
+        if (used < block_size)
+            return;
+
+        sha512_transform_generic(state_.data(), buffer_.data(), 1);
+    }
+
+    // Transform whole blocks directly from the source.
+    const auto blocks = size / block_size;
+    sha512_transform_generic(state_.data(), data, blocks);
+    data += blocks * block_size;
+    size -= blocks * block_size;
+
+    // Buffer the remainder.
+    std::copy(data, data + size, buffer_.begin());
+}
+
+long_hash hmac_sha512_context::digest() const
+{
+    // Finish copies so that the keyed midstates remain resumable.
+    auto inner = *this;
+    const auto hash = inner.finish();
+
+    auto outer = *this;
+    outer.size_ = 0;
+    outer.state_ = outer_;
+    outer.update(hash);
+    return outer.finish();
+}
+
+long_hash hmac_sha512_context::finish()
+{
+    // The keyed block precedes the message, so is included in its length.
+    // The length is of 128 bits, the high 64 bits of which are always zero.
+    const auto bits = to_big_endian<uint64_t>((block_size + size_) * 8);
+    const auto used = static_cast<size_t>(size_ % block_size);
+    const auto zeros = (used < 112 ? 112 : 240) - used - 1;
+
+    static const uint8_t terminator = 0x80;
+    static const std::array<uint8_t, block_size> padding{ {} };
+    update(&terminator, 1);
+    update(padding.data(), zeros);
+    update(padding.data(), sizeof(uint64_t));
+    update(bits.data(), bits.size());
+    BITCOIN_ASSERT(size_ % block_size == 0);
+
+    long_hash hash;
+    for (size_t word = 0; word < state_.size(); ++word)
+    {
+        const auto bytes = to_big_endian(state_[word]);
+        std::copy(bytes.begin(), bytes.end(),
+            hash.begin() + word * sizeof(uint64_t));
+    }
+
+    return hash;
+}
+
+// The first hmac of the single output block covers the salt and the block
+// index (one), each subsequent hmac only the previous output.
+static long_hash pbkdf2_first(data_slice passphrase, data_slice salt)
+{
+    static const byte_array<4> first_block{ { 0, 0, 0, 1 } };
+    hmac_sha512_context context(passphrase);
+    context.update(salt);
+    context.update(first_block);
+    return context.digest();
+}
+
+// An iteration count of zero is treated as one.
+static size_t pbkdf2_rounds(size_t iterations)
+{
+    return iterations == 0 ? 0 : iterations - 1;
+}
+
 long_hash pkcs5_pbkdf2_hmac_sha512(data_slice passphrase,
     data_slice salt, size_t iterations)
 {
-    long_hash hash;
-    const auto result = pkcs5_pbkdf2(passphrase.data(), passphrase.size(),
-        salt.data(), salt.size(), hash.data(), hash.size(), iterations);
+    std::array<uint64_t, 8> inner;
+    std::array<uint64_t, 8> outer;
+    hmac_sha512_key(inner.data(), outer.data(), passphrase.data(),
+        passphrase.size());
 
-    if (result != 0)
-        throw std::bad_alloc();
+    auto hash = pbkdf2_first(passphrase, salt);
+    pbkdf2_sha512_iterate(inner.data(), outer.data(), hash.data(),
+        pbkdf2_rounds(iterations));
 
     return hash;
 }
 
+long_hash_list pkcs5_pbkdf2_hmac_sha512_many(
+    const std::vector<data_slice>& passphrases,
+    const std::vector<data_slice>& salts, size_t iterations)
+{
+    BITCOIN_ASSERT(passphrases.size() == salts.size());
+    static BC_CONSTEXPR size_t state_size = 8;
+    const auto count = passphrases.size();
+    const auto lanes = sha512_lanes();
+    const auto rounds = pbkdf2_rounds(iterations);
+
+    std::vector<uint64_t> inners(lanes * state_size);
+    std::vector<uint64_t> outers(lanes * state_size);
+    std::vector<uint8_t> results(lanes * long_hash_size);
+    long_hash_list hashes(count);
+    size_t item = 0;
+
+    // Iterate whole groups of derivations together, one in each lane.
+    for (; lanes > 1 && count - item >= lanes; item += lanes)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto& passphrase = passphrases[item + lane];
+            hmac_sha512_key(&inners[lane * state_size],
+                &outers[lane * state_size], passphrase.data(),
+                passphrase.size());
+
+            const auto first = pbkdf2_first(passphrase, salts[item + lane]);
+            std::copy(first.begin(), first.end(),
+                results.begin() + lane * long_hash_size);
+        }
+
+        pbkdf2_sha512_iterate_lanes(inners.data(), outers.data(),
+            results.data(), rounds);
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto result = results.begin() + lane * long_hash_size;
+            std::copy(result, result + long_hash_size,
+                hashes[item + lane].begin());
+        }
+    }
+
+    // Derive the remainder individually.
+    for (; item < count; ++item)
+        hashes[item] = pkcs5_pbkdf2_hmac_sha512(passphrases[item],
+            salts[item], iterations);
+
+    return hashes;
+}
+
 hash_digest bitcoin_hash(data_slice data)
 {
-    return sha256_hash(sha256_hash(data));
+    hash_digest hash;
+    sha256_single(data.data(), data.size(), hash.data());
+    sha256_single(hash.data(), hash.size(), hash.data());
+    return hash;
 }
 
-short_hash bitcoin_short_hash(data_slice data)
+hash_list bitcoin_hash_many(const std::vector<data_slice>& items)
 {
-    return ripemd160_hash(sha256_hash(data));
+    hash_list hashes(items.size());
+    sha256_double_many(items.data(), items.size(), hashes.data());
+    return hashes;
+}
+
+void bitcoin_hash_pairs(hash_digest* out, const hash_digest* in,
+    size_t count)
+{
+    sha256_double_pairs(out, in, count);
 }
 
-static void handle_script_result(int result)
+std::vector<std::string> sha256_implementations()
 {
-    if (result == 0)
-        return;
+    return sha256_supported();
+}
 
-    switch (errno)
-    {
-        case EFBIG:
-            throw std::length_error("scrypt parameter too large");
-        case EINVAL:
-            throw std::runtime_error("scrypt invalid argument");
-        case ENOMEM:
-            throw std::length_error("scrypt address space");
-        default:
-            throw std::bad_alloc();
-    }
+bool select_sha256_implementation(const std::string& name)
+{
+    return sha256_select(name);
+}
+
+short_hash bitcoin_short_hash(data_slice data)
+{
+    return ripemd160_hash(sha256_hash(data));
 }
 
 data_chunk scrypt(data_slice data, data_slice salt, uint64_t N, uint32_t p,
     uint32_t r, size_t length)
 {
-    data_chunk output(length);
-    const auto result = crypto_scrypt(data.data(), data.size(), salt.data(),
-        salt.size(), N, r, p, output.data(), output.size());
-    handle_script_result(result);
-    return output;
+    scrypt_context context(N, p, r);
+    return context.hash(data, salt, length);
 }
 
 } // namespace libbitcoin
@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/merkle.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+// Hash the last node of an odd level with itself into out.
+static void hash_last(hash_digest& out, const hash_digest& last)
+{
+    const hash_digest pair[2] = { last, last };
+    bitcoin_hash_pairs(&out, pair, 1);
+}
+
+// Reduce a level of count nodes in place to the level above, returning its
+// width. The pairs are hashed as a batch, in parallel lanes where supported.
+static size_t reduce_level(hash_digest* nodes, size_t count)
+{
+    BITCOIN_ASSERT(count > 1);
+    const auto pairs = count / 2;
+    const auto last = nodes[count - 1];
+    bitcoin_hash_pairs(nodes, nodes, pairs);
+
+    if (count % 2 == 0)
+        return pairs;
+
+    hash_last(nodes[pairs], last);
+    return pairs + 1;
+}
+
+hash_digest merkle_root(const hash_list& leaves)
+{
+    auto nodes = leaves;
+    return reduce_merkle_root(nodes);
+}
+
+hash_digest reduce_merkle_root(hash_list& leaves)
+{
+    if (leaves.empty())
+        return null_hash;
+
+    for (auto count = leaves.size(); count > 1;)
+        count = reduce_level(leaves.data(), count);
+
+    return leaves.front();
+}
+
+hash_list merkle_branch(const hash_list& leaves, size_t index)
+{
+    hash_list branch;
+
+    if (index >= leaves.size())
+        return branch;
+
+    auto nodes = leaves;
+    for (auto count = nodes.size(); count > 1; index /= 2)
+    {
+        // The last node of an odd level is its own sibling.
+        auto sibling = index ^ 1;
+        if (sibling >= count)
+            sibling = index;
+
+        branch.push_back(nodes[sibling]);
+        count = reduce_level(nodes.data(), count);
+    }
+
+    return branch;
+}
+
+hash_digest merkle_branch_root(const hash_digest& leaf,
+    const hash_list& branch, size_t index)
+{
+    auto node = leaf;
+    hash_digest pair[2];
+
+    for (const auto& sibling: branch)
+    {
+        if (index % 2 == 0)
+        {
+            pair[0] = node;
+            pair[1] = sibling;
+        }
+        else
+        {
+            pair[0] = sibling;
+            pair[1] = node;
+        }
+
+        bitcoin_hash_pairs(&node, pair, 1);
+        index /= 2;
+    }
+
+    return node;
+}
+
+// The full tree, with each level stored after the level below it and a
+// flag for each node that is a match or an ancestor of one.
+struct merkle_tree
+{
+    hash_list nodes;
+    std::vector<bool> matched;
+    std::vector<size_t> offsets;
+    std::vector<size_t> widths;
+};
+
+static void build_tree(merkle_tree& tree, const hash_list& leaves,
+    const std::vector<bool>& matches)
+{
+    BITCOIN_ASSERT(!leaves.empty());
+
+    size_t total = 0;
+    for (auto width = leaves.size(); ; width = (width + 1) / 2)
+    {
+        tree.offsets.push_back(total);
+        tree.widths.push_back(width);
+        total += width;
+
+        if (width == 1)
+            break;
+    }
+
+    tree.nodes.reserve(total);
+    tree.nodes.assign(leaves.begin(), leaves.end());
+    tree.nodes.resize(total);
+
+    tree.matched.assign(total, false);
+    for (size_t index = 0; index < leaves.size(); ++index)
+        tree.matched[index] = index < matches.size() && matches[index];
+
+    for (size_t level = 1; level < tree.widths.size(); ++level)
+    {
+        const auto below = tree.offsets[level - 1];
+        const auto above = tree.offsets[level];
+        const auto width = tree.widths[level - 1];
+        const auto pairs = width / 2;
+        bitcoin_hash_pairs(&tree.nodes[above], &tree.nodes[below], pairs);
+
+        if (width % 2 != 0)
+            hash_last(tree.nodes[above + pairs], tree.nodes[below + width - 1]);
+
+        for (size_t index = 0; index < tree.widths[level]; ++index)
+        {
+            const auto left = below + 2 * index;
+            tree.matched[above + index] = tree.matched[left] ||
+                (2 * index + 1 < width && tree.matched[left + 1]);
+        }
+    }
+}
+
+static void traverse_tree(const merkle_tree& tree, size_t level,
+    size_t position, hash_list& out_hashes, data_chunk& out_flags,
+    size_t& bits)
+{
+    const auto index = tree.offsets[level] + position;
+    const bool matched = tree.matched[index];
+
+    if (bits % 8 == 0)
+        out_flags.push_back(0x00);
+
+    if (matched)
+        out_flags.back() |= static_cast<uint8_t>(1 << (bits % 8));
+
+    ++bits;
+
+    if (level == 0 || !matched)
+    {
+        out_hashes.push_back(tree.nodes[index]);
+        return;
+    }
+
+    const auto left = 2 * position;
+    traverse_tree(tree, level - 1, left, out_hashes, out_flags, bits);
+
+    if (left + 1 < tree.widths[level - 1])
+        traverse_tree(tree, level - 1, left + 1, out_hashes, out_flags, bits);
+}
+
+void partial_merkle_tree(hash_list& out_hashes, data_chunk& out_flags,
+    const hash_list& leaves, const std::vector<bool>& matches)
+{
+    out_hashes.clear();
+    out_flags.clear();
+
+    if (leaves.empty())
+        return;
+
+    merkle_tree tree;
+    build_tree(tree, leaves, matches);
+
+    size_t bits = 0;
+    const auto root = tree.widths.size() - 1;
+    traverse_tree(tree, root, 0, out_hashes, out_flags, bits);
+}
+
+} // namespace libbitcoin
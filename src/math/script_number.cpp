@@ -58,19 +58,20 @@ data_chunk script_number_serialize(const int64_t value)
     return result;
 }
 
-int64_t script_number_deserialize(const data_chunk& data)
+int64_t script_number_deserialize(data_slice data)
 {
     BITCOIN_ASSERT(data.size() <= max_script_number_size);
     if (data.empty())
         return 0;
 
+    const auto bytes = data.data();
     int64_t result = 0;
     for (size_t i = 0; i != data.size(); ++i)
-        result |= static_cast<int64_t>(data[i]) << 8 * i;
+        result |= static_cast<int64_t>(bytes[i]) << 8 * i;
 
     // If the input vector's most significant byte is 0x80, remove it from
     // the result's msb and return a negative.
-    if (data.back() & 0x80)
+    if (bytes[data.size() - 1] & 0x80)
         return -(result & ~(0x80 << (8 * (data.size() - 1))));
 
     return result;
@@ -85,7 +86,7 @@ script_number::script_number()
     // You must call set_data() after.
 }
 
-bool script_number::set_data(const data_chunk& data)
+bool script_number::set_data(data_slice data)
 {
     if (data.size() > max_script_number_size)
         return false;
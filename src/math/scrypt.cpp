@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/scrypt.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include "../math/external/pbkdf2_sha256.h"
+#include "../math/scrypt_engine.hpp"
+
+namespace libbitcoin {
+
+static constexpr uint64_t max_length = 32 * uint64_t(0xffffffff);
+
+// The parameter limits of the original implementation (crypto_scrypt).
+static void validate(uint64_t N, uint32_t p, uint32_t r)
+{
+    if (static_cast<uint64_t>(r) * p >= (uint64_t(1) << 30))
+        throw std::length_error("scrypt parameter too large");
+
+    if (N == 0 || (N & (N - 1)) != 0 || p == 0 || r == 0)
+        throw std::runtime_error("scrypt invalid argument");
+
+    static constexpr auto max_size = std::numeric_limits<size_t>::max();
+    if (r > max_size / 128 / p || r > max_size / 256 ||
+        N > max_size / 128 / r)
+        throw std::length_error("scrypt address space");
+}
+
+// The units of mixing of a single hash, claimed from a shared cursor by the
+// participants. Groups of blocks are mixed in the lanes of the
+// implementation, any remaining blocks singly.
+class scrypt_context::job
+{
+public:
+    job(const scrypt_implementation& implementation, uint8_t* blocks,
+        uint64_t N, uint32_t p, uint32_t r)
+      : implementation_(implementation),
+        blocks_(blocks),
+        N_(N),
+        r_(r),
+        lanes_(std::max(implementation.lanes, size_t(1))),
+        groups_(implementation.lanes == 0 ? 0 : p / lanes_),
+        units_(groups_ + p - groups_ * lanes_),
+        next_(0),
+        done_(0)
+    {
+    }
+
+    size_t units() const
+    {
+        return units_;
+    }
+
+    // The words of memory and scratch required by each participant.
+    size_t memory_size() const
+    {
+        const auto blocks = groups_ == 0 ? 1 : lanes_;
+        return blocks * (32 * r_ * static_cast<size_t>(N_) + 64 * r_);
+    }
+
+    // Mix units until none remain. A participant that starts late claims
+    // none, and so does not refer to its memory.
+    void run(uint32_t* memory)
+    {
+        for (auto unit = next_++; unit < units_; unit = next_++)
+        {
+            mix(unit, memory);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (++done_ == units_)
+                completed_.notify_one();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        completed_.wait(lock, [this]() { return done_ == units_; });
+    }
+
+private:
+    void mix(size_t unit, uint32_t* memory) const
+    {
+        const auto block_size = 128 * r_;
+        const auto memory_words = 32 * r_ * static_cast<size_t>(N_);
+
+        if (unit < groups_)
+        {
+            const auto blocks = blocks_ + unit * lanes_ * block_size;
+            implementation_.mix_lanes(blocks, r_, N_, memory,
+                memory + lanes_ * memory_words);
+            return;
+        }
+
+        const auto block = groups_ * lanes_ + unit - groups_;
+        implementation_.mix(blocks_ + block * block_size, r_, N_, memory,
+            memory + memory_words);
+    }
+
+    const scrypt_implementation& implementation_;
+    uint8_t* const blocks_;
+    const uint64_t N_;
+    const size_t r_;
+    const size_t lanes_;
+    const size_t groups_;
+    const size_t units_;
+
+    std::atomic<size_t> next_;
+    size_t done_;
+    std::mutex mutex_;
+    std::condition_variable completed_;
+};
+
+scrypt_context::scrypt_context(uint64_t N, uint32_t p, uint32_t r)
+  : scrypt_context(N, p, r, nullptr)
+{
+}
+
+scrypt_context::scrypt_context(uint64_t N, uint32_t p, uint32_t r,
+    threadpool& pool)
+  : scrypt_context(N, p, r, &pool)
+{
+}
+
+scrypt_context::scrypt_context(uint64_t N, uint32_t p, uint32_t r,
+    threadpool* pool)
+  : N_(N), p_(p), r_(r), pool_(pool)
+{
+    validate(N, p, r);
+    blocks_.resize(128 * static_cast<size_t>(r) * p);
+}
+
+data_chunk scrypt_context::hash(data_slice data, data_slice salt,
+    size_t length)
+{
+    data_chunk out(length);
+    hash(out.data(), out.size(), data, salt);
+    return out;
+}
+
+void scrypt_context::hash(uint8_t* out, size_t length, data_slice data,
+    data_slice salt)
+{
+    if (static_cast<uint64_t>(length) > max_length)
+        throw std::length_error("scrypt parameter too large");
+
+    pbkdf2_sha256(data.data(), data.size(), salt.data(), salt.size(), 1,
+        blocks_.data(), blocks_.size());
+
+    mix();
+
+    pbkdf2_sha256(data.data(), data.size(), blocks_.data(), blocks_.size(),
+        1, out, length);
+}
+
+// The calling thread participates, so waiting on a pool thread cannot
+// deadlock, whether or not the other participants are scheduled.
+void scrypt_context::mix()
+{
+    const auto work = std::make_shared<job>(scrypt_selected(),
+        blocks_.data(), N_, p_, r_);
+
+    const auto threads = pool_ == nullptr ? 0 : pool_->size();
+    const auto participants = std::min(work->units(), threads + 1);
+
+    if (memory_.size() < participants)
+        memory_.resize(participants);
+
+    for (size_t participant = 0; participant < participants; ++participant)
+        if (memory_[participant].size() < work->memory_size())
+            memory_[participant].resize(work->memory_size());
+
+    for (size_t participant = 1; participant < participants; ++participant)
+    {
+        const auto memory = memory_[participant].data();
+        pool_->service().post([work, memory]() { work->run(memory); });
+    }
+
+    work->run(memory_.front().data());
+    work->wait();
+}
+
+std::vector<std::string> scrypt_implementations()
+{
+    return scrypt_supported();
+}
+
+bool select_scrypt_implementation(const std::string& name)
+{
+    return scrypt_select(name);
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,261 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/scrypt_engine.hpp"
+
+#ifdef BC_SHA256_X86
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <immintrin.h>
+
+// Two blocks are mixed at once, one in each 128 bit half of the 256 bit avx2
+// registers. The words of each 64 byte block are arranged by diagonal, as in
+// the sse2 kernel, and the rows of the two blocks are interleaved. Each block
+// retains its own region of memory, as its reads from it are independent.
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t lanes = 2;
+static BC_CONSTEXPR size_t block_words = 16;
+static BC_CONSTEXPR size_t block_vectors = 4;
+static BC_CONSTEXPR size_t row_words = 4;
+
+static inline uint32_t read_word(const uint8_t* block, size_t index)
+{
+    const auto word = block + index * sizeof(uint32_t);
+    return static_cast<uint32_t>(word[0]) |
+        (static_cast<uint32_t>(word[1]) << 8) |
+        (static_cast<uint32_t>(word[2]) << 16) |
+        (static_cast<uint32_t>(word[3]) << 24);
+}
+
+static inline void write_word(uint8_t* block, size_t index, uint32_t value)
+{
+    const auto word = block + index * sizeof(uint32_t);
+    word[0] = static_cast<uint8_t>(value);
+    word[1] = static_cast<uint8_t>(value >> 8);
+    word[2] = static_cast<uint8_t>(value >> 16);
+    word[3] = static_cast<uint8_t>(value >> 24);
+}
+
+BC_TARGET("avx2")
+static inline __m256i load(const uint32_t* words)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+}
+
+BC_TARGET("avx2")
+static inline void store(uint32_t* words, __m256i value)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), value);
+}
+
+// Combine a row of each lane (lane zero in the lower half).
+BC_TARGET("avx2")
+static inline __m256i load(const uint32_t* first, const uint32_t* second)
+{
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    const auto high = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(second));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+// Split a row to each lane.
+BC_TARGET("avx2")
+static inline void store(uint32_t* first, uint32_t* second, __m256i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(first),
+        _mm256_castsi256_si128(value));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(second),
+        _mm256_extracti128_si256(value, 1));
+}
+
+BC_TARGET("avx2")
+static inline __m256i add(__m256i left, __m256i right)
+{
+    return _mm256_add_epi32(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_xor(__m256i left, __m256i right)
+{
+    return _mm256_xor_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i rotate_left(__m256i value, int bits)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(value, bits),
+        _mm256_srli_epi32(value, 32 - bits));
+}
+
+// B <- B + doubleround^4(B), for the block of each lane.
+BC_TARGET("avx2")
+static inline void salsa20_8(__m256i* block)
+{
+    auto x0 = block[0];
+    auto x1 = block[1];
+    auto x2 = block[2];
+    auto x3 = block[3];
+
+    for (size_t round = 0; round < 8; round += 2)
+    {
+        // Columns.
+        x1 = bit_xor(x1, rotate_left(add(x0, x3), 7));
+        x2 = bit_xor(x2, rotate_left(add(x1, x0), 9));
+        x3 = bit_xor(x3, rotate_left(add(x2, x1), 13));
+        x0 = bit_xor(x0, rotate_left(add(x3, x2), 18));
+
+        x1 = _mm256_shuffle_epi32(x1, 0x93);
+        x2 = _mm256_shuffle_epi32(x2, 0x4e);
+        x3 = _mm256_shuffle_epi32(x3, 0x39);
+
+        // Rows.
+        x3 = bit_xor(x3, rotate_left(add(x0, x1), 7));
+        x2 = bit_xor(x2, rotate_left(add(x3, x0), 9));
+        x1 = bit_xor(x1, rotate_left(add(x2, x3), 13));
+        x0 = bit_xor(x0, rotate_left(add(x1, x2), 18));
+
+        x1 = _mm256_shuffle_epi32(x1, 0x39);
+        x2 = _mm256_shuffle_epi32(x2, 0x4e);
+        x3 = _mm256_shuffle_epi32(x3, 0x93);
+    }
+
+    block[0] = add(block[0], x0);
+    block[1] = add(block[1], x1);
+    block[2] = add(block[2], x2);
+    block[3] = add(block[3], x3);
+}
+
+// Mix the 2 * r interleaved blocks of the input, xored with those of the
+// separate regions first and second if given, to the output, the even blocks
+// to its first half and odd to its second.
+BC_TARGET("avx2")
+static void block_mix(const uint32_t* in, const uint32_t* first,
+    const uint32_t* second, uint32_t* out, size_t r)
+{
+    const auto count = 2 * r;
+    const auto last = count - 1;
+    __m256i x[block_vectors];
+
+    for (size_t row = 0; row < block_vectors; ++row)
+        x[row] = load(in + (last * block_vectors + row) * lanes * row_words);
+
+    if (first != nullptr)
+        for (size_t row = 0; row < block_vectors; ++row)
+            x[row] = bit_xor(x[row], load(
+                first + (last * block_vectors + row) * row_words,
+                second + (last * block_vectors + row) * row_words));
+
+    for (size_t block = 0; block < count; ++block)
+    {
+        for (size_t row = 0; row < block_vectors; ++row)
+            x[row] = bit_xor(x[row], load(
+                in + (block * block_vectors + row) * lanes * row_words));
+
+        if (first != nullptr)
+            for (size_t row = 0; row < block_vectors; ++row)
+                x[row] = bit_xor(x[row], load(
+                    first + (block * block_vectors + row) * row_words,
+                    second + (block * block_vectors + row) * row_words));
+
+        salsa20_8(x);
+        const auto target = block / 2 + (block % 2) * r;
+
+        for (size_t row = 0; row < block_vectors; ++row)
+            store(out + (target * block_vectors + row) * lanes * row_words,
+                x[row]);
+    }
+}
+
+// Integerify the block of the lane, the first 64 bits of its last block
+// (words 0 and 1, at diagonal positions 0 and 13).
+static inline uint64_t integerify(const uint32_t* x, size_t r, size_t lane)
+{
+    const auto last = x + (2 * r - 1) * block_vectors * lanes * row_words +
+        lane * row_words;
+    const auto high = last[3 * lanes * row_words + 1];
+    return (static_cast<uint64_t>(high) << 32) | last[0];
+}
+
+BC_TARGET("avx2")
+void scrypt_mix_avx2_2way(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch)
+{
+    const auto words = 32 * r;
+    const auto rows = words / row_words;
+    auto x = scratch;
+    auto y = scratch + lanes * words;
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        const auto source = blocks + lane * words * sizeof(uint32_t);
+        for (size_t row = 0; row < rows; ++row)
+            for (size_t word = 0; word < row_words; ++word)
+            {
+                const auto block = row / block_vectors;
+                const auto diagonal = (row % block_vectors) * row_words + word;
+                x[(row * lanes + lane) * row_words + word] = read_word(source,
+                    block * block_words + (5 * diagonal) % block_words);
+            }
+    }
+
+    const auto first = memory;
+    const auto second = memory + N * words;
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        const auto offset = index * words;
+        for (size_t row = 0; row < rows; ++row)
+            store(first + offset + row * row_words,
+                second + offset + row * row_words,
+                load(x + row * lanes * row_words));
+
+        block_mix(x, nullptr, nullptr, y, r);
+        std::swap(x, y);
+    }
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        const auto one = integerify(x, r, 0) & (N - 1);
+        const auto two = integerify(x, r, 1) & (N - 1);
+        block_mix(x, first + one * words, second + two * words, y, r);
+        std::swap(x, y);
+    }
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        const auto target = blocks + lane * words * sizeof(uint32_t);
+        for (size_t row = 0; row < rows; ++row)
+            for (size_t word = 0; word < row_words; ++word)
+            {
+                const auto block = row / block_vectors;
+                const auto diagonal = (row % block_vectors) * row_words + word;
+                write_word(target,
+                    block * block_words + (5 * diagonal) % block_words,
+                    x[(row * lanes + lane) * row_words + word]);
+            }
+    }
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/scrypt_engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t block_words = 16;
+
+// Generic kernel.
+// ----------------------------------------------------------------------------
+
+static inline uint32_t rotate_left(uint32_t value, size_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// B <- B + doubleround^4(B).
+static void salsa20_8(uint32_t* block)
+{
+    uint32_t x[block_words];
+    std::copy(block, block + block_words, x);
+
+    for (size_t round = 0; round < 8; round += 2)
+    {
+        // Columns.
+        x[ 4] ^= rotate_left(x[ 0] + x[12], 7);
+        x[ 8] ^= rotate_left(x[ 4] + x[ 0], 9);
+        x[12] ^= rotate_left(x[ 8] + x[ 4], 13);
+        x[ 0] ^= rotate_left(x[12] + x[ 8], 18);
+        x[ 9] ^= rotate_left(x[ 5] + x[ 1], 7);
+        x[13] ^= rotate_left(x[ 9] + x[ 5], 9);
+        x[ 1] ^= rotate_left(x[13] + x[ 9], 13);
+        x[ 5] ^= rotate_left(x[ 1] + x[13], 18);
+        x[14] ^= rotate_left(x[10] + x[ 6], 7);
+        x[ 2] ^= rotate_left(x[14] + x[10], 9);
+        x[ 6] ^= rotate_left(x[ 2] + x[14], 13);
+        x[10] ^= rotate_left(x[ 6] + x[ 2], 18);
+        x[ 3] ^= rotate_left(x[15] + x[11], 7);
+        x[ 7] ^= rotate_left(x[ 3] + x[15], 9);
+        x[11] ^= rotate_left(x[ 7] + x[ 3], 13);
+        x[15] ^= rotate_left(x[11] + x[ 7], 18);
+
+        // Rows.
+        x[ 1] ^= rotate_left(x[ 0] + x[ 3], 7);
+        x[ 2] ^= rotate_left(x[ 1] + x[ 0], 9);
+        x[ 3] ^= rotate_left(x[ 2] + x[ 1], 13);
+        x[ 0] ^= rotate_left(x[ 3] + x[ 2], 18);
+        x[ 6] ^= rotate_left(x[ 5] + x[ 4], 7);
+        x[ 7] ^= rotate_left(x[ 6] + x[ 5], 9);
+        x[ 4] ^= rotate_left(x[ 7] + x[ 6], 13);
+        x[ 5] ^= rotate_left(x[ 4] + x[ 7], 18);
+        x[11] ^= rotate_left(x[10] + x[ 9], 7);
+        x[ 8] ^= rotate_left(x[11] + x[10], 9);
+        x[ 9] ^= rotate_left(x[ 8] + x[11], 13);
+        x[10] ^= rotate_left(x[ 9] + x[ 8], 18);
+        x[12] ^= rotate_left(x[15] + x[14], 7);
+        x[13] ^= rotate_left(x[12] + x[15], 9);
+        x[14] ^= rotate_left(x[13] + x[12], 13);
+        x[15] ^= rotate_left(x[14] + x[13], 18);
+    }
+
+    for (size_t word = 0; word < block_words; ++word)
+        block[word] += x[word];
+}
+
+// Mix the 2 * r blocks of the input, xored with those of other if given, to
+// the output, the even blocks to its first half and odd to its second.
+static void block_mix(const uint32_t* in, const uint32_t* other,
+    uint32_t* out, size_t r)
+{
+    const auto count = 2 * r;
+    uint32_t x[block_words];
+    std::copy(in + (count - 1) * block_words, in + count * block_words, x);
+
+    if (other != nullptr)
+        for (size_t word = 0; word < block_words; ++word)
+            x[word] ^= other[(count - 1) * block_words + word];
+
+    for (size_t block = 0; block < count; ++block)
+    {
+        for (size_t word = 0; word < block_words; ++word)
+            x[word] ^= in[block * block_words + word];
+
+        if (other != nullptr)
+            for (size_t word = 0; word < block_words; ++word)
+                x[word] ^= other[block * block_words + word];
+
+        salsa20_8(x);
+        const auto target = block / 2 + (block % 2) * r;
+        std::copy(x, x + block_words, out + target * block_words);
+    }
+}
+
+void scrypt_mix_generic(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch)
+{
+    const auto words = 32 * r;
+    auto x = scratch;
+    auto y = scratch + words;
+
+    for (size_t word = 0; word < words; ++word)
+        x[word] = from_little_endian_unsafe<uint32_t>(
+            blocks + word * sizeof(uint32_t));
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        std::copy(x, x + words, memory + index * words);
+        block_mix(x, nullptr, y, r);
+        std::swap(x, y);
+    }
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        // Integerify, the first 64 bits of the last block.
+        const auto last = x + (2 * r - 1) * block_words;
+        const auto value = (static_cast<uint64_t>(last[1]) << 32) | last[0];
+        const auto other = memory + (value & (N - 1)) * words;
+        block_mix(x, other, y, r);
+        std::swap(x, y);
+    }
+
+    for (size_t word = 0; word < words; ++word)
+    {
+        const auto bytes = to_little_endian(x[word]);
+        std::copy(bytes.begin(), bytes.end(),
+            blocks + word * sizeof(uint32_t));
+    }
+}
+
+// Implementation selection.
+// ----------------------------------------------------------------------------
+
+static bool always()
+{
+    return true;
+}
+
+struct candidate
+{
+    scrypt_implementation implementation;
+    bool (*supported)();
+};
+
+// In order of preference. The avx2 kernel mixes two blocks at once.
+static const candidate candidates[] =
+{
+#ifdef BC_SHA256_X86
+    { { "avx2", scrypt_mix_sse2, 2, scrypt_mix_avx2_2way }, have_avx2 },
+    { { "sse2", scrypt_mix_sse2, 0, nullptr }, have_sse2 },
+#endif
+    { { "generic", scrypt_mix_generic, 0, nullptr }, always }
+};
+
+static std::atomic<const scrypt_implementation*> selected(nullptr);
+
+const scrypt_implementation& scrypt_selected()
+{
+    auto implementation = selected.load(std::memory_order_acquire);
+
+    if (implementation == nullptr)
+    {
+        for (const auto& candidate: candidates)
+        {
+            if (candidate.supported())
+            {
+                implementation = &candidate.implementation;
+                break;
+            }
+        }
+
+        BITCOIN_ASSERT(implementation != nullptr);
+        selected.store(implementation, std::memory_order_release);
+    }
+
+    return *implementation;
+}
+
+std::vector<std::string> scrypt_supported()
+{
+    std::vector<std::string> names;
+    for (const auto& candidate: candidates)
+        if (candidate.supported())
+            names.push_back(candidate.implementation.name);
+
+    return names;
+}
+
+bool scrypt_select(const std::string& name)
+{
+    for (const auto& candidate: candidates)
+    {
+        if (name == candidate.implementation.name && candidate.supported())
+        {
+            selected.store(&candidate.implementation,
+                std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SCRYPT_ENGINE_HPP
+#define LIBBITCOIN_SCRYPT_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../math/sha256_engine.hpp"
+
+namespace libbitcoin {
+
+/**
+ * Apply the scrypt mixing function (smix) to each of lanes blocks of 128 * r
+ * bytes, contiguous, in place. Each block is mixed with its own region of
+ * 32 * r * N words of memory, and the kernel uses 64 * r words of scratch for
+ * each block. All regions are contiguous.
+ */
+typedef void (*scrypt_mix)(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch);
+
+/**
+ * A scrypt implementation. The single block mix serves any block, and the
+ * multi-lane mix (when lanes is nonzero) serves groups of blocks.
+ */
+struct scrypt_implementation
+{
+    const char* name;
+    scrypt_mix mix;
+    size_t lanes;
+    scrypt_mix mix_lanes;
+};
+
+// Kernels, each defined only where the compiler supports the instructions.
+void scrypt_mix_generic(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch);
+
+#ifdef BC_SHA256_X86
+void scrypt_mix_sse2(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch);
+void scrypt_mix_avx2_2way(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch);
+#endif
+
+/**
+ * Runtime selection of the scrypt implementation. The best implementation
+ * supported by the processor is selected on first use.
+ */
+const scrypt_implementation& scrypt_selected();
+std::vector<std::string> scrypt_supported();
+bool scrypt_select(const std::string& name);
+
+} // namespace libbitcoin
+
+#endif
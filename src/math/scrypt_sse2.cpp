@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/scrypt_engine.hpp"
+
+#ifdef BC_SHA256_X86
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <emmintrin.h>
+
+// The words of each 64 byte block are arranged so that each of its four
+// vectors holds a diagonal of the salsa20 matrix. The column and row rounds
+// are then vector operations separated by rotations of the vectors.
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t block_words = 16;
+static BC_CONSTEXPR size_t block_vectors = 4;
+
+static inline uint32_t read_word(const uint8_t* block, size_t index)
+{
+    const auto word = block + index * sizeof(uint32_t);
+    return static_cast<uint32_t>(word[0]) |
+        (static_cast<uint32_t>(word[1]) << 8) |
+        (static_cast<uint32_t>(word[2]) << 16) |
+        (static_cast<uint32_t>(word[3]) << 24);
+}
+
+static inline void write_word(uint8_t* block, size_t index, uint32_t value)
+{
+    const auto word = block + index * sizeof(uint32_t);
+    word[0] = static_cast<uint8_t>(value);
+    word[1] = static_cast<uint8_t>(value >> 8);
+    word[2] = static_cast<uint8_t>(value >> 16);
+    word[3] = static_cast<uint8_t>(value >> 24);
+}
+
+BC_TARGET("sse2")
+static inline __m128i load(const uint32_t* words)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(words));
+}
+
+BC_TARGET("sse2")
+static inline void store(uint32_t* words, __m128i value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(words), value);
+}
+
+BC_TARGET("sse2")
+static inline __m128i add(__m128i left, __m128i right)
+{
+    return _mm_add_epi32(left, right);
+}
+
+BC_TARGET("sse2")
+static inline __m128i bit_xor(__m128i left, __m128i right)
+{
+    return _mm_xor_si128(left, right);
+}
+
+BC_TARGET("sse2")
+static inline __m128i rotate_left(__m128i value, int bits)
+{
+    return _mm_or_si128(_mm_slli_epi32(value, bits),
+        _mm_srli_epi32(value, 32 - bits));
+}
+
+// B <- B + doubleround^4(B).
+BC_TARGET("sse2")
+static inline void salsa20_8(__m128i* block)
+{
+    auto x0 = block[0];
+    auto x1 = block[1];
+    auto x2 = block[2];
+    auto x3 = block[3];
+
+    for (size_t round = 0; round < 8; round += 2)
+    {
+        // Columns.
+        x1 = bit_xor(x1, rotate_left(add(x0, x3), 7));
+        x2 = bit_xor(x2, rotate_left(add(x1, x0), 9));
+        x3 = bit_xor(x3, rotate_left(add(x2, x1), 13));
+        x0 = bit_xor(x0, rotate_left(add(x3, x2), 18));
+
+        x1 = _mm_shuffle_epi32(x1, 0x93);
+        x2 = _mm_shuffle_epi32(x2, 0x4e);
+        x3 = _mm_shuffle_epi32(x3, 0x39);
+
+        // Rows.
+        x3 = bit_xor(x3, rotate_left(add(x0, x1), 7));
+        x2 = bit_xor(x2, rotate_left(add(x3, x0), 9));
+        x1 = bit_xor(x1, rotate_left(add(x2, x3), 13));
+        x0 = bit_xor(x0, rotate_left(add(x1, x2), 18));
+
+        x1 = _mm_shuffle_epi32(x1, 0x39);
+        x2 = _mm_shuffle_epi32(x2, 0x4e);
+        x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+
+    block[0] = add(block[0], x0);
+    block[1] = add(block[1], x1);
+    block[2] = add(block[2], x2);
+    block[3] = add(block[3], x3);
+}
+
+// Mix the 2 * r blocks of the input, xored with those of other if given, to
+// the output, the even blocks to its first half and odd to its second.
+BC_TARGET("sse2")
+static void block_mix(const uint32_t* in, const uint32_t* other,
+    uint32_t* out, size_t r)
+{
+    const auto count = 2 * r;
+    const auto last = (count - 1) * block_words;
+    __m128i x[block_vectors];
+
+    for (size_t row = 0; row < block_vectors; ++row)
+        x[row] = load(in + last + row * 4);
+
+    if (other != nullptr)
+        for (size_t row = 0; row < block_vectors; ++row)
+            x[row] = bit_xor(x[row], load(other + last + row * 4));
+
+    for (size_t block = 0; block < count; ++block)
+    {
+        const auto offset = block * block_words;
+
+        for (size_t row = 0; row < block_vectors; ++row)
+            x[row] = bit_xor(x[row], load(in + offset + row * 4));
+
+        if (other != nullptr)
+            for (size_t row = 0; row < block_vectors; ++row)
+                x[row] = bit_xor(x[row], load(other + offset + row * 4));
+
+        salsa20_8(x);
+        const auto target = (block / 2 + (block % 2) * r) * block_words;
+
+        for (size_t row = 0; row < block_vectors; ++row)
+            store(out + target + row * 4, x[row]);
+    }
+}
+
+BC_TARGET("sse2")
+void scrypt_mix_sse2(uint8_t* blocks, size_t r, uint64_t N,
+    uint32_t* memory, uint32_t* scratch)
+{
+    const auto words = 32 * r;
+    auto x = scratch;
+    auto y = scratch + words;
+
+    for (size_t block = 0; block < 2 * r; ++block)
+        for (size_t word = 0; word < block_words; ++word)
+            x[block * block_words + word] = read_word(blocks,
+                block * block_words + (5 * word) % block_words);
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        const auto target = memory + index * words;
+        for (size_t word = 0; word < words; word += 4)
+            store(target + word, load(x + word));
+
+        block_mix(x, nullptr, y, r);
+        std::swap(x, y);
+    }
+
+    for (uint64_t index = 0; index < N; ++index)
+    {
+        // Integerify, the first 64 bits of the last block (words 0 and 1).
+        const auto last = x + (2 * r - 1) * block_words;
+        const auto value = (static_cast<uint64_t>(last[13]) << 32) | last[0];
+        block_mix(x, memory + (value & (N - 1)) * words, y, r);
+        std::swap(x, y);
+    }
+
+    for (size_t block = 0; block < 2 * r; ++block)
+        for (size_t word = 0; word < block_words; ++word)
+            write_word(blocks, block * block_words + (5 * word) % block_words,
+                x[block * block_words + word]);
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -19,8 +19,14 @@
  */
 #include <bitcoin/bitcoin/math/secp256k1_initializer.hpp>
 
+#include <cstddef>
 #include <mutex>
 #include <secp256k1.h>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
 
 namespace libbitcoin {
 
@@ -28,31 +34,119 @@ namespace libbitcoin {
 secp256k1_signing signing;
 secp256k1_verification verification;
 
-// Static helper for use with std::call_once.
-void secp256k1_initializer::set_context(secp256k1_context** context,
-    int flags)
+// Per-thread signing contexts are re-randomized after this many uses.
+static constexpr size_t default_randomize_interval = 1024;
+
+// The context clone of a thread and the number of uses since randomization.
+struct secp256k1_initializer::local
 {
-    *context = secp256k1_context_create(flags);
-}
+    secp256k1_context* context;
+    size_t uses;
+};
 
 // Protected base class constructor (must be derived).
 secp256k1_initializer::secp256k1_initializer(int flags)
-    : flags_(flags), context_(nullptr)
+    : flags_(flags), context_(nullptr), per_thread_(false),
+      randomize_interval_(default_randomize_interval), locals_(release)
 {
 }
 
-// Clean up the context on destruct.
+// Clean up the context on destruct. Other threads release their clones on
+// exit, the calling thread releases its own with the thread specific pointer.
 secp256k1_initializer::~secp256k1_initializer()
 {
+    locals_.reset();
+
     if (context_ != nullptr)
         secp256k1_context_destroy(context_);
 }
 
+void secp256k1_initializer::release(local* instance)
+{
+    secp256k1_context_destroy(instance->context);
+    delete instance;
+}
+
 // Get the curve context and initialize on first use.
 secp256k1_context* secp256k1_initializer::context()
 {
-    std::call_once(mutex_, set_context, &context_, flags_);
-    return context_;
+    initialize();
+    return per_thread_ ? local_context() : context_;
+}
+
+void secp256k1_initializer::initialize()
+{
+    std::call_once(mutex_, &secp256k1_initializer::create, this);
+}
+
+void secp256k1_initializer::set_per_thread(bool enabled)
+{
+    per_thread_ = enabled;
+}
+
+void secp256k1_initializer::set_randomize_interval(size_t uses)
+{
+    randomize_interval_ = uses;
+}
+
+const secp256k1_initializer::statistics&
+    secp256k1_initializer::metrics() const
+{
+    return statistics_;
+}
+
+// The shared context is randomized only here, before it is published, as
+// randomization would race signing on other threads.
+void secp256k1_initializer::create()
+{
+    const auto start = histogram::clock::now();
+    context_ = secp256k1_context_create(flags_);
+    statistics_.create.record(start);
+    randomize(context_);
+}
+
+// Only signing uses blinding, so verification contexts are not randomized.
+void secp256k1_initializer::randomize(secp256k1_context* context)
+{
+    if ((flags_ & SECP256K1_CONTEXT_SIGN) == 0)
+        return;
+
+    data_chunk seed(hash_size);
+    pseudo_random_fill(seed);
+
+    const auto start = histogram::clock::now();
+    const auto result = secp256k1_context_randomize(context, seed.data());
+    statistics_.randomize.record(start);
+
+    BITCOIN_ASSERT_MSG(result == 1, "secp256k1_context_randomize failed");
+}
+
+// Cloning copies the precomputed tables rather than generating them.
+secp256k1_context* secp256k1_initializer::local_context()
+{
+    auto instance = locals_.get();
+
+    if (instance == nullptr)
+    {
+        const auto start = histogram::clock::now();
+        const auto clone = secp256k1_context_clone(context_);
+        statistics_.clone.record(start);
+        randomize(clone);
+
+        instance = new local{ clone, 0 };
+        locals_.reset(instance);
+        return clone;
+    }
+
+    const size_t interval = randomize_interval_;
+
+    if (interval != 0 && ++instance->uses >= interval)
+    {
+        instance->uses = 0;
+        randomize(instance->context);
+    }
+
+    return instance->context;
 }
 
 // Concrete type for signing init.
@@ -67,5 +161,12 @@ secp256k1_verification::secp256k1_verification()
 {
 }
 
-} // namespace libbitcoin
+void initialize_secp256k1(bool per_thread)
+{
+    signing.set_per_thread(per_thread);
+    verification.set_per_thread(per_thread);
+    signing.initialize();
+    verification.initialize();
+}
 
+} // namespace libbitcoin
@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha256_engine.hpp"
+
+#ifdef BC_SHA256_X86
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// Eight messages are transformed at once, one in each 32 bit element of the
+// 256 bit avx2 registers.
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t lanes = 8;
+static BC_CONSTEXPR size_t state_size = 8;
+
+BC_TARGET("avx2")
+static inline __m256i add(__m256i left, __m256i right)
+{
+    return _mm256_add_epi32(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_xor(__m256i left, __m256i right)
+{
+    return _mm256_xor_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_and(__m256i left, __m256i right)
+{
+    return _mm256_and_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_or(__m256i left, __m256i right)
+{
+    return _mm256_or_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i shift_right(__m256i value, int bits)
+{
+    return _mm256_srli_epi32(value, bits);
+}
+
+BC_TARGET("avx2")
+static inline __m256i rotate_right(__m256i value, int bits)
+{
+    return bit_or(_mm256_srli_epi32(value, bits),
+        _mm256_slli_epi32(value, 32 - bits));
+}
+
+BC_TARGET("avx2")
+static inline __m256i big_sigma0(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 2), rotate_right(value, 13)),
+        rotate_right(value, 22));
+}
+
+BC_TARGET("avx2")
+static inline __m256i big_sigma1(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 6), rotate_right(value, 11)),
+        rotate_right(value, 25));
+}
+
+BC_TARGET("avx2")
+static inline __m256i sigma0(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 7), rotate_right(value, 18)),
+        shift_right(value, 3));
+}
+
+BC_TARGET("avx2")
+static inline __m256i sigma1(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 17), rotate_right(value, 19)),
+        shift_right(value, 10));
+}
+
+BC_TARGET("avx2")
+static inline __m256i choose(__m256i x, __m256i y, __m256i z)
+{
+    return bit_xor(z, bit_and(x, bit_xor(y, z)));
+}
+
+BC_TARGET("avx2")
+static inline __m256i majority(__m256i x, __m256i y, __m256i z)
+{
+    return bit_or(bit_and(x, y), bit_and(z, bit_or(x, y)));
+}
+
+// Reverse the bytes of each 32 bit element (big endian message words).
+BC_TARGET("avx2")
+static inline __m256i byte_swap(__m256i value)
+{
+    const auto mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(value, mask);
+}
+
+// Transpose the 8x8 matrix of 32 bit elements, so that rows of eight words
+// from each lane become one word from each lane (lane zero in the lowest
+// element), and back.
+BC_TARGET("avx2")
+static inline void transpose(__m256i rows[lanes])
+{
+    const auto t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    const auto t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    const auto t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    const auto t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    const auto t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+    const auto t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+    const auto t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+    const auto t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+    const auto u0 = _mm256_unpacklo_epi64(t0, t2);
+    const auto u1 = _mm256_unpackhi_epi64(t0, t2);
+    const auto u2 = _mm256_unpacklo_epi64(t1, t3);
+    const auto u3 = _mm256_unpackhi_epi64(t1, t3);
+    const auto u4 = _mm256_unpacklo_epi64(t4, t6);
+    const auto u5 = _mm256_unpackhi_epi64(t4, t6);
+    const auto u6 = _mm256_unpacklo_epi64(t5, t7);
+    const auto u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    rows[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    rows[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    rows[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    rows[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    rows[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    rows[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    rows[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    rows[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+BC_TARGET("avx2")
+static inline __m256i load(const void* data)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i*>(data));
+}
+
+BC_TARGET("avx2")
+static inline void store(void* data, __m256i value)
+{
+    _mm256_storeu_si256(static_cast<__m256i*>(data), value);
+}
+
+BC_TARGET("avx2")
+void sha256_transform_avx2_8way(uint32_t* states, const uint8_t* const* blocks)
+{
+    // Each half of the block is eight words from each of the eight lanes.
+    __m256i schedule[16];
+    for (size_t half = 0; half < 2; ++half)
+    {
+        const auto rows = &schedule[half * lanes];
+        for (size_t lane = 0; lane < lanes; ++lane)
+            rows[lane] = byte_swap(load(blocks[lane] + half * 32));
+
+        transpose(rows);
+    }
+
+    __m256i state[state_size];
+    for (size_t lane = 0; lane < lanes; ++lane)
+        state[lane] = load(&states[lane * state_size]);
+
+    transpose(state);
+
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+
+    for (size_t round = 0; round < 64; ++round)
+    {
+        auto& word = schedule[round % 16];
+
+        if (round >= 16)
+            word = add(add(word, sigma0(schedule[(round + 1) % 16])),
+                add(schedule[(round + 9) % 16],
+                    sigma1(schedule[(round + 14) % 16])));
+
+        const auto constant = _mm256_set1_epi32(
+            static_cast<int>(sha256_round_constants[round]));
+        const auto t1 = add(add(h, big_sigma1(e)),
+            add(choose(e, f, g), add(constant, word)));
+        const auto t2 = add(big_sigma0(a), majority(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+    state[4] = add(state[4], e);
+    state[5] = add(state[5], f);
+    state[6] = add(state[6], g);
+    state[7] = add(state[7], h);
+
+    transpose(state);
+    for (size_t lane = 0; lane < lanes; ++lane)
+        store(&states[lane * state_size], state[lane]);
+}
+
+} // namespace libbitcoin
+
+#endif
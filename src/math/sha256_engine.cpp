@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha256_engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/sha256.h"
+
+#ifdef BC_SHA256_X86
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t block_size = 64;
+static BC_CONSTEXPR size_t state_size = 8;
+static BC_CONSTEXPR size_t max_lanes = 8;
+
+const uint32_t sha256_round_constants[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+const uint32_t sha256_initial_state[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+void sha256_transform_generic(uint32_t* state, const uint8_t* blocks,
+    size_t count)
+{
+    for (; count > 0; --count, blocks += block_size)
+        SHA256Transform(state, blocks);
+}
+
+// Processor feature detection.
+// ----------------------------------------------------------------------------
+
+struct processor_features
+{
+    bool sse2;
+    bool sse41;
+    bool avx2;
+    bool shani;
+};
+
+#ifdef BC_SHA256_X86
+
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (size_t index = 0; index < 4; ++index)
+        registers[index] = static_cast<uint32_t>(info[index]);
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2],
+        registers[3]);
+#endif
+}
+
+// The extended state enabled by the operating system (ymm requires 0x06).
+static uint64_t xgetbv()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t low;
+    uint32_t high;
+    __asm__ volatile ("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+
+static bool bit(uint32_t value, size_t position)
+{
+    return ((value >> position) & 1) != 0;
+}
+
+static processor_features detect_features()
+{
+    processor_features features{ false, false, false, false };
+
+    uint32_t registers[4];
+    cpuid(0, 0, registers);
+    const auto max_leaf = registers[0];
+
+    if (max_leaf < 1)
+        return features;
+
+    cpuid(1, 0, registers);
+    const auto sse2 = bit(registers[3], 26);
+    const auto ssse3 = bit(registers[2], 9);
+    const auto sse41 = bit(registers[2], 19);
+    const auto osxsave = bit(registers[2], 27);
+    const auto avx = bit(registers[2], 28);
+    features.sse2 = sse2;
+    features.sse41 = ssse3 && sse41;
+
+    if (max_leaf < 7)
+        return features;
+
+    cpuid(7, 0, registers);
+    const auto avx2 = bit(registers[1], 5);
+    const auto sha = bit(registers[1], 29);
+    const auto ymm = osxsave && avx && (xgetbv() & 0x06) == 0x06;
+    features.avx2 = avx2 && ymm;
+    features.shani = sha && features.sse41;
+    return features;
+}
+
+#else
+
+static processor_features detect_features()
+{
+    return{ false, false, false, false };
+}
+
+#endif
+
+static const processor_features& features()
+{
+    static const auto features = detect_features();
+    return features;
+}
+
+// Implementation selection.
+// ----------------------------------------------------------------------------
+
+static bool always()
+{
+    return true;
+}
+
+#ifdef BC_SHA256_X86
+
+bool have_sse2()
+{
+    return features().sse2;
+}
+
+static bool have_sse41()
+{
+    return features().sse41;
+}
+
+bool have_avx2()
+{
+    return features().avx2;
+}
+
+#endif
+
+#ifdef BC_SHA256_SHANI
+
+static bool have_shani()
+{
+    return features().shani;
+}
+
+#endif
+
+struct candidate
+{
+    sha256_implementation implementation;
+    bool (*supported)();
+};
+
+// In order of preference. A single sha-ni stream outpaces the vector lanes.
+static const candidate candidates[] =
+{
+#ifdef BC_SHA256_SHANI
+    { { "shani", sha256_transform_shani, 0, nullptr }, have_shani },
+#endif
+#ifdef BC_SHA256_X86
+    { { "avx2", sha256_transform_generic, 8, sha256_transform_avx2_8way },
+        have_avx2 },
+    { { "sse41", sha256_transform_generic, 4, sha256_transform_sse41_4way },
+        have_sse41 },
+#endif
+    { { "generic", sha256_transform_generic, 0, nullptr }, always }
+};
+
+static std::atomic<const sha256_implementation*> selected(nullptr);
+
+const sha256_implementation& sha256_selected()
+{
+    auto implementation = selected.load(std::memory_order_acquire);
+
+    if (implementation == nullptr)
+    {
+        for (const auto& candidate: candidates)
+        {
+            if (candidate.supported())
+            {
+                implementation = &candidate.implementation;
+                break;
+            }
+        }
+
+        BITCOIN_ASSERT(implementation != nullptr);
+        selected.store(implementation, std::memory_order_release);
+    }
+
+    return *implementation;
+}
+
+std::vector<std::string> sha256_supported()
+{
+    std::vector<std::string> names;
+    for (const auto& candidate: candidates)
+        if (candidate.supported())
+            names.push_back(candidate.implementation.name);
+
+    return names;
+}
+
+bool sha256_select(const std::string& name)
+{
+    for (const auto& candidate: candidates)
+    {
+        if (name == candidate.implementation.name && candidate.supported())
+        {
+            selected.store(&candidate.implementation,
+                std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Hashing.
+// ----------------------------------------------------------------------------
+
+static void initialize(uint32_t* state)
+{
+    std::copy(sha256_initial_state, sha256_initial_state + state_size,
+        state);
+}
+
+static void store(uint8_t* digest, const uint32_t* state)
+{
+    for (size_t word = 0; word < state_size; ++word)
+    {
+        const auto bytes = to_big_endian(state[word]);
+        std::copy(bytes.begin(), bytes.end(), digest + word * sizeof(uint32_t));
+    }
+}
+
+// Write the final partial block of a message, with its terminator and bit
+// length, to tail (128 bytes) and return the number of blocks written.
+static size_t pad(uint8_t* tail, const uint8_t* rest, size_t rest_size,
+    uint64_t message_size)
+{
+    BITCOIN_ASSERT(rest_size < block_size);
+    size_t blocks = 1;
+    if (rest_size >= block_size - sizeof(uint64_t))
+        blocks = 2;
+
+    const auto end = tail + blocks * block_size;
+    const auto bits = to_big_endian<uint64_t>(message_size * 8);
+
+    std::copy(rest, rest + rest_size, tail);
+    tail[rest_size] = 0x80;
+    std::fill(tail + rest_size + 1, end - bits.size(), 0x00);
+    std::copy(bits.begin(), bits.end(), end - bits.size());
+    return blocks;
+}
+
+void sha256_single(const uint8_t* data, size_t size, uint8_t* digest)
+{
+    const auto& implementation = sha256_selected();
+
+    uint32_t state[state_size];
+    initialize(state);
+
+    const auto blocks = size / block_size;
+    implementation.transform(state, data, blocks);
+
+    uint8_t tail[2 * block_size];
+    const auto rest = data + blocks * block_size;
+    const auto count = pad(tail, rest, size % block_size, size);
+    implementation.transform(state, tail, count);
+    store(digest, state);
+}
+
+// A message in progress on one lane of a multi-lane transform. Whole blocks
+// are read from the message itself and the padded remainder from the tail.
+struct lane
+{
+    bool active;
+    size_t item;
+    const uint8_t* data;
+    size_t blocks;
+    size_t tail_blocks;
+    size_t tail_position;
+    uint8_t tail[2 * block_size];
+};
+
+// Hash count items (item(index) returns a data_slice) into out. The message
+// of each item is fully read (its tail copied) when the lane is loaded and
+// its digest is written only when it completes, so out may overlay items.
+template <typename Item>
+static void hash_lanes(const sha256_implementation& implementation,
+    Item item, size_t count, hash_digest* out)
+{
+    static const uint8_t idle[block_size] = { 0 };
+    const auto lanes = implementation.lanes;
+    BITCOIN_ASSERT(lanes > 0 && lanes <= max_lanes);
+
+    uint32_t states[max_lanes * state_size];
+    const uint8_t* blocks[max_lanes];
+    lane lane_states[max_lanes];
+    size_t next = 0;
+    size_t active = 0;
+
+    const auto load = [&](size_t index)
+    {
+        auto& lane = lane_states[index];
+        lane.active = next < count;
+
+        if (!lane.active)
+            return;
+
+        const data_slice message = item(next);
+        const auto whole = message.size() / block_size;
+        const auto rest = message.data() + whole * block_size;
+        lane.item = next++;
+        lane.data = message.data();
+        lane.blocks = whole;
+        lane.tail_position = 0;
+        lane.tail_blocks = pad(lane.tail, rest,
+            message.size() % block_size, message.size());
+        initialize(&states[index * state_size]);
+        ++active;
+    };
+
+    for (size_t index = 0; index < lanes; ++index)
+        load(index);
+
+    while (active > 0)
+    {
+        for (size_t index = 0; index < lanes; ++index)
+        {
+            const auto& lane = lane_states[index];
+
+            if (!lane.active)
+                blocks[index] = idle;
+            else if (lane.blocks > 0)
+                blocks[index] = lane.data;
+            else
+                blocks[index] = &lane.tail[lane.tail_position * block_size];
+        }
+
+        implementation.transform_lanes(states, blocks);
+
+        for (size_t index = 0; index < lanes; ++index)
+        {
+            auto& lane = lane_states[index];
+
+            if (!lane.active)
+                continue;
+
+            if (lane.blocks > 0)
+            {
+                lane.data += block_size;
+                --lane.blocks;
+                continue;
+            }
+
+            if (++lane.tail_position < lane.tail_blocks)
+                continue;
+
+            store(out[lane.item].data(), &states[index * state_size]);
+            --active;
+            load(index);
+        }
+    }
+}
+
+void sha256_double_many(const data_slice* items, size_t count,
+    hash_digest* out)
+{
+    const auto& implementation = sha256_selected();
+
+    if (implementation.lanes == 0)
+    {
+        hash_digest first;
+        for (size_t index = 0; index < count; ++index)
+        {
+            const auto& item = items[index];
+            sha256_single(item.data(), item.size(), first.data());
+            sha256_single(first.data(), first.size(), out[index].data());
+        }
+
+        return;
+    }
+
+    const auto message = [items](size_t index)
+    {
+        return items[index];
+    };
+
+    const auto digest = [out](size_t index)
+    {
+        return data_slice(out[index]);
+    };
+
+    hash_lanes(implementation, message, count, out);
+    hash_lanes(implementation, digest, count, out);
+}
+
+void sha256_double_pairs(hash_digest* out, const hash_digest* in,
+    size_t count)
+{
+    const auto& implementation = sha256_selected();
+
+    if (implementation.lanes > 0)
+    {
+        const auto pair = [in](size_t index)
+        {
+            const auto begin = in[2 * index].data();
+            return data_slice(begin, begin + 2 * hash_size);
+        };
+
+        const auto digest = [out](size_t index)
+        {
+            return data_slice(out[index]);
+        };
+
+        hash_lanes(implementation, pair, count, out);
+        hash_lanes(implementation, digest, count, out);
+        return;
+    }
+
+    // The padding blocks of the 64 and 32 byte messages are precomputed.
+    static const uint8_t terminator = 0x80;
+    uint8_t padding[block_size] = { terminator };
+    padding[block_size - 2] = 0x02;
+
+    uint8_t second[block_size] = { 0 };
+    second[hash_size] = terminator;
+    second[block_size - 2] = 0x01;
+
+    uint32_t state[state_size];
+    for (size_t index = 0; index < count; ++index)
+    {
+        initialize(state);
+        implementation.transform(state, in[2 * index].data(), 1);
+        implementation.transform(state, padding, 1);
+        store(second, state);
+
+        initialize(state);
+        implementation.transform(state, second, 1);
+        store(out[index].data(), state);
+    }
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA256_ENGINE_HPP
+#define LIBBITCOIN_SHA256_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+    #define BC_SHA256_X86
+#endif
+
+// SHA-NI intrinsics require gcc 4.9 or later (any clang or msvc 2015).
+#if defined(BC_SHA256_X86) && (defined(__clang__) || defined(_MSC_VER) || \
+    (defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409))
+    #define BC_SHA256_SHANI
+#endif
+
+// Kernels are compiled for their instruction set individually, so that the
+// library as a whole does not require it and selection is made at runtime.
+#if defined(__GNUC__) || defined(__clang__)
+    #define BC_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define BC_TARGET(isa)
+#endif
+
+namespace libbitcoin {
+
+/// Transform the state by each of count consecutive 64 byte blocks.
+typedef void (*sha256_transform)(uint32_t* state, const uint8_t* blocks,
+    size_t count);
+
+/// Transform each of lanes states (8 words each, contiguous) by one block.
+typedef void (*sha256_transform_lanes)(uint32_t* states,
+    const uint8_t* const* blocks);
+
+/**
+ * A sha256 implementation. Single stream transforms serve all hashing, and
+ * multi-lane transforms (when lanes is nonzero) serve batches of messages.
+ */
+struct sha256_implementation
+{
+    const char* name;
+    sha256_transform transform;
+    size_t lanes;
+    sha256_transform_lanes transform_lanes;
+};
+
+/// The sha256 round constants (fips 180-4, section 4.2.2).
+extern const uint32_t sha256_round_constants[64];
+
+/// The sha256 initialization vector (fips 180-4, section 5.3.3).
+extern const uint32_t sha256_initial_state[8];
+
+// Kernels, each defined only where the compiler supports the instructions.
+void sha256_transform_generic(uint32_t* state, const uint8_t* blocks,
+    size_t count);
+
+#ifdef BC_SHA256_X86
+void sha256_transform_sse41_4way(uint32_t* states,
+    const uint8_t* const* blocks);
+void sha256_transform_avx2_8way(uint32_t* states,
+    const uint8_t* const* blocks);
+#endif
+
+#ifdef BC_SHA256_SHANI
+void sha256_transform_shani(uint32_t* state, const uint8_t* blocks,
+    size_t count);
+#endif
+
+/**
+ * Runtime selection of the sha256 implementation. The best implementation
+ * supported by the processor is selected on first use.
+ */
+const sha256_implementation& sha256_selected();
+std::vector<std::string> sha256_supported();
+bool sha256_select(const std::string& name);
+
+#ifdef BC_SHA256_X86
+/// True if the processor (and for avx2 the operating system) supports the
+/// instructions. These serve the selection of other x86 kernels.
+bool have_sse2();
+bool have_avx2();
+#endif
+
+/// sha256 of a single message.
+void sha256_single(const uint8_t* data, size_t size, uint8_t* digest);
+
+/// sha256(sha256(item)) of each of count items, using the lanes if any.
+void sha256_double_many(const data_slice* items, size_t count,
+    hash_digest* out);
+
+/// sha256(sha256(left + right)) of each of count consecutive pairs of hashes.
+/// The output may be the same as the input.
+void sha256_double_pairs(hash_digest* out, const hash_digest* in,
+    size_t count);
+
+} // namespace libbitcoin
+
+#endif
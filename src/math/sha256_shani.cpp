@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha256_engine.hpp"
+
+#ifdef BC_SHA256_SHANI
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// A single message is transformed using the sha extensions, which perform two
+// rounds per sha256rnds2 with the state held as (a, b, e, f) and (c, d, g, h).
+
+namespace libbitcoin {
+
+#define BC_SHANI_TARGET BC_TARGET("sha,sse4.1")
+
+// Four rounds, updating the state with the scheduled message words.
+BC_SHANI_TARGET
+static inline void quad_round(__m128i& abef, __m128i& cdgh, __m128i message,
+    size_t round)
+{
+    const auto constants = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+        &sha256_round_constants[round]));
+    const auto words = _mm_add_epi32(message, constants);
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(words, 0x0e));
+}
+
+// The next four message words, from the preceding sixteen.
+BC_SHANI_TARGET
+static inline __m128i schedule(__m128i first, __m128i second, __m128i third,
+    __m128i fourth)
+{
+    const auto partial = _mm_sha256msg1_epu32(first, second);
+    const auto sum = _mm_add_epi32(partial,
+        _mm_alignr_epi8(fourth, third, 4));
+    return _mm_sha256msg2_epu32(sum, fourth);
+}
+
+BC_SHANI_TARGET
+void sha256_transform_shani(uint32_t* state, const uint8_t* blocks,
+    size_t count)
+{
+    const auto byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bull,
+        0x0405060700010203ull);
+
+    // Reorder the state (a, b, c, d), (e, f, g, h) as (a, b, e, f) and
+    // (c, d, g, h), each in reverse element order.
+    auto dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    auto hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    const auto cdab = _mm_shuffle_epi32(dcba, 0xb1);
+    const auto efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+    auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+    for (; count > 0; --count, blocks += 64)
+    {
+        const auto saved_abef = abef;
+        const auto saved_cdgh = cdgh;
+        const auto block = reinterpret_cast<const __m128i*>(blocks);
+
+        auto message0 = _mm_shuffle_epi8(_mm_loadu_si128(block + 0),
+            byte_swap);
+        auto message1 = _mm_shuffle_epi8(_mm_loadu_si128(block + 1),
+            byte_swap);
+        auto message2 = _mm_shuffle_epi8(_mm_loadu_si128(block + 2),
+            byte_swap);
+        auto message3 = _mm_shuffle_epi8(_mm_loadu_si128(block + 3),
+            byte_swap);
+
+        for (size_t round = 0; round < 64; round += 16)
+        {
+            const auto last = round == 48;
+
+            quad_round(abef, cdgh, message0, round);
+            if (!last)
+                message0 = schedule(message0, message1, message2, message3);
+
+            quad_round(abef, cdgh, message1, round + 4);
+            if (!last)
+                message1 = schedule(message1, message2, message3, message0);
+
+            quad_round(abef, cdgh, message2, round + 8);
+            if (!last)
+                message2 = schedule(message2, message3, message0, message1);
+
+            quad_round(abef, cdgh, message3, round + 12);
+            if (!last)
+                message3 = schedule(message3, message0, message1, message2);
+        }
+
+        abef = _mm_add_epi32(abef, saved_abef);
+        cdgh = _mm_add_epi32(cdgh, saved_cdgh);
+    }
+
+    // Restore the state order.
+    const auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    const auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    dcba = _mm_blend_epi16(feba, dchg, 0xf0);
+    hgfe = _mm_alignr_epi8(dchg, feba, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), dcba);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), hgfe);
+}
+
+#undef BC_SHANI_TARGET
+
+} // namespace libbitcoin
+
+#endif
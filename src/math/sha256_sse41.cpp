@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha256_engine.hpp"
+
+#ifdef BC_SHA256_X86
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// Four messages are transformed at once, one in each 32 bit element of the
+// 128 bit sse registers.
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t lanes = 4;
+static BC_CONSTEXPR size_t state_size = 8;
+
+static inline uint32_t read_word(const uint8_t* block, size_t index)
+{
+    const auto word = block + index * sizeof(uint32_t);
+    return (static_cast<uint32_t>(word[0]) << 24) |
+        (static_cast<uint32_t>(word[1]) << 16) |
+        (static_cast<uint32_t>(word[2]) << 8) |
+        static_cast<uint32_t>(word[3]);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i add(__m128i left, __m128i right)
+{
+    return _mm_add_epi32(left, right);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i bit_xor(__m128i left, __m128i right)
+{
+    return _mm_xor_si128(left, right);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i bit_and(__m128i left, __m128i right)
+{
+    return _mm_and_si128(left, right);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i bit_or(__m128i left, __m128i right)
+{
+    return _mm_or_si128(left, right);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i shift_right(__m128i value, int bits)
+{
+    return _mm_srli_epi32(value, bits);
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i rotate_right(__m128i value, int bits)
+{
+    return bit_or(_mm_srli_epi32(value, bits),
+        _mm_slli_epi32(value, 32 - bits));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i big_sigma0(__m128i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 2), rotate_right(value, 13)),
+        rotate_right(value, 22));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i big_sigma1(__m128i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 6), rotate_right(value, 11)),
+        rotate_right(value, 25));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i sigma0(__m128i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 7), rotate_right(value, 18)),
+        shift_right(value, 3));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i sigma1(__m128i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 17), rotate_right(value, 19)),
+        shift_right(value, 10));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i choose(__m128i x, __m128i y, __m128i z)
+{
+    return bit_xor(z, bit_and(x, bit_xor(y, z)));
+}
+
+BC_TARGET("sse4.1")
+static inline __m128i majority(__m128i x, __m128i y, __m128i z)
+{
+    return bit_or(bit_and(x, y), bit_and(z, bit_or(x, y)));
+}
+
+// Gather a word from each lane (lane zero in the lowest element).
+BC_TARGET("sse4.1")
+static inline __m128i gather(const uint32_t* words, size_t stride)
+{
+    return _mm_set_epi32(
+        static_cast<int>(words[3 * stride]),
+        static_cast<int>(words[2 * stride]),
+        static_cast<int>(words[1 * stride]),
+        static_cast<int>(words[0 * stride]));
+}
+
+BC_TARGET("sse4.1")
+void sha256_transform_sse41_4way(uint32_t* states, const uint8_t* const* blocks)
+{
+    uint32_t words[lanes * 16];
+    for (size_t lane = 0; lane < lanes; ++lane)
+        for (size_t index = 0; index < 16; ++index)
+            words[lane * 16 + index] = read_word(blocks[lane], index);
+
+    __m128i schedule[16];
+    for (size_t index = 0; index < 16; ++index)
+        schedule[index] = gather(&words[index], 16);
+
+    __m128i state[state_size];
+    for (size_t index = 0; index < state_size; ++index)
+        state[index] = gather(&states[index], state_size);
+
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+
+    for (size_t round = 0; round < 64; ++round)
+    {
+        auto& word = schedule[round % 16];
+
+        if (round >= 16)
+            word = add(add(word, sigma0(schedule[(round + 1) % 16])),
+                add(schedule[(round + 9) % 16],
+                    sigma1(schedule[(round + 14) % 16])));
+
+        const auto constant = _mm_set1_epi32(
+            static_cast<int>(sha256_round_constants[round]));
+        const auto t1 = add(add(h, big_sigma1(e)),
+            add(choose(e, f, g), add(constant, word)));
+        const auto t2 = add(big_sigma0(a), majority(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+    state[4] = add(state[4], e);
+    state[5] = add(state[5], f);
+    state[6] = add(state[6], g);
+    state[7] = add(state[7], h);
+
+    uint32_t lane_words[lanes];
+    for (size_t index = 0; index < state_size; ++index)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_words), state[index]);
+        for (size_t lane = 0; lane < lanes; ++lane)
+            states[lane * state_size + index] = lane_words[lane];
+    }
+}
+
+} // namespace libbitcoin
+
+#endif
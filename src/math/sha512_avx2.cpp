@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha512_engine.hpp"
+
+#ifdef BC_SHA256_X86
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// Four messages are transformed at once, one in each 64 bit element of the
+// 256 bit avx2 registers.
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t lanes = 4;
+static BC_CONSTEXPR size_t state_size = 8;
+
+static inline uint64_t read_word(const uint8_t* block, size_t index)
+{
+    const auto word = block + index * sizeof(uint64_t);
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        value = (value << 8) | word[byte];
+
+    return value;
+}
+
+BC_TARGET("avx2")
+static inline __m256i add(__m256i left, __m256i right)
+{
+    return _mm256_add_epi64(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_xor(__m256i left, __m256i right)
+{
+    return _mm256_xor_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_and(__m256i left, __m256i right)
+{
+    return _mm256_and_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i bit_or(__m256i left, __m256i right)
+{
+    return _mm256_or_si256(left, right);
+}
+
+BC_TARGET("avx2")
+static inline __m256i shift_right(__m256i value, int bits)
+{
+    return _mm256_srli_epi64(value, bits);
+}
+
+BC_TARGET("avx2")
+static inline __m256i rotate_right(__m256i value, int bits)
+{
+    return bit_or(_mm256_srli_epi64(value, bits),
+        _mm256_slli_epi64(value, 64 - bits));
+}
+
+BC_TARGET("avx2")
+static inline __m256i big_sigma0(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 28), rotate_right(value, 34)),
+        rotate_right(value, 39));
+}
+
+BC_TARGET("avx2")
+static inline __m256i big_sigma1(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 14), rotate_right(value, 18)),
+        rotate_right(value, 41));
+}
+
+BC_TARGET("avx2")
+static inline __m256i sigma0(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 1), rotate_right(value, 8)),
+        shift_right(value, 7));
+}
+
+BC_TARGET("avx2")
+static inline __m256i sigma1(__m256i value)
+{
+    return bit_xor(bit_xor(rotate_right(value, 19), rotate_right(value, 61)),
+        shift_right(value, 6));
+}
+
+BC_TARGET("avx2")
+static inline __m256i choose(__m256i x, __m256i y, __m256i z)
+{
+    return bit_xor(z, bit_and(x, bit_xor(y, z)));
+}
+
+BC_TARGET("avx2")
+static inline __m256i majority(__m256i x, __m256i y, __m256i z)
+{
+    return bit_or(bit_and(x, y), bit_and(z, bit_or(x, y)));
+}
+
+// Gather a word from each lane (lane zero in the lowest element).
+BC_TARGET("avx2")
+static inline __m256i gather(const uint64_t* words, size_t stride)
+{
+    return _mm256_set_epi64x(
+        static_cast<long long>(words[3 * stride]),
+        static_cast<long long>(words[2 * stride]),
+        static_cast<long long>(words[1 * stride]),
+        static_cast<long long>(words[0 * stride]));
+}
+
+BC_TARGET("avx2")
+void sha512_transform_avx2_4way(uint64_t* states, const uint8_t* const* blocks)
+{
+    uint64_t words[lanes * 16];
+    for (size_t lane = 0; lane < lanes; ++lane)
+        for (size_t index = 0; index < 16; ++index)
+            words[lane * 16 + index] = read_word(blocks[lane], index);
+
+    __m256i schedule[16];
+    for (size_t index = 0; index < 16; ++index)
+        schedule[index] = gather(&words[index], 16);
+
+    __m256i state[state_size];
+    for (size_t index = 0; index < state_size; ++index)
+        state[index] = gather(&states[index], state_size);
+
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+
+    for (size_t round = 0; round < 80; ++round)
+    {
+        auto& word = schedule[round % 16];
+
+        if (round >= 16)
+            word = add(add(word, sigma0(schedule[(round + 1) % 16])),
+                add(schedule[(round + 9) % 16],
+                    sigma1(schedule[(round + 14) % 16])));
+
+        const auto constant = _mm256_set1_epi64x(
+            static_cast<long long>(sha512_round_constants[round]));
+        const auto t1 = add(add(h, big_sigma1(e)),
+            add(choose(e, f, g), add(constant, word)));
+        const auto t2 = add(big_sigma0(a), majority(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, t2);
+    }
+
+    state[0] = add(state[0], a);
+    state[1] = add(state[1], b);
+    state[2] = add(state[2], c);
+    state[3] = add(state[3], d);
+    state[4] = add(state[4], e);
+    state[5] = add(state[5], f);
+    state[6] = add(state[6], g);
+    state[7] = add(state[7], h);
+
+    uint64_t lane_words[lanes];
+    for (size_t index = 0; index < state_size; ++index)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_words),
+            state[index]);
+        for (size_t lane = 0; lane < lanes; ++lane)
+            states[lane * state_size + index] = lane_words[lane];
+    }
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../math/sha512_engine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include "../math/external/sha512.h"
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t block_size = 128;
+static BC_CONSTEXPR size_t digest_size = 64;
+static BC_CONSTEXPR size_t state_size = 8;
+static BC_CONSTEXPR size_t max_lanes = 4;
+
+const uint64_t sha512_round_constants[80] =
+{
+    0x428a2f98d728ae22, 0x7137449123ef65cd,
+    0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019,
+    0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe,
+    0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1,
+    0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+    0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483,
+    0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210,
+    0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+    0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926,
+    0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8,
+    0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+    0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910,
+    0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53,
+    0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+    0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60,
+    0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9,
+    0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207,
+    0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6,
+    0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493,
+    0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+    0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+};
+
+void sha512_transform_generic(uint64_t* state, const uint8_t* blocks,
+    size_t count)
+{
+    for (size_t block = 0; block < count; ++block)
+        SHA512Transform(state, blocks + block * block_size);
+}
+
+// Lane selection.
+// ----------------------------------------------------------------------------
+
+typedef void (*transform_lanes)(uint64_t* states,
+    const uint8_t* const* blocks);
+
+struct lanes_implementation
+{
+    size_t lanes;
+    transform_lanes transform;
+};
+
+static lanes_implementation select_lanes()
+{
+#ifdef BC_SHA256_X86
+    if (have_avx2())
+        return{ 4, sha512_transform_avx2_4way };
+#endif
+
+    return{ 1, nullptr };
+}
+
+static const lanes_implementation& selected()
+{
+    static const auto implementation = select_lanes();
+    return implementation;
+}
+
+size_t sha512_lanes()
+{
+    return selected().lanes;
+}
+
+// Keying.
+// ----------------------------------------------------------------------------
+
+void hmac_sha512_key(uint64_t* inner, uint64_t* outer, const uint8_t* key,
+    size_t size)
+{
+    std::array<uint8_t, block_size> pad{ {} };
+
+    // Keys longer than a block are hashed to their digest (rfc 2104).
+    if (size > block_size)
+        SHA512_(key, size, pad.data());
+    else
+        std::copy(key, key + size, pad.begin());
+
+    SHA512CTX context;
+    for (auto& byte: pad)
+        byte ^= 0x36;
+
+    SHA512Init(&context);
+    SHA512Transform(context.state, pad.data());
+    std::copy(context.state, context.state + state_size, inner);
+
+    for (auto& byte: pad)
+        byte ^= 0x36 ^ 0x5c;
+
+    SHA512Init(&context);
+    SHA512Transform(context.state, pad.data());
+    std::copy(context.state, context.state + state_size, outer);
+}
+
+// Iteration.
+// ----------------------------------------------------------------------------
+
+// Each hmac round hashes a 64 byte message following a keyed block, so it is
+// a single block transform of the message padded to 1536 bits in total.
+static void initialize_block(uint8_t* block)
+{
+    std::fill(block + digest_size, block + block_size, 0);
+    block[digest_size] = 0x80;
+    block[block_size - 2] = (1536 >> 8) & 0xff;
+    block[block_size - 1] = 1536 & 0xff;
+}
+
+// Replace the message of the block with the big endian state.
+static void store(uint8_t* block, const uint64_t* state)
+{
+    for (size_t word = 0; word < state_size; ++word)
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+            block[word * sizeof(uint64_t) + byte] = static_cast<uint8_t>(
+                state[word] >> (56 - 8 * byte));
+}
+
+static void accumulate(uint8_t* result, const uint8_t* block)
+{
+    for (size_t byte = 0; byte < digest_size; ++byte)
+        result[byte] ^= block[byte];
+}
+
+void pbkdf2_sha512_iterate(const uint64_t* inner, const uint64_t* outer,
+    uint8_t* result, size_t rounds)
+{
+    uint8_t block[block_size];
+    std::copy(result, result + digest_size, block);
+    initialize_block(block);
+
+    uint64_t state[state_size];
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        std::copy(inner, inner + state_size, state);
+        SHA512Transform(state, block);
+        store(block, state);
+
+        std::copy(outer, outer + state_size, state);
+        SHA512Transform(state, block);
+        store(block, state);
+
+        accumulate(result, block);
+    }
+}
+
+void pbkdf2_sha512_iterate_lanes(const uint64_t* inners,
+    const uint64_t* outers, uint8_t* results, size_t rounds)
+{
+    const auto& implementation = selected();
+    const auto lanes = implementation.lanes;
+
+    if (implementation.transform == nullptr)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+            pbkdf2_sha512_iterate(inners + lane * state_size,
+                outers + lane * state_size, results + lane * digest_size,
+                rounds);
+
+        return;
+    }
+
+    BITCOIN_ASSERT(lanes <= max_lanes);
+    uint8_t blocks[max_lanes][block_size];
+    const uint8_t* pointers[max_lanes];
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        const auto result = results + lane * digest_size;
+        std::copy(result, result + digest_size, blocks[lane]);
+        initialize_block(blocks[lane]);
+        pointers[lane] = blocks[lane];
+    }
+
+    const auto words = lanes * state_size;
+    uint64_t states[max_lanes * state_size];
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        std::copy(inners, inners + words, states);
+        implementation.transform(states, pointers);
+        for (size_t lane = 0; lane < lanes; ++lane)
+            store(blocks[lane], &states[lane * state_size]);
+
+        std::copy(outers, outers + words, states);
+        implementation.transform(states, pointers);
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            store(blocks[lane], &states[lane * state_size]);
+            accumulate(results + lane * digest_size, blocks[lane]);
+        }
+    }
+}
+
+} // namespace libbitcoin
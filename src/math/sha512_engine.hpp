@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA512_ENGINE_HPP
+#define LIBBITCOIN_SHA512_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "../math/sha256_engine.hpp"
+
+namespace libbitcoin {
+
+/// The sha512 round constants (fips 180-4, section 4.2.3).
+extern const uint64_t sha512_round_constants[80];
+
+// Kernels, each defined only where the compiler supports the instructions.
+void sha512_transform_generic(uint64_t* state, const uint8_t* blocks,
+    size_t count);
+
+#ifdef BC_SHA256_X86
+void sha512_transform_avx2_4way(uint64_t* states,
+    const uint8_t* const* blocks);
+#endif
+
+/// The number of derivations the processor iterates at once, or one.
+size_t sha512_lanes();
+
+/// Key the inner and outer hmac sha512 states (8 words each).
+void hmac_sha512_key(uint64_t* inner, uint64_t* outer, const uint8_t* key,
+    size_t size);
+
+/**
+ * Complete the pbkdf2 hmac sha512 block function from its first hmac output.
+ * Iterates the hmac of the 64 byte digest for rounds more rounds under the
+ * keyed states, accumulating each output into result (which starts as the
+ * first output).
+ */
+void pbkdf2_sha512_iterate(const uint64_t* inner, const uint64_t* outer,
+    uint8_t* result, size_t rounds);
+
+/// As pbkdf2_sha512_iterate for sha512_lanes() derivations at once, the
+/// states and results of each lane being contiguous.
+void pbkdf2_sha512_iterate_lanes(const uint64_t* inners,
+    const uint64_t* outers, uint8_t* results, size_t rounds);
+
+} // namespace libbitcoin
+
+#endif
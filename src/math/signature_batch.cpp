@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/signature_batch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/parallel_for.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+// Tasks claim this many triples at a time from the shared cursor.
+static constexpr size_t claim_size = 8;
+
+// The queued triples and results, shared by the workers verifying them.
+class signature_batch::job
+{
+public:
+    job(signature_cache* cache)
+      : cache_(cache)
+    {
+    }
+
+    size_t add(const data_chunk& point, const hash_digest& hash,
+        const endorsement& signature)
+    {
+        auto found = points_.find(point);
+
+        if (found == points_.end())
+            found = points_.emplace(point, is_point(point)).first;
+
+        entries_.push_back({ &*found, hash, signature });
+        return entries_.size() - 1;
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+
+    void prepare()
+    {
+        valid_.resize(entries_.size());
+    }
+
+    void check_range(size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            valid_[index] = check(entries_[index]) ? 1 : 0;
+    }
+
+    std::vector<bool> results() const
+    {
+        return std::vector<bool>(valid_.begin(), valid_.end());
+    }
+
+private:
+    // Each distinct point maps to whether it is structurally valid.
+    typedef std::map<data_chunk, bool> point_map;
+
+    // Map elements are not moved by insertion, so entries refer to them.
+    struct entry
+    {
+        const point_map::value_type* point;
+        hash_digest hash;
+        endorsement signature;
+    };
+
+    bool check(const entry& entry) const
+    {
+        if (!entry.point->second)
+            return false;
+
+        const auto& point = entry.point->first;
+
+        if (cache_ != nullptr)
+            return cache_->verify(point, entry.hash, entry.signature);
+
+        return verify_signature(point, entry.hash, entry.signature);
+    }
+
+    signature_cache* const cache_;
+    point_map points_;
+    std::vector<entry> entries_;
+
+    // Bytes rather than bits, as tasks write results concurrently.
+    std::vector<uint8_t> valid_;
+};
+
+signature_batch::signature_batch()
+  : cache_(nullptr), job_(std::make_shared<job>(cache_))
+{
+}
+
+signature_batch::signature_batch(signature_cache& cache)
+  : cache_(&cache), job_(std::make_shared<job>(cache_))
+{
+}
+
+size_t signature_batch::add(const data_chunk& point, const hash_digest& hash,
+    const endorsement& signature)
+{
+    return job_->add(point, hash, signature);
+}
+
+size_t signature_batch::size() const
+{
+    return job_->size();
+}
+
+void signature_batch::verify(threadpool& pool, result_handler handler)
+{
+    const auto work = job_;
+    job_ = std::make_shared<job>(cache_);
+    work->prepare();
+
+    const auto check = [work](size_t first, size_t last)
+    {
+        work->check_range(first, last);
+    };
+
+    const auto complete = [work, handler]()
+    {
+        handler(work->results());
+    };
+
+    parallel_for(pool, work->size(), claim_size, check, complete);
+}
+
+std::vector<bool> signature_batch::verify()
+{
+    const auto work = job_;
+    job_ = std::make_shared<job>(cache_);
+    work->prepare();
+    work->check_range(0, work->size());
+    return work->results();
+}
+
+} // namespace libbitcoin
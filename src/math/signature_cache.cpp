@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/signature_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
+
+namespace libbitcoin {
+
+size_t signature_cache::key_hash::operator()(const hash_digest& key) const
+{
+    size_t value;
+    std::memcpy(&value, key.data(), sizeof(value));
+    return value;
+}
+
+signature_cache::signature_cache(size_t capacity)
+  : capacity_(capacity),
+    salt_(pseudo_random())
+{
+    positions_.reserve(capacity_);
+    keys_.reserve(capacity_);
+}
+
+hash_digest signature_cache::key(data_slice point, const hash_digest& hash,
+    const endorsement& signature) const
+{
+    sha256_context context;
+    context.update(to_little_endian(salt_));
+    context.update(hash);
+    context.update(point);
+    context.update(signature);
+    return context.digest();
+}
+
+bool signature_cache::contains(data_slice point, const hash_digest& hash,
+    const endorsement& signature) const
+{
+    const auto entry = key(point, hash, signature);
+
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+
+    return positions_.find(entry) != positions_.end();
+}
+
+// Eviction moves the last key into the position of a random one, so keys_
+// stays dense and positions_ always indexes it.
+void signature_cache::insert(data_slice point, const hash_digest& hash,
+    const endorsement& signature)
+{
+    if (capacity_ == 0)
+        return;
+
+    const auto entry = key(point, hash, signature);
+    const auto victim = pseudo_random();
+
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
+
+    if (positions_.find(entry) != positions_.end())
+        return;
+
+    if (keys_.size() == capacity_)
+    {
+        const auto position = static_cast<size_t>(victim % keys_.size());
+        positions_[keys_.back()] = position;
+        positions_.erase(keys_[position]);
+        keys_[position] = keys_.back();
+        keys_.pop_back();
+    }
+
+    positions_.emplace(entry, keys_.size());
+    keys_.push_back(entry);
+}
+
+bool signature_cache::verify(const data_chunk& point, const hash_digest& hash,
+    const endorsement& signature)
+{
+    if (contains(point, hash, signature))
+        return true;
+
+    if (!verify_signature(point, hash, signature))
+        return false;
+
+    insert(point, hash, signature);
+    return true;
+}
+
+void signature_cache::clear()
+{
+    boost::unique_lock<boost::shared_mutex> lock(mutex_);
+
+    positions_.clear();
+    keys_.clear();
+}
+
+size_t signature_cache::capacity() const
+{
+    return capacity_;
+}
+
+size_t signature_cache::size() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+
+    return keys_.size();
+}
+
+} // namespace libbitcoin
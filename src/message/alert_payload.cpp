@@ -19,10 +19,10 @@
  */
 #include <bitcoin/bitcoin/message/alert_payload.hpp>
 #include <boost/iostreams/stream.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -144,12 +144,7 @@ bool alert_payload::from_data(reader& source)
 
 data_chunk alert_payload::to_data() const
 {
-    data_chunk data;
-    boost::iostreams::stream<byte_sink<data_chunk>> ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void alert_payload::to_data(std::ostream& stream) const
@@ -19,10 +19,10 @@
  */
 #include <bitcoin/bitcoin/message/filter_clear.hpp>
 #include <boost/iostreams/stream.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -79,12 +79,7 @@ bool filter_clear::from_data(reader& source)
 
 data_chunk filter_clear::to_data() const
 {
-    data_chunk data;
-    boost::iostreams::stream<byte_sink<data_chunk>> ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void filter_clear::to_data(std::ostream& stream) const
@@ -22,10 +22,10 @@
 #include <initializer_list>
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/message/inventory_type_id.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -104,12 +104,7 @@ bool inventory::from_data(reader& source)
 
 data_chunk inventory::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void inventory::to_data(std::ostream& stream) const
@@ -21,11 +21,12 @@
 
 #include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/merkle.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -53,6 +54,21 @@ merkle_block merkle_block::factory_from_data(reader& source)
     return instance;
 }
 
+merkle_block merkle_block::factory_from_block(const chain::block& block,
+    const std::vector<bool>& matches)
+{
+    hash_list tx_hashes;
+    tx_hashes.reserve(block.transactions.size());
+    for (const auto& tx: block.transactions)
+        tx_hashes.push_back(tx.hash());
+
+    merkle_block instance;
+    instance.header = block.header;
+    instance.header.transaction_count = tx_hashes.size();
+    partial_merkle_tree(instance.hashes, instance.flags, tx_hashes, matches);
+    return instance;
+}
+
 bool merkle_block::is_valid() const
 {
     return !hashes.empty() || !flags.empty() || header.is_valid();
@@ -113,12 +129,7 @@ bool merkle_block::from_data(reader& source)
 
 data_chunk merkle_block::to_data() const
 {
-    data_chunk data;
-    boost::iostreams::stream<byte_sink<data_chunk>> ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void merkle_block::to_data(std::ostream& stream) const
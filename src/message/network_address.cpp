@@ -20,10 +20,10 @@
 #include <bitcoin/bitcoin/message/network_address.hpp>
 
 #include <boost/iostreams/stream.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -107,12 +107,11 @@ bool network_address::from_data(reader& source, bool with_timestamp)
 
 data_chunk network_address::to_data(bool with_timestamp) const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream, with_timestamp);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size(with_timestamp));
-    return data;
+    const auto size = serialized_size(with_timestamp);
+    return write_sized(size, [&](slice_writer& sink)
+    {
+        to_data(sink, with_timestamp);
+    });
 }
 
 void network_address::to_data(std::ostream& stream, bool with_timestamp) const
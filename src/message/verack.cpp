@@ -19,10 +19,10 @@
  */
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <boost/iostreams/stream.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -79,18 +79,17 @@ bool verack::from_data(reader& source)
 
 data_chunk verack::to_data() const
 {
-    data_chunk data;
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == serialized_size());
-    return data;
+    return to_sized_data(*this);
 }
 
 void verack::to_data(std::ostream& stream) const
 {
 }
 
+void verack::to_data(writer&) const
+{
+}
+
 uint64_t verack::serialized_size() const
 {
     return verack::satoshi_fixed_size();
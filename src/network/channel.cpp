@@ -29,9 +29,9 @@
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/network/proxy.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/deadline.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/random.hpp>
+#include <bitcoin/bitcoin/utility/timer_wheel.hpp>
 
 // This must be declared in the global namespace.
 INITIALIZE_TRACK(bc::network::channel);
@@ -39,24 +39,18 @@ INITIALIZE_TRACK(bc::network::channel);
 namespace libbitcoin {
 namespace network {
 
-// Factory for deadline timer pointer construction.
-static deadline::ptr alarm(threadpool& pool, const asio::duration& duration)
-{
-    return std::make_shared<deadline>(pool, duration);
-}
-
 channel::channel(threadpool& pool, asio::socket_ptr socket,
     const settings& settings)
   : proxy(pool, socket, settings.identifier),
+    CONSTRUCT_TRACK(channel, LOG_NETWORK),
     nonce_(0),
-    version_({ 0 }),
     located_start_(null_hash),
     located_stop_(null_hash),
-    revival_handler_(nullptr),
-    expiration_(alarm(pool, pseudo_randomize(settings.channel_expiration()))),
-    inactivity_(alarm(pool, settings.channel_inactivity())),
-    revival_(alarm(pool, settings.channel_revival())),
-    CONSTRUCT_TRACK(channel, LOG_NETWORK)
+    version_({ 0 }),
+    expiration_period_(pseudo_randomize(settings.channel_expiration())),
+    inactivity_period_(settings.channel_inactivity()),
+    revival_period_(settings.channel_revival()),
+    revival_handler_(nullptr)
 {
 }
 
@@ -65,10 +59,12 @@ void channel::start()
     proxy::start();
 }
 
-void channel::talk()
+// Timers are registered before reading, which touches the inactivity timer.
+void channel::talk(timer_wheel::ptr timers)
 {
-    proxy::talk();
+    timers_ = timers;
     start_timers();
+    proxy::talk();
 }
 
 uint64_t channel::nonce() const
@@ -104,15 +100,21 @@ void channel::set_version(const message::version& value)
 
 void channel::handle_stopping()
 {
-    expiration_->cancel();
-    inactivity_->cancel();
-    revival_->cancel();
+    if (timers_)
+    {
+        timers_->cancel(expiration_);
+        timers_->cancel(inactivity_);
+        timers_->cancel(revival_);
+    }
+
     revival_handler_ = nullptr;
 }
 
+// This is lock free, the inactivity timer is reinserted lazily upon expiry.
 void channel::handle_activity()
 {
-    start_inactivity();
+    if (timers_)
+        timers_->touch(inactivity_, inactivity_period_);
 }
 
 void channel::start_timers()
@@ -143,7 +145,7 @@ void channel::start_expiration()
     if (stopped())
         return;
 
-    expiration_->start(
+    expiration_ = timers_->schedule(expiration_period_,
         std::bind(&channel::handle_expiration,
             shared_from_base<channel>(), _1));
 }
@@ -153,7 +155,7 @@ void channel::start_inactivity()
     if (stopped())
         return;
 
-    inactivity_->start(
+    inactivity_ = timers_->schedule(inactivity_period_,
         std::bind(&channel::handle_inactivity,
             shared_from_base<channel>(), _1));
 }
@@ -163,9 +165,15 @@ void channel::start_revival()
     if (stopped())
         return;
 
-    revival_->start(
+    const auto handler =
         std::bind(&channel::handle_revival,
-            shared_from_base<channel>(), _1));
+            shared_from_base<channel>(), _1);
+
+    // The timer is reused once registered, so its handle is not replaced.
+    if (revival_)
+        timers_->schedule(revival_, revival_period_, handler);
+    else
+        revival_ = timers_->schedule(revival_period_, handler);
 }
 
 void channel::handle_expiration(const code& ec)
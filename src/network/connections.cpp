@@ -19,114 +19,95 @@
  */
 #include <bitcoin/bitcoin/network/connections.hpp>
 
-#include <algorithm>
+#include <cstddef>
+#include <boost/thread/locks.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-connections::connections(threadpool& pool)
-  : dispatch_(pool)
+connections::connections()
 {
 }
 
 connections::~connections()
 {
-    BITCOIN_ASSERT_MSG(buffer_.empty(), "Connection buffer not empty.");
+    BITCOIN_ASSERT_MSG(channels_.empty(), "Connection buffer not empty.");
 }
 
-connections::iterator connections::find(const authority& authority) const
+connections::list connections::snapshot() const
 {
-    const auto found = [&authority](const channel::ptr& entry)
-    {
-        return entry->authority() == authority;
-    };
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+
+    list channels;
+    channels.reserve(channels_.size());
+    for (const auto& entry: channels_)
+        channels.push_back(entry.second);
 
-    return std::find_if(buffer_.begin(), buffer_.end(), found);
+    return channels;
 }
 
-connections::iterator connections::find(const channel::ptr& channel) const
+// Channels are stopped outside of the lock, as stop handlers remove them.
+void connections::stop(const code& ec)
 {
-    return std::find(buffer_.begin(), buffer_.end(), channel);
+    for (const auto& channel: snapshot())
+        channel->stop(ec);
 }
 
-void connections::stop(const code& ec)
+size_t connections::count() const
 {
-    dispatch_.ordered(&connections::do_stop,
-        this, ec);
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    return channels_.size();
 }
 
-void connections::do_stop(const code& ec)
+void connections::count(count_handler handler) const
 {
-    for (auto channel: buffer_)
-        channel->stop(ec);
+    handler(count());
 }
 
-void connections::exists(const authority& address, truth_handler handler)
+bool connections::exists(const authority& authority) const
 {
-    dispatch_.ordered(&connections::do_exists,
-        this, address, handler);
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    return channels_.find(authority) != channels_.end();
 }
 
-void connections::do_exists(const authority& address,
+void connections::exists(const authority& authority,
     truth_handler handler) const
 {
-    const auto found = find(address) != buffer_.end();
-    handler(found);
+    handler(exists(authority));
 }
 
 void connections::remove(const channel::ptr& channel, result_handler handler)
 {
-    dispatch_.ordered(&connections::do_remove,
-        this, channel, handler);
-}
+    code ec(error::success);
 
-void connections::do_remove(const channel::ptr& channel,
-    result_handler handler)
-{
-    auto it = std::find(buffer_.begin(), buffer_.end(), channel);
-    if (it == buffer_.end())
+    // The authority of a channel is fixed at construction.
     {
-        handler(error::not_found);
-        return;
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        const auto it = channels_.find(channel->authority());
+
+        if (it == channels_.end() || it->second != channel)
+            ec = error::not_found;
+        else
+            channels_.erase(it);
     }
 
-    buffer_.erase(it);
-    handler(error::success);
+    handler(ec);
 }
 
 void connections::store(const channel::ptr& channel, result_handler handler)
 {
-    dispatch_.ordered(&connections::do_store,
-        this, channel, handler);
-}
+    bool inserted;
 
-void connections::do_store(const channel::ptr& channel, result_handler handler)
-{
-    const auto found = find(channel->authority()) != buffer_.end();
-    if (found)
     {
-        handler(error::address_in_use);
-        return;
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        inserted = channels_.emplace(channel->authority(), channel).second;
     }
 
-    buffer_.push_back(channel);
-    handler(error::success);
-}
-
-void connections::count(count_handler handler)
-{
-    dispatch_.ordered(&connections::do_count,
-        this, handler);
-}
-
-void connections::do_count(count_handler handler) const
-{
-    handler(buffer_.size());
+    handler(inserted ? error::success : error::address_in_use);
 }
 
 } // namespace network
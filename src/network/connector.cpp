@@ -19,9 +19,13 @@
  */
 #include <bitcoin/bitcoin/network/connector.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/asio.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
@@ -29,6 +33,7 @@
 #include <bitcoin/bitcoin/network/proxy.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/synchronizer.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 #define NAME "connector"
@@ -41,20 +46,61 @@ namespace network {
 using std::placeholders::_1;
 using std::placeholders::_2;
 
-connector::connector(threadpool& pool, const settings& settings)
-  : pool_(pool),
+// Parse a numeric host, with or without IPv6 brackets. IPv4-mapped addresses
+// are connected as IPv4, as they would be once resolved.
+static bool parse_numeric(const std::string& hostname, uint16_t port,
+    asio::endpoint& out)
+{
+    auto host = hostname;
+    if (host.size() > 2 && host.front() == '[' && host.back() == ']')
+        host = host.substr(1, host.size() - 2);
+
+    boost_code ec;
+    auto ip = asio::address::from_string(host, ec);
+    if (ec)
+        return false;
+
+    if (ip.is_v6() && ip.to_v6().is_v4_mapped())
+        ip = ip.to_v6().to_v4();
+
+    out = asio::endpoint(ip, port);
+    return true;
+}
+
+connector::connector(threadpool& pool, const settings& settings,
+    statistics& statistics)
+  : CONSTRUCT_TRACK(connector, LOG_NETWORK),
+    pool_(pool),
     settings_(settings),
+    statistics_(statistics),
     resolver_(std::make_shared<asio::resolver>(pool.service())),
-    CONSTRUCT_TRACK(connector, LOG_NETWORK)
+    in_flight_(0)
 {
 }
 
-// This will invoke the handler of all outstanding accept calls.
+// This will invoke the handler of all outstanding connect calls.
 void connector::cancel()
 {
+    std::deque<dial> queued;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued.swap(queue_);
+    }
+
+    for (const auto& attempt: queued)
+        attempt.handler(error::service_stopped, nullptr);
+
     resolver_->cancel();
 }
 
+size_t connector::in_flight() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
 void connector::connect(const config::endpoint& endpoint,
     connect_handler handler)
 {
@@ -70,35 +116,121 @@ void connector::connect(const config::authority& authority,
 void connector::connect(const std::string& hostname, uint16_t port,
     connect_handler handler)
 {
-    const auto handle_connect = synchronize(handler, 1, NAME);
+    // The slot is released before the handler is invoked, and only once.
+    const auto self = shared_from_this();
+    const auto release = [self, handler](const code& ec, channel::ptr channel)
+    {
+        self->release();
+        handler(ec, channel);
+    };
+
+    const auto handle_connect = synchronize(release, 1, NAME);
+    const auto start = std::bind(&connector::start,
+        self, hostname, port, handle_connect);
+
+    acquire({ start, handler });
+}
+
+// Start the attempt now if under the limit, otherwise queue it.
+void connector::acquire(const dial& attempt)
+{
+    const auto limit = settings_.connect_limit;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (limit != 0 && in_flight_ >= limit)
+        {
+            queue_.push_back(attempt);
+            return;
+        }
+
+        ++in_flight_;
+    }
+
+    attempt.start();
+}
+
+// Pass the slot of a completed attempt to the next queued attempt, if any.
+void connector::release()
+{
+    std::function<void()> next;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        BITCOIN_ASSERT(in_flight_ > 0);
+
+        if (queue_.empty())
+        {
+            --in_flight_;
+            return;
+        }
+
+        next = std::move(queue_.front().start);
+        queue_.pop_front();
+    }
+
+    next();
+}
+
+void connector::start(const std::string& hostname, uint16_t port,
+    connect_handler handler)
+{
+    asio::endpoint endpoint;
+
+    // Numeric hosts bypass the resolver.
+    if (parse_numeric(hostname, port, endpoint))
+    {
+        const auto socket = std::make_shared<asio::socket>(pool_.service());
+        const auto timer = start_timer(socket, handler);
+
+        socket->async_connect(endpoint,
+            std::bind(&connector::handle_connect,
+                shared_from_this(), _1, socket, timer, clock::now(),
+                    handler));
+        return;
+    }
+
     const auto query = std::make_shared<asio::query>(hostname,
         std::to_string(port));
 
     resolver_->async_resolve(*query,
         std::bind(&connector::handle_resolve,
-            shared_from_this(), _1, _2, handle_connect));
+            shared_from_this(), _1, _2, clock::now(), handler));
 }
 
 void connector::handle_resolve(const boost_code& ec, asio::iterator iterator,
-    connect_handler handler)
+    clock::time_point started, connect_handler handler)
 {
+    statistics_.resolve.record(started);
+
     if (ec)
     {
         handler(error::resolve_failed, nullptr);
         return;
     }
 
+    const auto socket = std::make_shared<asio::socket>(pool_.service());
+    const auto timer = start_timer(socket, handler);
+
+    boost::asio::async_connect(*socket, iterator,
+        std::bind(&connector::handle_connect,
+            shared_from_this(), _1, socket, timer, clock::now(), handler));
+}
+
+deadline::ptr connector::start_timer(asio::socket_ptr socket,
+    connect_handler handler)
+{
     const auto timeout = settings_.connect_timeout();
     const auto timer = std::make_shared<deadline>(pool_, timeout);
-    const auto socket = std::make_shared<asio::socket>(pool_.service());
 
     timer->start(
         std::bind(&connector::handle_timer,
             shared_from_this(), _1, socket, handler));
 
-    boost::asio::async_connect(*socket, iterator,
-        std::bind(&connector::handle_connect,
-            shared_from_this(), _1, _2, socket, timer, handler));
+    return timer;
 }
 
 void connector::handle_timer(const code& ec, asio::socket_ptr socket,
@@ -112,14 +244,19 @@ void connector::handle_timer(const code& ec, asio::socket_ptr socket,
     socket->cancel();
 }
 
-void connector::handle_connect(const boost_code& ec, asio::iterator,
-    asio::socket_ptr socket, deadline::ptr timer, connect_handler handler)
+void connector::handle_connect(const boost_code& ec, asio::socket_ptr socket,
+    deadline::ptr timer, clock::time_point started, connect_handler handler)
 {
     if (ec)
+    {
         handler(error::boost_to_error_code(ec), nullptr);
+    }
     else
+    {
+        statistics_.connect.record(started);
         handler(error::success,
             std::make_shared<channel>(pool_, socket, settings_));
+    }
 
     timer->cancel();
 }
@@ -21,37 +21,182 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <sstream>
 #include <string>
 #include <vector>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/locks.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/network_settings.hpp>
 #include <bitcoin/bitcoin/unicode/ifstream.hpp>
 #include <bitcoin/bitcoin/unicode/ofstream.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-hosts::hosts(threadpool& pool, const settings& settings)
-  : buffer_(std::max(settings.host_pool_capacity, 1u)),
-    dispatch_(pool),
-    file_path_(settings.hosts_file),
-    disabled_(settings.host_pool_capacity == 0)
+// One quarter of the pool is reserved for hosts that have been connected.
+// Buckets are small so that eviction, which scans a bucket, is cheap.
+static constexpr size_t tried_ratio = 4;
+static constexpr size_t bucket_size = 16;
+
+// A new host is dropped after this many attempts without a connection.
+static constexpr uint32_t max_attempts = 10;
+
+// The binary file is the magic, the record count and then each record.
+static constexpr uint32_t file_magic = 0x74736f68;
+static constexpr size_t file_heading_size = 2 * sizeof(uint32_t);
+
+static size_t record_size()
+{
+    return message::network_address::satoshi_fixed_size(true) +
+        sizeof(uint32_t) + sizeof(uint8_t);
+}
+
+static uint32_t now()
 {
+    return static_cast<uint32_t>(std::time(nullptr));
 }
 
-hosts::iterator hosts::find(const address& host)
+// Addresses within the same /16 (IPv4) or /32 (IPv6) share a group.
+static data_slice group(const message::network_address& host)
 {
-    const auto found = [&host](const address& entry)
+    static const data_chunk ipv4_prefix
     {
-        return entry.port == host.port && entry.ip == host.ip;
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff
     };
 
-    return std::find_if(buffer_.begin(), buffer_.end(), found);
+    const auto begin = host.ip.data();
+    if (std::equal(ipv4_prefix.begin(), ipv4_prefix.end(), begin))
+        return data_slice(begin + ipv4_prefix.size(),
+            begin + ipv4_prefix.size() + 2);
+
+    return data_slice(begin, begin + 4);
+}
+
+hosts::table hosts::create_table(size_t capacity)
+{
+    table result;
+    result.capacity = capacity;
+    result.entries.reserve(capacity);
+    result.buckets.resize(std::max((capacity + bucket_size - 1) / bucket_size,
+        size_t(1)));
+    return result;
+}
+
+// A host is better if it has fewer failed attempts, then if it is newer.
+bool hosts::better(const record& left, const record& right)
+{
+    if (left.attempts != right.attempts)
+        return left.attempts < right.attempts;
+
+    return left.host.timestamp > right.host.timestamp;
+}
+
+hosts::hosts(threadpool& pool, const settings& settings)
+  : new_(create_table(settings.host_pool_capacity -
+        settings.host_pool_capacity / tried_ratio)),
+    tried_(create_table(settings.host_pool_capacity / tried_ratio)),
+    salt_(pseudo_random()),
+    dispatch_(pool),
+    file_path_(settings.hosts_file)
+{
+    records_.reserve(settings.host_pool_capacity);
+}
+
+// The bucket is salted so that peers cannot predict bucket collisions.
+size_t hosts::bucket(const address& host, const table& table) const
+{
+    const auto bytes = group(host);
+    auto seed = static_cast<size_t>(salt_);
+    boost::hash_range(seed, bytes.begin(), bytes.end());
+    return seed % table.buckets.size();
+}
+
+// The better of two random hosts, which biases selection toward good hosts.
+hosts::entry hosts::select(const table& table) const
+{
+    BITCOIN_ASSERT(!table.entries.empty());
+    const auto size = table.entries.size();
+    const auto first = table.entries[pseudo_random() % size];
+    const auto second = table.entries[pseudo_random() % size];
+
+    if (better(second->second, first->second))
+        return second;
+
+    return first;
+}
+
+// Evict the worst host of the bucket, demoting it to new if it was tried.
+// Returns the number of hosts removed from the pool.
+size_t hosts::evict(table& table, size_t bucket)
+{
+    const auto& entries = table.buckets[bucket];
+    BITCOIN_ASSERT(!entries.empty());
+
+    auto worst = entries.front();
+    for (const auto entry: entries)
+        if (better(worst->second, entry->second))
+            worst = entry;
+
+    const auto evicted = worst->second;
+    erase(worst);
+
+    if (!evicted.tried)
+        return 1;
+
+    return insert(evicted.host, evicted.attempts, false);
+}
+
+// Returns the number of hosts removed from the pool to make space.
+size_t hosts::insert(const address& host, uint32_t attempts, bool tried)
+{
+    if (tried && tried_.capacity == 0)
+        tried = false;
+
+    auto& table = tried ? tried_ : new_;
+    if (table.capacity == 0)
+        return 0;
+
+    size_t evicted = 0;
+    const auto index = bucket(host, table);
+    if (table.buckets[index].size() >= bucket_size)
+        evicted = evict(table, index);
+    else if (table.entries.size() >= table.capacity)
+        evicted = evict(table, select(table)->second.bucket);
+
+    const auto position = table.entries.size();
+    const auto entry = &*records_.emplace(key(host),
+        record{ host, attempts, tried, index, position }).first;
+
+    table.entries.push_back(entry);
+    table.buckets[index].push_back(entry);
+    return evicted;
+}
+
+void hosts::erase(entry host)
+{
+    auto& table = host->second.tried ? tried_ : new_;
+    const auto position = host->second.position;
+
+    // Move the last entry into the vacated position to keep the table dense.
+    table.entries[position] = table.entries.back();
+    table.entries[position]->second.position = position;
+    table.entries.pop_back();
+
+    auto& bucket = table.buckets[host->second.bucket];
+    bucket.erase(std::find(bucket.begin(), bucket.end(), host));
+    records_.erase(records_.find(host->first));
 }
 
 void hosts::load(result_handler handler)
@@ -62,29 +207,72 @@ void hosts::load(result_handler handler)
 
 void hosts::do_load(const path& file_path, result_handler handler)
 {
-    if (disabled_)
+    if (new_.capacity == 0)
     {
         handler(error::success);
         return;
     }
 
-    bc::ifstream file(file_path.string());
+    bc::ifstream file(file_path.string(), std::ifstream::binary);
     if (file.bad())
     {
         handler(error::file_system);
         return;
     }
 
-    // Formerly each address was randomly-queued for insert here.
+    // The file is read whole and parsed in place.
+    file.seekg(0, std::ifstream::end);
+    data_chunk data(std::max(static_cast<std::streamoff>(file.tellg()),
+        std::streamoff(0)));
+    file.seekg(0, std::ifstream::beg);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+    slice_reader source(data);
+    const auto binary = data.size() >= file_heading_size &&
+        source.read_4_bytes_little_endian() == file_magic;
+
+    code ec(error::success);
+
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+
+        if (!binary)
+            load_text(std::string(data.begin(), data.end()));
+        else if (!load_binary(source))
+            ec = error::bad_stream;
+    }
+
+    handler(ec);
+}
+
+bool hosts::load_binary(reader& source)
+{
+    const auto count = source.read_4_bytes_little_endian();
+    for (size_t index = 0; index < count && source; ++index)
+    {
+        address host;
+        host.from_data(source, true);
+        const auto attempts = source.read_4_bytes_little_endian();
+        const auto tried = source.read_byte() != 0;
+
+        if (source && records_.find(key(host)) == records_.end())
+            insert(host, attempts, tried);
+    }
+
+    return source;
+}
+
+// The former file format, which is read so that existing files migrate.
+void hosts::load_text(const std::string& text)
+{
+    std::istringstream file(text);
     std::string line;
     while (std::getline(file, line))
     {
-        config::authority host(line);
-        if (host.port() != 0)
-            buffer_.push_back(host.to_network_address());
+        const config::authority host(line);
+        if (host.port() != 0 && records_.find(host) == records_.end())
+            insert(host.to_network_address(), 0, false);
     }
-
-    handler(error::success);
 }
 
 void hosts::save(result_handler handler)
@@ -95,100 +283,191 @@ void hosts::save(result_handler handler)
 
 void hosts::do_save(const path& path, result_handler handler)
 {
-    if (disabled_)
+    if (new_.capacity == 0)
     {
         handler(error::success);
         return;
     }
 
-    bc::ofstream file(path.string());
+    data_chunk data;
+
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        data.resize(file_heading_size + records_.size() * record_size());
+        slice_writer sink(data);
+        sink.write_4_bytes_little_endian(file_magic);
+        sink.write_4_bytes_little_endian(
+            static_cast<uint32_t>(records_.size()));
+
+        for (const auto& entry: records_)
+        {
+            entry.second.host.to_data(sink, true);
+            sink.write_4_bytes_little_endian(entry.second.attempts);
+            sink.write_byte(entry.second.tried ? 1 : 0);
+        }
+
+        BITCOIN_ASSERT(sink.is_exhausted());
+    }
+
+    bc::ofstream file(path.string(), std::ofstream::binary);
     if (file.bad())
     {
         handler(error::file_system);
         return;
     }
 
-    for (const auto& entry: buffer_)
-        file << config::authority(entry) << std::endl;
-
-    handler(error::success);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    handler(file.bad() ? error::file_system : error::success);
 }
 
 void hosts::remove(const address& host, result_handler handler)
 {
-    dispatch_.unordered(&hosts::do_remove,
-        this, host, handler);
+    code ec(error::success);
+
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+
+        const auto it = records_.find(key(host));
+
+        if (it == records_.end())
+            ec = error::not_found;
+        else
+            erase(&*it);
+    }
+
+    handler(ec);
 }
 
-void hosts::do_remove(const address& host, result_handler handler)
+// Invalid and duplicate addresses are counted though not treated as errors.
+void hosts::ingest(const address& host, store_counts& counts)
 {
-    auto it = find(host);
-    if (it == buffer_.end())
+    if (!host.is_valid() || host.port == 0)
     {
-        handler(error::not_found);
+        ++counts.invalid;
         return;
     }
 
-    buffer_.erase(it);
-    handler(error::success);
+    const auto it = records_.find(key(host));
+    if (it != records_.end())
+    {
+        it->second.host.timestamp = std::max(it->second.host.timestamp,
+            host.timestamp);
+        ++counts.duplicate;
+        return;
+    }
+
+    counts.evicted += insert(host, 0, false);
+    ++counts.accepted;
 }
 
 void hosts::store(const address& host, result_handler handler)
 {
-    dispatch_.unordered(&hosts::do_store,
-        this, host, handler);
-}
+    store_counts counts{ 0, 0, 0, 0 };
 
-void hosts::store(const address::list& hosts, result_handler handler)
-{
-    // We disperse here to allow other addresses messages to interleave hosts.
-    dispatch_.disperse(hosts, "hosts", handler,
-        &hosts::do_store, this);
-}
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        ingest(host, counts);
+    }
 
-void hosts::do_store(const address& host, result_handler handler)
-{
-    if (!host.is_valid())
+    if (counts.invalid != 0)
         log::debug(LOG_PROTOCOL)
             << "Invalid host address from peer";
-    else if (find(host) != buffer_.end())
-        log::debug(LOG_PROTOCOL)
-            << "Redundant host address from peer";
-    else
-        buffer_.push_back(host);
 
-    // We don't treat invalid address as an error, just log it.
     handler(error::success);
 }
 
-void hosts::fetch(fetch_handler handler)
+// The list is ingested in one critical section, so an addr message costs
+// one lock rather than a job per address.
+void hosts::store(const address::list& hosts, store_handler handler)
 {
-    dispatch_.unordered(&hosts::do_fetch,
-        this, handler);
+    store_counts counts{ 0, 0, 0, 0 };
+
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        for (const auto& host: hosts)
+            ingest(host, counts);
+    }
+
+    handler(error::success, counts);
 }
 
-void hosts::do_fetch(fetch_handler handler)
+void hosts::attempt(const address& host, result_handler handler)
 {
-    if (buffer_.empty())
+    code ec(error::success);
+
     {
-        handler(error::not_found, address());
-        return;
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        const auto it = records_.find(key(host));
+
+        if (it == records_.end())
+            ec = error::not_found;
+        else if (++it->second.attempts >= max_attempts && !it->second.tried)
+            erase(&*it);
     }
 
-    // Randomly select an address from the buffer.
-    const auto index = static_cast<size_t>(pseudo_random() % buffer_.size());
-    handler(error::success, buffer_[index]);
+    handler(ec);
 }
 
-void hosts::count(count_handler handler)
+void hosts::confirm(const address& host, result_handler handler)
 {
-    dispatch_.ordered(&hosts::do_count,
-        this, handler);
+    code ec(error::success);
+
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        const auto it = records_.find(key(host));
+
+        if (it == records_.end())
+        {
+            ec = error::not_found;
+        }
+        else if (it->second.tried)
+        {
+            it->second.attempts = 0;
+            it->second.host.timestamp = now();
+        }
+        else
+        {
+            auto confirmed = it->second.host;
+            confirmed.timestamp = now();
+            erase(&*it);
+            insert(confirmed, 0, true);
+        }
+    }
+
+    handler(ec);
+}
+
+void hosts::fetch(fetch_handler handler) const
+{
+    address host;
+    code ec(error::success);
+
+    // Tried hosts are preferred, though new hosts must also be explored.
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+
+        if (records_.empty())
+            ec = error::not_found;
+        else if (new_.entries.empty() ||
+            (!tried_.entries.empty() && pseudo_random() % 2 == 0))
+            host = select(tried_)->second.host;
+        else
+            host = select(new_)->second.host;
+    }
+
+    handler(ec, host);
 }
 
-void hosts::do_count(count_handler handler)
+void hosts::count(count_handler handler) const
 {
-    handler(buffer_.size());
+    size_t size;
+
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        size = records_.size();
+    }
+
+    handler(size);
 }
 
 } // namespace network
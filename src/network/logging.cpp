@@ -20,127 +20,73 @@
 #include <bitcoin/bitcoin/network/logging.hpp>
 
 #include <functional>
+#include <initializer_list>
 #include <iostream>
-#include <mutex>
-#include <utility>
-#include <sstream>
+#include <memory>
 #include <string>
-#include <boost/date_time.hpp>
-#include <boost/format.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
+#include <bitcoin/bitcoin/utility/log_writer.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-// Guard against concurrent stream writes.
-static std::mutex console_mutex;
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
 
-// Guard against concurrent file writes.
-static std::mutex file_mutex;
-
-static std::string make_log_string(log::level level, const std::string& domain,
-    const std::string& body)
+// Only the writer thread writes to the devices, so they are not locked.
+// Each batch is written and flushed once per device.
+static void write(std::ostream& device, const std::string& lines)
 {
-    if (body.empty())
-        return "";
-
-    static const auto form = "%1% %2% [%3%] %4%\n";
-    const auto message = boost::format(form) %
-        boost::posix_time::microsec_clock::local_time().time_of_day() %
-        log::to_text(level) %
-        domain %
-        body;
-
-    return message.str();
-}
-
-static void log_to_file(std::ofstream& file, log::level level,
-    const std::string& domain, const std::string& body)
-{
-    std::string message;
-    message = make_log_string(level, domain, body);
-
-    if (!message.empty())
-    {
-        // This is overkill as we may locking across different files, but
-        // since fatal/error/warning logging is very infrequent this is ok.
-        std::lock_guard<std::mutex> lock_file(file_mutex);
-        file << message;
-        file.flush();
-    }
+    device << lines;
+    device.flush();
 }
 
-static void log_to_both(std::ostream& device, std::ofstream& file,
-    log::level level, const std::string& domain, const std::string& body)
+// debug|info => debug_log, warning|error|fatal => error_log
+// info|error|fatal => console
+static void output(std::ofstream& debug, std::ofstream& error,
+    std::ostream& output_stream, std::ostream& error_stream,
+    log::level level, const std::string& lines)
 {
-    std::string message;
-    message = make_log_string(level, domain, body);
-
-    if (!message.empty())
+    switch (level)
     {
-        // This is overkill as we may locking across different devices, but
-        // since fatal/error/warning logging is very infrequent this is ok.
-        // Also cout and cerr devices are typically writing to the same
-        // display. Locking across both devices prevents presentation mixing.
-        std::lock_guard<std::mutex> lock_console(console_mutex);
-        device << message;
-        device.flush();
-    }
-
-    if (!message.empty())
-    {
-        // This is overkill as we may locking across different files, but
-        // since fatal/error/warning logging is very infrequent this is ok.
-        std::lock_guard<std::mutex> lock_file(file_mutex);
-        file << message;
-        file.flush();
+        case log::level::debug:
+            write(debug, lines);
+            break;
+        case log::level::info:
+            write(debug, lines);
+            write(output_stream, lines);
+            break;
+        case log::level::warning:
+            write(error, lines);
+            break;
+        case log::level::error:
+        case log::level::fatal:
+            write(error, lines);
+            write(error_stream, lines);
+            break;
+        default:
+            break;
     }
 }
 
-static void output_file(std::ofstream& file, log::level level,
-    const std::string& domain, const std::string& body)
-{
-    log_to_file(file, level, domain, body);
-}
-
-static void output_both(std::ofstream& file, std::ostream& output,
-    log::level level, const std::string& domain, const std::string& body)
-{
-    log_to_both(output, file, level, domain, body);
-}
-
-static void error_file(std::ofstream& file, log::level level,
-    const std::string& domain, const std::string& body)
-{
-    log_to_file(file, level, domain, body);
-}
-
-static void error_both(std::ofstream& file, std::ostream& error,
-    log::level level, const std::string& domain, const std::string& body)
-{
-    log_to_both(error, file, level, domain, body);
-}
-
 void initialize_logging(std::ofstream& debug, std::ofstream& error,
-    std::ostream& output_stream, std::ostream& error_stream)
+    std::ostream& output_stream, std::ostream& error_stream,
+    log::level minimum)
 {
-    using std::placeholders::_1;
-    using std::placeholders::_2;
-    using std::placeholders::_3;
-
-    // debug|info => debug_log
-    log::debug("").set_output_function(std::bind(output_file,
-        std::ref(debug), _1, _2, _3));
-    log::info("").set_output_function(std::bind(output_both,
-        std::ref(debug), std::ref(output_stream), _1, _2, _3));
-
-    // warning|error|fatal => error_log + console
-    log::warning("").set_output_function(std::bind(error_file,
-        std::ref(error), _1, _2, _3));
-    log::error("").set_output_function(std::bind(error_both,
-        std::ref(error), std::ref(error_stream), _1, _2, _3));
-    log::fatal("").set_output_function(std::bind(error_both,
-        std::ref(error), std::ref(error_stream), _1, _2, _3));
+    // The writer is retained by the output functions, until log::clear().
+    const auto writer = std::make_shared<log_writer>(
+        std::bind(output, std::ref(debug), std::ref(error),
+            std::ref(output_stream), std::ref(error_stream), _1, _2));
+
+    const log::functor queue = std::bind(&log_writer::write, writer, _1, _2,
+        _3);
+
+    // Levels below the minimum are disabled, so are not formatted.
+    for (const auto level: { log::level::debug, log::level::info,
+        log::level::warning, log::level::error, log::level::fatal })
+        log(level, "").set_output_function(
+            level >= minimum ? queue : log::functor());
 }
 
 } // namespace network
@@ -26,6 +26,8 @@
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/messages.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/istream_reader.hpp>
+#include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
@@ -37,11 +39,11 @@
         pool, #value, log))
 
 #define RELAY_MESSAGE(value) \
-    value##_subscriber_->relay(ec, message::value())
+    value##_subscriber_->relay(ec, std::make_shared<message::value>())
 
-#define CASE_LOAD_STREAM(value) \
+#define CASE_LOAD_READER(value) \
     case message_type::value: \
-        return load<message::value>(stream, value##_subscriber_)
+        return load<message::value>(source, value##_subscriber_)
 
 TRACK_SUBSCRIBER(address)
 TRACK_SUBSCRIBER(alert)
@@ -121,30 +123,36 @@ void message_subscriber::broadcast(const code& ec)
 }
 
 code message_subscriber::load(message_type type, std::istream& stream) const
+{
+    istream_reader source(stream);
+    return load(type, source);
+}
+
+code message_subscriber::load(message_type type, reader& source) const
 {
     switch (type)
     {
-        CASE_LOAD_STREAM(address);
-        CASE_LOAD_STREAM(alert);
-        CASE_LOAD_STREAM(block);
-        CASE_LOAD_STREAM(filter_add);
-        CASE_LOAD_STREAM(filter_clear);
-        CASE_LOAD_STREAM(filter_load);
-        CASE_LOAD_STREAM(get_address);
-        CASE_LOAD_STREAM(get_blocks);
-        CASE_LOAD_STREAM(get_data);
-        CASE_LOAD_STREAM(get_headers);
-        CASE_LOAD_STREAM(headers);
-        CASE_LOAD_STREAM(inventory);
-        CASE_LOAD_STREAM(memory_pool);
-        CASE_LOAD_STREAM(merkle_block);
-        CASE_LOAD_STREAM(not_found);
-        CASE_LOAD_STREAM(ping);
-        CASE_LOAD_STREAM(pong);
-        CASE_LOAD_STREAM(reject);
-        CASE_LOAD_STREAM(transaction);
-        CASE_LOAD_STREAM(verack);
-        CASE_LOAD_STREAM(version);
+        CASE_LOAD_READER(address);
+        CASE_LOAD_READER(alert);
+        CASE_LOAD_READER(block);
+        CASE_LOAD_READER(filter_add);
+        CASE_LOAD_READER(filter_clear);
+        CASE_LOAD_READER(filter_load);
+        CASE_LOAD_READER(get_address);
+        CASE_LOAD_READER(get_blocks);
+        CASE_LOAD_READER(get_data);
+        CASE_LOAD_READER(get_headers);
+        CASE_LOAD_READER(headers);
+        CASE_LOAD_READER(inventory);
+        CASE_LOAD_READER(memory_pool);
+        CASE_LOAD_READER(merkle_block);
+        CASE_LOAD_READER(not_found);
+        CASE_LOAD_READER(ping);
+        CASE_LOAD_READER(pong);
+        CASE_LOAD_READER(reject);
+        CASE_LOAD_READER(transaction);
+        CASE_LOAD_READER(verack);
+        CASE_LOAD_READER(version);
         case message_type::unknown:
         default:
             return error::not_found;
@@ -43,6 +43,7 @@
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
+#include <bitcoin/bitcoin/utility/timer_wheel.hpp>
 
 INITIALIZE_TRACK(bc::network::channel::channel_subscriber);
 
@@ -53,6 +54,9 @@ namespace network {
 
 using std::placeholders::_1;
 
+// Channel timeouts are configured in seconds or minutes.
+static const asio::duration timer_resolution(0, 0, 1);
+
 const settings p2p::mainnet
 {
     NETWORK_THREADS,
@@ -62,6 +66,8 @@ const settings p2p::mainnet
     NETWORK_OUTBOUND_CONNECTIONS,
     NETWORK_CONNECT_ATTEMPTS,
     NETWORK_CONNECT_TIMEOUT_SECONDS,
+    NETWORK_CONNECT_BATCH_SIZE,
+    NETWORK_CONNECT_LIMIT,
     NETWORK_CHANNEL_HANDSHAKE_SECONDS,
     NETWORK_CHANNEL_REVIVAL_MINUTES,
     NETWORK_CHANNEL_HEARTBEAT_MINUTES,
@@ -87,6 +93,8 @@ const settings p2p::testnet
     NETWORK_OUTBOUND_CONNECTIONS,
     NETWORK_CONNECT_ATTEMPTS,
     NETWORK_CONNECT_TIMEOUT_SECONDS,
+    NETWORK_CONNECT_BATCH_SIZE,
+    NETWORK_CONNECT_LIMIT,
     NETWORK_CHANNEL_HANDSHAKE_SECONDS,
     NETWORK_CHANNEL_REVIVAL_MINUTES,
     NETWORK_CHANNEL_HEARTBEAT_MINUTES,
@@ -108,9 +116,8 @@ p2p::p2p(const settings& settings)
     height_(0),
     settings_(settings),
     dispatch_(pool_),
-    pending_(pool_),
-    connections_(pool_),
     hosts_(pool_, settings_),
+    timers_(std::make_shared<timer_wheel>(pool_, timer_resolution)),
     subscriber_(std::make_shared<channel::channel_subscriber>(pool_, NAME,
         LOG_NETWORK))
 {
@@ -136,6 +143,16 @@ void p2p::set_height(size_t value)
     height_ = value;
 }
 
+connector::statistics& p2p::connect_statistics()
+{
+    return statistics_;
+}
+
+timer_wheel::ptr p2p::timers()
+{
+    return timers_;
+}
+
 // Startup processing.
 // ----------------------------------------------------------------------------
 
@@ -151,6 +168,7 @@ void p2p::start(result_handler handler)
 
     pool_.join();
     pool_.spawn(settings_.threads, thread_priority::low);
+    timers_->start();
 
     hosts_.load(
         dispatch_.ordered_delegate(&p2p::handle_hosts_loaded,
@@ -234,6 +252,7 @@ void p2p::stop(result_handler handler)
     manual_ = nullptr;
     relay(error::service_stopped, nullptr);
     connections_.stop(error::service_stopped);
+    timers_->stop();
 
     hosts_.save(
         dispatch_.ordered_delegate(&p2p::handle_hosts_saved,
@@ -315,7 +334,7 @@ void p2p::store(const address& address, result_handler handler)
     hosts_.store(address, handler);
 }
 
-void p2p::store(const address::list& addresses, result_handler handler)
+void p2p::store(const address::list& addresses, store_handler handler)
 {
     hosts_.store(addresses, handler);
 }
@@ -330,6 +349,16 @@ void p2p::address_count(count_handler handler)
     hosts_.count(handler);
 }
 
+void p2p::attempt_address(const address& address, result_handler handler)
+{
+    hosts_.attempt(address, handler);
+}
+
+void p2p::confirm_address(const address& address, result_handler handler)
+{
+    hosts_.confirm(address, handler);
+}
+
 // Channel management.
 // ----------------------------------------------------------------------------
 
@@ -19,121 +19,108 @@
  */
 #include <bitcoin/bitcoin/network/pending.hpp>
 
-#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
+#include <boost/thread/locks.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/network/channel.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace network {
 
-pending::pending(threadpool& pool)
-  : dispatch_(pool)
+pending::pending()
 {
 }
 
 pending::~pending()
 {
-    BITCOIN_ASSERT_MSG(buffer_.empty(), "Pending buffer not empty.");
+    BITCOIN_ASSERT_MSG(channels_.empty(), "Pending buffer not empty.");
 }
 
-pending::iterator pending::find(const uint64_t version_nonce) const
+// Channels are stopped outside of the lock, as stop handlers remove them.
+void pending::clear(const code& ec)
 {
-    const auto found = [version_nonce](const channel::ptr& entry)
+    std::vector<channel::ptr> channels;
+
     {
-        return entry->nonce() == version_nonce;
-    };
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        channels.reserve(channels_.size());
+        for (const auto& entry: channels_)
+            channels.push_back(entry.first);
 
-    return std::find_if(buffer_.begin(), buffer_.end(), found);
-}
+        channels_.clear();
+        nonces_.clear();
+    }
 
-pending::iterator pending::find(const channel::ptr& channel) const
-{
-    return std::find(buffer_.begin(), buffer_.end(), channel);
+    for (const auto& channel: channels)
+        channel->stop(ec);
 }
 
-void pending::clear(const code& ec)
+size_t pending::count() const
 {
-    dispatch_.ordered(&pending::do_clear,
-        this, ec);
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    return channels_.size();
 }
 
-void pending::do_clear(const code& ec)
+void pending::count(count_handler handler) const
 {
-    for (auto channel: buffer_)
-        channel->stop(ec);
-
-    buffer_.clear();
+    handler(count());
 }
 
-void pending::exists(uint64_t version_nonce, truth_handler handler)
+bool pending::exists(uint64_t version_nonce) const
 {
     // This is an optimization that requires we always set a non-zero nonce.
     if (version_nonce == 0)
-    {
-        handler(false);
-        return;
-    }
-        
-    dispatch_.ordered(&pending::do_exists,
-        this, version_nonce, handler);
+        return false;
+
+    boost::shared_lock<boost::shared_mutex> lock(mutex_);
+    return nonces_.find(version_nonce) != nonces_.end();
 }
 
-void pending::do_exists(uint64_t version_nonce, truth_handler handler) const
+void pending::exists(uint64_t version_nonce, truth_handler handler) const
 {
-    const auto found = find(version_nonce) != buffer_.end();
-    handler(found);
+    handler(exists(version_nonce));
 }
 
+// The channel nonce may have been reset, so the stored nonce is used.
 void pending::remove(const channel::ptr& channel, result_handler handler)
 {
-    dispatch_.ordered(&pending::do_remove,
-        this, channel, handler);
-}
+    code ec(error::success);
 
-void pending::do_remove(const channel::ptr& channel, result_handler handler)
-{
-    auto it = std::find(buffer_.begin(), buffer_.end(), channel);
-    if (it == buffer_.end())
     {
-        handler(error::not_found);
-        return;
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        const auto it = channels_.find(channel);
+
+        if (it == channels_.end())
+        {
+            ec = error::not_found;
+        }
+        else
+        {
+            nonces_.erase(it->second);
+            channels_.erase(it);
+        }
     }
 
-    buffer_.erase(it);
-    handler(error::success);
+    handler(ec);
 }
 
 void pending::store(const channel::ptr& channel, result_handler handler)
 {
-    dispatch_.ordered(&pending::do_store,
-        this, channel, handler);
-}
+    const auto nonce = channel->nonce();
+    bool inserted;
 
-void pending::do_store(const channel::ptr& channel, result_handler handler)
-{
-    const auto found = find(channel->nonce()) != buffer_.end();
-    if (found)
     {
-        handler(error::address_in_use);
-        return;
-    }
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        inserted = nonces_.emplace(nonce, channel).second;
 
-    buffer_.push_back(channel);
-    handler(error::success);
-}
-
-void pending::count(count_handler handler)
-{
-    dispatch_.ordered(&pending::do_count,
-        this, handler);
-}
+        if (inserted)
+            channels_.emplace(channel, nonce);
+    }
 
-void pending::do_count(count_handler handler) const
-{
-    handler(buffer_.size());
+    handler(inserted ? error::success : error::address_in_use);
 }
 
 } // namespace network
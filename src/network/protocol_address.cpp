@@ -70,7 +70,7 @@ void protocol_address::start(const settings& settings)
 }
 
 void protocol_address::handle_receive_address(const code& ec,
-    const address& message)
+    std::shared_ptr<const address> message)
 {
     if (stopped())
         return;
@@ -89,14 +89,14 @@ void protocol_address::handle_receive_address(const code& ec,
 
     log::debug(LOG_PROTOCOL)
         << "Storing addresses from [" << authority() << "] ("
-        << message.addresses.size() << ")";
+        << message->addresses.size() << ")";
 
     // TODO: manage timestamps (active channels are connected < 3 hours ago).
-    network_.store(message.addresses, BIND1(handle_store_addresses, _1));
+    network_.store(message->addresses, BIND2(handle_store_addresses, _1, _2));
 }
 
 void protocol_address::handle_receive_get_address(const code& ec,
-    const get_address& message)
+    std::shared_ptr<const get_address> message)
 {
     if (stopped())
         return;
@@ -154,7 +154,8 @@ void protocol_address::handle_send_get_address(const code& ec)
     }
 }
 
-void protocol_address::handle_store_addresses(const code& ec)
+void protocol_address::handle_store_addresses(const code& ec,
+    const p2p::store_counts& counts)
 {
     if (stopped())
         return;
@@ -165,7 +166,14 @@ void protocol_address::handle_store_addresses(const code& ec)
             << "Failure storing addresses from [" << authority() << "] "
             << ec.message();
         stop(ec);
+        return;
     }
+
+    log::debug(LOG_PROTOCOL)
+        << "Stored addresses from [" << authority() << "] (accepted "
+        << counts.accepted << ", duplicate " << counts.duplicate
+        << ", invalid " << counts.invalid << ", evicted " << counts.evicted
+        << ")";
 }
 
 } // namespace network
@@ -82,7 +82,7 @@ void protocol_ping::send_ping(const code& ec)
 }
 
 void protocol_ping::handle_receive_ping(const code& ec,
-    const message::ping& message)
+    std::shared_ptr<const message::ping> message)
 {
     if (stopped())
         return;
@@ -98,11 +98,11 @@ void protocol_ping::handle_receive_ping(const code& ec,
 
     // Resubscribe to ping messages.
     SUBSCRIBE2(ping, handle_receive_ping, _1, _2);
-    SEND1(pong(message.nonce), handle_send_pong, _1);
+    SEND1(pong(message->nonce), handle_send_pong, _1);
 }
 
 void protocol_ping::handle_receive_pong(const code& ec,
-    const message::pong& message, uint64_t nonce)
+    std::shared_ptr<const message::pong> message, uint64_t nonce)
 {
     if (stopped())
         return;
@@ -116,7 +116,7 @@ void protocol_ping::handle_receive_pong(const code& ec,
         return;
     }
 
-    if (message.nonce != nonce)
+    if (message->nonce != nonce)
     {
         log::warning(LOG_PROTOCOL)
             << "Invalid pong nonce from [" << authority() << "]";
@@ -96,7 +96,7 @@ void protocol_seed::handle_seeding_complete(const code& ec,
 }
 
 void protocol_seed::handle_receive_address(const code& ec,
-    const address& message)
+    std::shared_ptr<const address> message)
 {
     if (stopped())
         return;
@@ -112,10 +112,10 @@ void protocol_seed::handle_receive_address(const code& ec,
 
     log::debug(LOG_PROTOCOL)
         << "Storing addresses from seed [" << authority() << "] ("
-        << message.addresses.size() << ")";
+        << message->addresses.size() << ")";
 
     // TODO: manage timestamps (active channels are connected < 3 hours ago).
-    network_.store(message.addresses, BIND1(handle_store_addresses, _1));
+    network_.store(message->addresses, BIND2(handle_store_addresses, _1, _2));
 }
 
 void protocol_seed::handle_send_address(const code& ec)
@@ -154,7 +154,8 @@ void protocol_seed::handle_send_get_address(const code& ec)
     set_event(error::success);
 }
 
-void protocol_seed::handle_store_addresses(const code& ec)
+void protocol_seed::handle_store_addresses(const code& ec,
+    const p2p::store_counts& counts)
 {
     if (stopped())
         return;
@@ -168,6 +169,12 @@ void protocol_seed::handle_store_addresses(const code& ec)
         return;
     }
 
+    log::debug(LOG_PROTOCOL)
+        << "Stored addresses from seed [" << authority() << "] (accepted "
+        << counts.accepted << ", duplicate " << counts.duplicate
+        << ", invalid " << counts.invalid << ", evicted " << counts.evicted
+        << ")";
+
     log::debug(LOG_PROTOCOL)
         << "Stopping completed seed [" << authority() << "] ";
 
@@ -119,7 +119,7 @@ void protocol_version::handle_handshake_complete(const code& ec,
 }
 
 void protocol_version::handle_receive_version(const code& ec,
-    const version& message)
+    std::shared_ptr<const version> message)
 {
     if (stopped())
         return;
@@ -134,10 +134,11 @@ void protocol_version::handle_receive_version(const code& ec,
     }
 
     log::debug(LOG_PROTOCOL)
-        << "Peer [" << authority() << "] version (" << message.value
-        << ") services (" << message.services << ") " << message.user_agent;
+        << "Peer [" << authority() << "] version (" << message->value
+        << ") services (" << message->services << ") "
+        << message->user_agent;
 
-    set_version(message);
+    set_version(*message);
     SEND1(verack(), handle_verack_sent, _1);
 }
 
@@ -178,7 +179,7 @@ void protocol_version::handle_version_sent(const code& ec)
 }
 
 void protocol_version::handle_receive_verack(const code& ec,
-    const message::verack&)
+    std::shared_ptr<const message::verack>)
 {
     if (stopped())
         return;
@@ -24,9 +24,9 @@
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <string>
 #include <boost/date_time.hpp>
 #include <boost/format.hpp>
-#include <boost/iostreams/stream.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
@@ -35,7 +35,7 @@
 #include <bitcoin/bitcoin/network/message_subscriber.hpp>
 #include <bitcoin/bitcoin/network/shared_const_buffer.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
-#include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deadline.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
@@ -43,6 +43,7 @@
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 // This must be declared in the global namespace.
@@ -60,6 +61,16 @@ using boost::posix_time::time_duration;
 // TODO: this is made-up, configure payload size guard for DoS protection.
 static constexpr size_t max_payload_size = 10 * 1024 * 1024;
 
+// Each channel rotates between two payload buffers, so that the reader may
+// continue into one while the other is parsed. Larger buffers are freed.
+static constexpr size_t payload_buffer_limit = 2;
+static constexpr size_t payload_buffer_max_size = 1024 * 1024;
+
+// Idle send buffers are retained up to this count, and up to the size of a
+// full block message with its heading.
+static constexpr size_t send_buffer_limit = 16;
+static constexpr size_t send_buffer_max_size = 1024 * 1024 + 24;
+
 // Cache the address for logging after stop.
 config::authority proxy::authority_factory(asio::socket_ptr socket)
 {
@@ -68,6 +79,13 @@ config::authority proxy::authority_factory(asio::socket_ptr socket)
     return ec ? config::authority() : config::authority(endpoint);
 }
 
+// Send buffers are shared by all channels, as broadcasts share one buffer.
+buffer_pool::ptr proxy::send_buffer(size_t size)
+{
+    static buffer_pool pool(send_buffer_limit, send_buffer_max_size);
+    return pool.get(size);
+}
+
 proxy::proxy(threadpool& pool, asio::socket_ptr socket, uint32_t magic)
   : stopped_(true),
     magic_(magic),
@@ -76,7 +94,8 @@ proxy::proxy(threadpool& pool, asio::socket_ptr socket, uint32_t magic)
     authority_(authority_factory(socket)),
     message_subscriber_(pool),
     stop_subscriber_(std::make_shared<stop_subscriber>(pool, "stop_subscriber",
-        LOG_NETWORK))
+        LOG_NETWORK)),
+    payload_buffers_(payload_buffer_limit, payload_buffer_max_size)
 {
 }
 
@@ -169,12 +188,14 @@ void proxy::read_payload(const heading& head)
     if (stopped())
         return;
 
-    payload_buffer_.resize(head.payload_size);
+    // The payload buffer is held by the handler, not the proxy.
+    const std::shared_ptr<data_chunk> payload =
+        payload_buffers_.get(head.payload_size);
 
     using namespace boost::asio;
-    async_read(*socket_, buffer(payload_buffer_, head.payload_size),
+    async_read(*socket_, buffer(*payload),
         dispatch_.ordered_delegate(&proxy::handle_read_payload,
-            shared_from_this(), _1, _2, head));
+            shared_from_this(), _1, _2, head, payload));
 }
 
 void proxy::handle_read_heading(const boost_code& ec, size_t)
@@ -192,8 +213,8 @@ void proxy::handle_read_heading(const boost_code& ec, size_t)
     }
 
     heading head;
-    heading_stream istream(heading_buffer_);
-    const auto parsed = head.from_data(istream);
+    slice_reader source(heading_buffer_);
+    const auto parsed = head.from_data(source);
     if (!parsed || head.magic != magic_)
     {
         log::warning(LOG_NETWORK) 
@@ -220,14 +241,14 @@ void proxy::handle_read_heading(const boost_code& ec, size_t)
 }
 
 void proxy::handle_read_payload(const boost_code& ec, size_t,
-    const heading& heading)
+    const heading& heading, std::shared_ptr<data_chunk> payload)
 {
     if (stopped())
         return;
 
     // Ignore read error here, client may have disconnected.
 
-    if (heading.checksum != bitcoin_checksum(payload_buffer_))
+    if (heading.checksum != bitcoin_checksum(*payload))
     {
         log::warning(LOG_NETWORK) 
             << "Invalid bitcoin checksum from [" << authority() << "]";
@@ -235,22 +256,20 @@ void proxy::handle_read_payload(const boost_code& ec, size_t,
         return;
     }
 
-    // We must copy the payload before restarting the reader.
-    const auto payload_copy = payload_buffer_;
-
     // We must restart the reader before firing subscription events.
+    // The reader continues into another buffer, this one is not overwritten.
     if (!ec)
         read_heading();
 
     handle_activity();
 
-    // Parse and publish the payload to message subscribers.
-    payload_source source(payload_copy);
-    payload_stream istream(source);
-    const auto error = message_subscriber_.load(heading.type(), istream);
+    // Parse and publish the payload to message subscribers. The buffer
+    // returns to the pool when released, once parsing is complete.
+    slice_reader source(*payload);
+    const auto error = message_subscriber_.load(heading.type(), source);
 
-    // Warn about unconsumed bytes in the stream.
-    if (!error && istream.peek() != std::istream::traits_type::eof())
+    // Warn about unconsumed bytes in the payload.
+    if (!error && !source.is_exhausted())
         log::warning(LOG_NETWORK)
             << "Valid message [" << heading.command
             << "] handled, unused bytes remain in payload.";
@@ -276,8 +295,21 @@ void proxy::handle_read_payload(const boost_code& ec, size_t,
     }
 }
 
-void proxy::do_send(const data_chunk& message, result_handler handler,
-    const std::string& command)
+void proxy::send(const shared_const_buffer& message,
+    const std::string& command, result_handler handler)
+{
+    if (stopped())
+    {
+        handler(error::channel_stopped);
+        return;
+    }
+
+    dispatch_.ordered(&proxy::do_send,
+        shared_from_this(), message, handler, command);
+}
+
+void proxy::do_send(const shared_const_buffer& message,
+    result_handler handler, const std::string& command)
 {
     if (stopped())
     {
@@ -289,8 +321,7 @@ void proxy::do_send(const data_chunk& message, result_handler handler,
         << "Send " << command << " [" << authority() << "] ("
         << message.size() << " bytes)";
 
-    const shared_const_buffer buffer(message);
-    async_write(*socket_, buffer,
+    async_write(*socket_, message,
         std::bind(&proxy::call_handle_send,
             shared_from_this(), _1, handler));
 }
@@ -35,6 +35,7 @@
 #include <bitcoin/bitcoin/network/protocol_ping.hpp>
 #include <bitcoin/bitcoin/network/protocol_version.hpp>
 #include <bitcoin/bitcoin/utility/dispatcher.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
 #include <bitcoin/bitcoin/utility/random.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
@@ -71,7 +72,8 @@ acceptor::ptr session::create_acceptor()
 
 connector::ptr session::create_connector()
 {
-    const auto connect = std::make_shared<connector>(pool_, settings_);
+    const auto connect = std::make_shared<connector>(pool_, settings_,
+        network_.connect_statistics());
     const auto handle_stop = [connect]()
     {
         connect->cancel();
@@ -127,6 +129,16 @@ void session::fetch_address(host_handler handler)
     network_.fetch_address(handler);
 }
 
+void session::attempt_address(const authority& host, result_handler handler)
+{
+    network_.attempt_address(host.to_network_address(), handler);
+}
+
+void session::confirm_address(const authority& host, result_handler handler)
+{
+    network_.confirm_address(host.to_network_address(), handler);
+}
+
 void session::connection_count(count_handler handler)
 {
     network_.connected_count(handler);
@@ -140,6 +152,11 @@ bool session::blacklisted(const authority& authority) const
     return it != blocked.end();
 }
 
+const connector::statistics& session::connect_statistics() const
+{
+    return network_.connect_statistics();
+}
+
 // The two handlers are always ordered on the session strand.
 // This should be the first call after a socket is opened on a channel.
 void session::register_channel(channel::ptr channel,
@@ -194,17 +211,18 @@ void session::handle_pend(const code& ec, channel::ptr channel,
 
     const auto handler =
         dispatch_.ordered_delegate(&session::handle_handshake,
-            shared_from_this(), _1, channel, handle_started);
+            shared_from_this(), _1, channel, histogram::clock::now(),
+                handle_started);
 
     // Subscribe start handler to handshake completion.
     attach<protocol_version>(channel, settings_, network_.height(), handler);
 
     // Start reading messages from the socket.
-    channel->talk();
+    channel->talk(network_.timers());
 }
 
 void session::handle_handshake(const code& ec, channel::ptr channel,
-    result_handler handle_started)
+    histogram::clock::time_point started, result_handler handle_started)
 {
     if (ec)
     {
@@ -214,7 +232,7 @@ void session::handle_handshake(const code& ec, channel::ptr channel,
         handle_started(ec);
         return;
     }
-    
+
     if (incoming_)
     {
         network_.pent(channel->version().nonce,
@@ -223,6 +241,8 @@ void session::handle_handshake(const code& ec, channel::ptr channel,
         return;
     }
 
+    network_.connect_statistics().handshake.record(started);
+
     // Bypass loopback test for outgoing channels.
     dispatch_.ordered(&session::handle_is_pending,
         shared_from_this(), false, channel, handle_started);
@@ -19,6 +19,8 @@
  */
 #include <bitcoin/bitcoin/network/session_outbound.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -29,6 +31,7 @@
 #include <bitcoin/bitcoin/network/protocol_address.hpp>
 #include <bitcoin/bitcoin/network/protocol_ping.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/histogram.hpp>
 #include <bitcoin/bitcoin/utility/log.hpp>
 
 INITIALIZE_TRACK(bc::network::session_outbound);
@@ -42,7 +45,9 @@ using std::placeholders::_2;
 session_outbound::session_outbound(threadpool& pool, p2p& network,
     const settings& settings)
   : session(pool, network, settings, false, false),
-    CONSTRUCT_TRACK(session_outbound, LOG_NETWORK)
+    CONSTRUCT_TRACK(session_outbound, LOG_NETWORK),
+    connected_(0),
+    established_(false)
 {
 }
 
@@ -59,6 +64,7 @@ void session_outbound::start()
     }
 
     session::start();
+    started_ = histogram::clock::now();
     const auto connect = create_connector();
     for (size_t peer = 0; peer < settings_.outbound_connections; ++peer)
         new_connection(connect);
@@ -66,23 +72,26 @@ void session_outbound::start()
 
 void session_outbound::new_connection(connector::ptr connect)
 {
-    fetch_address(
-        dispatch_.ordered_delegate(&session_outbound::start_connect,
-            shared_from_base<session_outbound>(), _1, _2, connect));
+    const size_t size = std::max(settings_.connect_batch_size, 1u);
+    const auto race = std::make_shared<batch>(
+        batch{ size, false, false, authority::list{} });
+
+    for (size_t candidate = 0; candidate < size; ++candidate)
+        fetch_address(
+            dispatch_.ordered_delegate(&session_outbound::start_connect,
+                shared_from_base<session_outbound>(), _1, _2, connect, race));
 }
 
 void session_outbound::start_connect(const code& ec, const authority& host,
-    connector::ptr connect)
+    connector::ptr connect, batch_ptr race)
 {
     if (stopped())
         return;
 
-    // This prevents a tight loop in an unusual circumstance.
-    // TODO: rebuild connection count once addresses are found.
     if (ec == error::not_found)
     {
-        log::error(LOG_NETWORK)
-            << "The address pool is empty, suspending outbound session.";
+        race->exhausted = true;
+        handle_failure(connect, race);
         return;
     }
 
@@ -90,7 +99,7 @@ void session_outbound::start_connect(const code& ec, const authority& host,
     {
         log::error(LOG_NETWORK)
             << "Failure fetching new address: " << ec.message();
-        new_connection(connect);
+        handle_failure(connect, race);
         return;
     }
 
@@ -99,31 +108,58 @@ void session_outbound::start_connect(const code& ec, const authority& host,
     {
         log::debug(LOG_NETWORK)
             << "Fetched blacklisted address [" << host << "] ";
-        new_connection(connect);
+        handle_failure(connect, race);
         return;
     }
 
+    // A small pool may return the same address to more than one candidate.
+    const auto& hosts = race->hosts;
+    if (std::find(hosts.begin(), hosts.end(), host) != hosts.end())
+    {
+        handle_failure(connect, race);
+        return;
+    }
+
+    race->hosts.push_back(host);
+
     log::debug(LOG_NETWORK)
         << "Connecting to channel [" << host << "]";
 
     // OUTBOUND CONNECT
     connect->connect(host,
         dispatch_.ordered_delegate(&session_outbound::handle_connect,
-            shared_from_base<session_outbound>(), _1, _2, host, connect));
+            shared_from_base<session_outbound>(), _1, _2, host, connect,
+                race));
 }
 
 void session_outbound::handle_connect(const code& ec, channel::ptr channel,
-    const authority& host, connector::ptr connect)
+    const authority& host, connector::ptr connect, batch_ptr race)
 {
     if (ec)
     {
         log::debug(LOG_NETWORK)
             << "Failure connecting [" << host << "] outbound: "
             << ec.message();
-        new_connection(connect);
+        record_attempt(host);
+        handle_failure(connect, race);
         return;
     }
 
+    --race->remaining;
+
+    // The socket is closed when the unstarted channel is released. The host
+    // connected, so it is not charged with an attempt.
+    if (race->connected)
+    {
+        log::debug(LOG_NETWORK)
+            << "Dropping redundant connection to [" << host << "]";
+        return;
+    }
+
+    // The winner is charged until its channel starts and confirms the host.
+    race->connected = true;
+    record_attempt(host);
+
     log::info(LOG_NETWORK)
         << "Connected to outbound channel [" << channel->authority() << "]";
 
@@ -134,16 +170,60 @@ void session_outbound::handle_connect(const code& ec, channel::ptr channel,
             shared_from_base<session_outbound>(), _1, connect));
 }
 
+// The slot is refilled once all of its candidates have failed.
+void session_outbound::handle_failure(connector::ptr connect, batch_ptr race)
+{
+    BITCOIN_ASSERT(race->remaining > 0);
+    if (--race->remaining > 0 || race->connected)
+        return;
+
+    // This prevents a tight loop in an unusual circumstance.
+    // TODO: rebuild connection count once addresses are found.
+    if (race->exhausted)
+    {
+        log::error(LOG_NETWORK)
+            << "The address pool is empty, suspending outbound session.";
+        return;
+    }
+
+    new_connection(connect);
+}
+
+// Repeatedly failing hosts are dropped from the address pool.
+void session_outbound::record_attempt(const authority& host)
+{
+    attempt_address(host,
+        std::bind(&session_outbound::handle_address,
+            shared_from_base<session_outbound>(), _1, host));
+}
+
+void session_outbound::handle_address(const code& ec, const authority& host)
+{
+    if (ec)
+        log::debug(LOG_NETWORK)
+            << "Failed to update address [" << host << "] " << ec.message();
+}
+
 void session_outbound::handle_channel_start(const code& ec,
     connector::ptr connect, channel::ptr channel)
 {
-    // Treat a start failure just like a stop.
+    // Treat a start failure just like a stop of an uncounted channel.
     if (ec)
     {
-        handle_channel_stop(ec, connect);
+        if (ec != error::service_stopped)
+            new_connection(connect);
+
         return;
     }
 
+    if (++connected_ == settings_.outbound_connections && !established_)
+        report_established();
+
+    // Hosts to which a connection succeeds are preferred by fetch.
+    confirm_address(channel->authority(),
+        std::bind(&session_outbound::handle_address,
+            shared_from_base<session_outbound>(), _1, channel->authority()));
+
     attach<protocol_ping>(channel, settings_);
     attach<protocol_address>(channel, settings_);
 }
@@ -151,9 +231,31 @@ void session_outbound::handle_channel_start(const code& ec,
 void session_outbound::handle_channel_stop(const code& ec,
     connector::ptr connect)
 {
+    BITCOIN_ASSERT(connected_ > 0);
+    --connected_;
+
     if (ec != error::service_stopped)
         new_connection(connect);
 }
 
+// Log the time taken to first fill all slots, and the stage latencies.
+void session_outbound::report_established()
+{
+    established_ = true;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        histogram::clock::now() - started_);
+    const auto& statistics = connect_statistics();
+
+    log::info(LOG_NETWORK)
+        << "Established " << connected_ << " outbound channels in "
+        << elapsed.count() << "ms.";
+    log::debug(LOG_NETWORK)
+        << "Resolve latency: " << statistics.resolve;
+    log::debug(LOG_NETWORK)
+        << "Connect latency: " << statistics.connect;
+    log::debug(LOG_NETWORK)
+        << "Handshake latency: " << statistics.handshake;
+}
+
 } // namespace network
 } // namespace libbitcoin
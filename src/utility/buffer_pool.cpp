@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+// The idle chunks, shared with the deleters of outstanding chunks so that
+// a chunk released after the pool is destroyed is simply freed.
+class buffer_pool::store
+{
+public:
+    typedef std::unique_ptr<data_chunk> chunk_ptr;
+
+    store(size_t limit, size_t max_size)
+      : limit_(limit), max_size_(max_size)
+    {
+        idle_.reserve(limit);
+    }
+
+    chunk_ptr take()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (idle_.empty())
+            return chunk_ptr();
+
+        auto chunk = std::move(idle_.back());
+        idle_.pop_back();
+        return chunk;
+    }
+
+    // A chunk that is not retained is freed on return.
+    void give(chunk_ptr chunk)
+    {
+        if (chunk->capacity() > max_size_)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (idle_.size() < limit_)
+            idle_.push_back(std::move(chunk));
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+private:
+    const size_t limit_;
+    const size_t max_size_;
+    mutable std::mutex mutex_;
+    std::vector<chunk_ptr> idle_;
+};
+
+buffer_pool::recycle::recycle()
+{
+}
+
+buffer_pool::recycle::recycle(std::weak_ptr<store> store)
+  : store_(store)
+{
+}
+
+void buffer_pool::recycle::operator()(data_chunk* chunk) const
+{
+    store::chunk_ptr owned(chunk);
+    const auto pool = store_.lock();
+
+    if (pool)
+        pool->give(std::move(owned));
+}
+
+buffer_pool::buffer_pool(size_t limit, size_t max_size)
+  : store_(std::make_shared<store>(limit, max_size))
+{
+}
+
+buffer_pool::ptr buffer_pool::get(size_t size)
+{
+    auto chunk = store_->take();
+
+    if (!chunk)
+        chunk.reset(new data_chunk);
+
+    chunk->resize(size);
+    return ptr(chunk.release(), recycle(store_));
+}
+
+size_t buffer_pool::size() const
+{
+    return store_->size();
+}
+
+} // namespace libbitcoin
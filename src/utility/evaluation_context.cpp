@@ -19,15 +19,23 @@
  */
 #include "evaluation_context.hpp"
 
-#include <bitcoin/bitcoin/utility/data.hpp>
+#include "stack_element.hpp"
 
 namespace libbitcoin {
 
-data_chunk evaluation_context::pop_primary()
+stack_element evaluation_context::pop_primary()
 {
     const auto value = primary.back();
     primary.pop_back();
     return value;
 }
 
+void evaluation_context::clear()
+{
+    operation_counter = 0;
+    primary.clear();
+    secondary.clear();
+    conditional.clear();
+}
+
 } // namespace libbitcoin
@@ -21,22 +21,27 @@
 #define LIBBITCOIN_EVALUATION_CONTEXT_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <bitcoin/bitcoin/chain/operation.hpp>
-#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/define.hpp>
 #include "conditional_stack.hpp"
+#include "evaluation_stack.hpp"
+#include "stack_element.hpp"
 
 namespace libbitcoin {
 
-class evaluation_context
+class BC_API evaluation_context
 {
 public:
-    data_chunk pop_primary();
+    stack_element pop_primary();
 
-    chain::operation::stack::const_iterator codehash_begin;
+    /// Empty all stacks, retaining their elements for reuse.
+    void clear();
+
+    size_t codehash_begin;
     uint64_t operation_counter;
-    data_stack primary;
-    data_stack secondary;
+    evaluation_stack primary;
+    evaluation_stack secondary;
     conditional_stack conditional;
 };
 
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "evaluation_stack.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include "stack_element.hpp"
+
+namespace libbitcoin {
+
+evaluation_stack::evaluation_stack()
+  : size_(0)
+{
+}
+
+size_t evaluation_stack::size() const
+{
+    return size_;
+}
+
+bool evaluation_stack::empty() const
+{
+    return size_ == 0;
+}
+
+evaluation_stack::iterator evaluation_stack::begin()
+{
+    return elements_.begin();
+}
+
+evaluation_stack::iterator evaluation_stack::end()
+{
+    return elements_.begin() + size_;
+}
+
+evaluation_stack::const_iterator evaluation_stack::begin() const
+{
+    return elements_.begin();
+}
+
+evaluation_stack::const_iterator evaluation_stack::end() const
+{
+    return elements_.begin() + size_;
+}
+
+stack_element& evaluation_stack::back()
+{
+    return elements_[size_ - 1];
+}
+
+const stack_element& evaluation_stack::back() const
+{
+    return elements_[size_ - 1];
+}
+
+void evaluation_stack::push_back(data_slice data)
+{
+    if (size_ < elements_.size())
+    {
+        elements_[size_++].assign(data);
+        return;
+    }
+
+    // The data may reference an element, which growth could relocate.
+    stack_element element(data);
+    elements_.push_back(std::move(element));
+    ++size_;
+}
+
+void evaluation_stack::push_back(const stack_element& element)
+{
+    if (size_ < elements_.size())
+    {
+        elements_[size_++] = element;
+        return;
+    }
+
+    // The vector copies the element before relocating, so it may be our own.
+    elements_.push_back(element);
+    ++size_;
+}
+
+void evaluation_stack::pop_back()
+{
+    --size_;
+}
+
+void evaluation_stack::insert(iterator position, const stack_element& element)
+{
+    const auto offset = position - begin();
+    push_back(element);
+    std::rotate(begin() + offset, end() - 1, end());
+}
+
+void evaluation_stack::erase(iterator position)
+{
+    erase(position, position + 1);
+}
+
+// Erased elements are rotated above the top of the stack for reuse.
+void evaluation_stack::erase(iterator first, iterator last)
+{
+    const auto count = last - first;
+    std::rotate(first, last, end());
+    size_ -= count;
+}
+
+void evaluation_stack::clear()
+{
+    size_ = 0;
+}
+
+void evaluation_stack::assign(const evaluation_stack& other)
+{
+    clear();
+
+    for (const auto& element: other)
+        push_back(element);
+}
+
+void evaluation_stack::swap(evaluation_stack& other)
+{
+    elements_.swap(other.elements_);
+    std::swap(size_, other.size_);
+}
+
+} // namespace libbitcoin
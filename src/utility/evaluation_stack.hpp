@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_EVALUATION_STACK_HPP
+#define LIBBITCOIN_EVALUATION_STACK_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include "stack_element.hpp"
+
+namespace libbitcoin {
+
+/**
+ * A script evaluation stack that never releases its elements.
+ * Popped elements keep their storage and are overwritten by subsequent
+ * pushes, and clear only resets the size. A stack reused across evaluations
+ * therefore stops allocating once it has grown to the needed depth.
+ */
+class BC_API evaluation_stack
+{
+public:
+    typedef std::vector<stack_element>::iterator iterator;
+    typedef std::vector<stack_element>::const_iterator const_iterator;
+
+    evaluation_stack();
+
+    size_t size() const;
+    bool empty() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    stack_element& back();
+    const stack_element& back() const;
+
+    void push_back(data_slice data);
+    void push_back(const stack_element& element);
+    void pop_back();
+
+    void insert(iterator position, const stack_element& element);
+    void erase(iterator position);
+    void erase(iterator first, iterator last);
+
+    /// Empty the stack, retaining all elements for reuse.
+    void clear();
+
+    /// Copy the elements of other, reusing existing storage.
+    void assign(const evaluation_stack& other);
+
+    /// Exchange the elements of the two stacks without copying.
+    void swap(evaluation_stack& other);
+
+private:
+    std::vector<stack_element> elements_;
+    size_t size_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../utility/hashing_reader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+hashing_reader::hashing_reader(reader& source)
+  : source_(source)
+{
+}
+
+hash_digest hashing_reader::hash() const
+{
+    return sha256_hash(context_.digest());
+}
+
+hashing_reader::operator bool() const
+{
+    return source_;
+}
+
+bool hashing_reader::operator!() const
+{
+    return !source_;
+}
+
+bool hashing_reader::is_exhausted() const
+{
+    return source_.is_exhausted();
+}
+
+size_t hashing_reader::read_data(uint8_t* data, size_t size)
+{
+    const auto read_size = source_.read_data(data, size);
+    context_.update(data, read_size);
+    return read_size;
+}
+
+uint8_t hashing_reader::read_byte()
+{
+    uint8_t result = 0;
+    read_data(&result, sizeof(result));
+    return result;
+}
+
+data_chunk hashing_reader::read_data(size_t size)
+{
+    data_chunk result(size);
+    result.resize(read_data(result.data(), size));
+    return result;
+}
+
+data_chunk hashing_reader::read_data_to_eof()
+{
+    const auto result = source_.read_data_to_eof();
+    context_.update(result);
+    return result;
+}
+
+hash_digest hashing_reader::read_hash()
+{
+    hash_digest result{ {} };
+    read_data(result.data(), result.size());
+    return result;
+}
+
+short_hash hashing_reader::read_short_hash()
+{
+    short_hash result{ {} };
+    read_data(result.data(), result.size());
+    return result;
+}
+
+template <typename Integer>
+Integer hashing_reader::read_little_endian()
+{
+    byte_array<sizeof(Integer)> bytes{ {} };
+    read_data(bytes.data(), bytes.size());
+    return from_little_endian_unsafe<Integer>(bytes.begin());
+}
+
+template <typename Integer>
+Integer hashing_reader::read_big_endian()
+{
+    byte_array<sizeof(Integer)> bytes{ {} };
+    read_data(bytes.data(), bytes.size());
+    return from_big_endian_unsafe<Integer>(bytes.begin());
+}
+
+uint16_t hashing_reader::read_2_bytes_little_endian()
+{
+    return read_little_endian<uint16_t>();
+}
+
+uint32_t hashing_reader::read_4_bytes_little_endian()
+{
+    return read_little_endian<uint32_t>();
+}
+
+uint64_t hashing_reader::read_8_bytes_little_endian()
+{
+    return read_little_endian<uint64_t>();
+}
+
+uint64_t hashing_reader::read_variable_uint_little_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_little_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_little_endian();
+
+    // length should be 0xff
+    return read_8_bytes_little_endian();
+}
+
+uint16_t hashing_reader::read_2_bytes_big_endian()
+{
+    return read_big_endian<uint16_t>();
+}
+
+uint32_t hashing_reader::read_4_bytes_big_endian()
+{
+    return read_big_endian<uint32_t>();
+}
+
+uint64_t hashing_reader::read_8_bytes_big_endian()
+{
+    return read_big_endian<uint64_t>();
+}
+
+uint64_t hashing_reader::read_variable_uint_big_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_big_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_big_endian();
+
+    // length should be 0xff
+    return read_8_bytes_big_endian();
+}
+
+std::string hashing_reader::read_fixed_string(size_t length)
+{
+    const auto bytes = read_data(length);
+    const std::string result(bytes.begin(), bytes.end());
+
+    // Removes trailing zeros, as istream_reader.
+    return result.c_str();
+}
+
+std::string hashing_reader::read_string()
+{
+    const auto size = read_variable_uint_little_endian();
+    BITCOIN_ASSERT(size <= bc::max_size_t);
+    return read_fixed_string(static_cast<size_t>(size));
+}
+
+} // namespace libbitcoin
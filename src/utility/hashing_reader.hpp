@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_HASHING_READER_HPP
+#define LIBBITCOIN_HASHING_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/reader.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A reader which passes every byte read from the source into sha256, so that
+ * the bitcoin hash of a deserialized object is obtained from its raw bytes
+ * without a second serialization. Multi-byte values (including variable
+ * length integers) are read from the source as bytes, so that the hash is of
+ * the encoding actually read.
+ */
+class hashing_reader
+  : public reader
+{
+public:
+    hashing_reader(reader& source);
+
+    /// The bitcoin hash of the bytes read so far.
+    hash_digest hash() const;
+
+    operator bool() const;
+    bool operator!() const;
+
+    bool is_exhausted() const;
+    uint8_t read_byte();
+    data_chunk read_data(size_t size);
+    size_t read_data(uint8_t* data, size_t size);
+    data_chunk read_data_to_eof();
+    hash_digest read_hash();
+    short_hash read_short_hash();
+
+    uint16_t read_2_bytes_little_endian();
+    uint32_t read_4_bytes_little_endian();
+    uint64_t read_8_bytes_little_endian();
+    uint64_t read_variable_uint_little_endian();
+
+    uint16_t read_2_bytes_big_endian();
+    uint32_t read_4_bytes_big_endian();
+    uint64_t read_8_bytes_big_endian();
+    uint64_t read_variable_uint_big_endian();
+
+    std::string read_fixed_string(size_t length);
+    std::string read_string();
+
+private:
+    template <typename Integer>
+    Integer read_little_endian();
+
+    template <typename Integer>
+    Integer read_big_endian();
+
+    reader& source_;
+    sha256_context context_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/histogram.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+
+namespace libbitcoin {
+
+// The upper bound of bucket n.
+static uint64_t limit(size_t bucket)
+{
+    return uint64_t(1) << bucket;
+}
+
+histogram::histogram()
+  : total_(0)
+{
+    reset();
+}
+
+size_t histogram::bucket(uint64_t microseconds)
+{
+    size_t bucket = 0;
+    while (bucket < buckets - 1 && microseconds >= limit(bucket))
+        ++bucket;
+
+    return bucket;
+}
+
+void histogram::record(const duration& elapsed)
+{
+    const auto microseconds = elapsed.count() < 0 ? 0 :
+        static_cast<uint64_t>(elapsed.count());
+
+    total_.fetch_add(microseconds, std::memory_order_relaxed);
+    counts_[bucket(microseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void histogram::record(const clock::time_point& start)
+{
+    record(std::chrono::duration_cast<duration>(clock::now() - start));
+}
+
+size_t histogram::count() const
+{
+    size_t total = 0;
+    for (const auto& count: counts_)
+        total += count.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+size_t histogram::count(size_t bucket) const
+{
+    BITCOIN_ASSERT(bucket < buckets);
+    return counts_[bucket].load(std::memory_order_relaxed);
+}
+
+histogram::duration histogram::mean() const
+{
+    const auto samples = count();
+    if (samples == 0)
+        return duration(0);
+
+    const auto total = total_.load(std::memory_order_relaxed);
+    return duration(static_cast<duration::rep>(total / samples));
+}
+
+histogram::duration histogram::percentile(double fraction) const
+{
+    BITCOIN_ASSERT(fraction >= 0.0 && fraction <= 1.0);
+    const auto samples = count();
+    if (samples == 0)
+        return duration(0);
+
+    // The rank of the sample at the fraction, counting from one.
+    const auto rank = static_cast<size_t>(std::ceil(fraction * samples));
+    const auto target = std::max(rank, size_t(1));
+
+    size_t seen = 0;
+    for (size_t bucket = 0; bucket < buckets - 1; ++bucket)
+    {
+        seen += count(bucket);
+        if (seen >= target)
+            return duration(static_cast<duration::rep>(limit(bucket)));
+    }
+
+    return duration::max();
+}
+
+void histogram::reset()
+{
+    total_.store(0, std::memory_order_relaxed);
+    for (auto& count: counts_)
+        count.store(0, std::memory_order_relaxed);
+}
+
+std::ostream& operator<<(std::ostream& output, const histogram& histogram)
+{
+    output
+        << "count " << histogram.count()
+        << ", mean " << histogram.mean().count() << "us"
+        << ", p50 <" << histogram.percentile(0.50).count() << "us"
+        << ", p90 <" << histogram.percentile(0.90).count() << "us"
+        << ", p99 <" << histogram.percentile(0.99).count() << "us";
+    return output;
+}
+
+} // namespace libbitcoin
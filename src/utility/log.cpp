@@ -31,7 +31,7 @@
 namespace libbitcoin {
 
 log::log(level value, const std::string& domain)
-  : level_(value), domain_(domain)
+  : level_(value), enabled_(enabled(value)), domain_(domain)
 {
 }
 
@@ -40,6 +40,7 @@ log::log(level value, const std::string& domain)
 // gcc.gnu.org/bugzilla/show_bug.cgi?id=54316
 log::log(log&& other)
   : level_(other.level_),
+    enabled_(other.enabled_),
     domain_(std::move(other.domain_)),
     stream_(other.stream_.str())
 {
@@ -47,13 +48,25 @@ log::log(log&& other)
 
 log::~log()
 {
-    if (destinations_.count(level_) != 0)
-        destinations_[level_](level_, domain_, stream_.str());
+    if (!enabled_)
+        return;
+
+    const auto destination = destinations_.find(level_);
+    if (destination != destinations_.end())
+        destination->second(level_, domain_, stream_.str());
+}
+
+bool log::enabled(level value)
+{
+    return destinations_.count(value) != 0;
 }
 
 void log::set_output_function(functor value)
 {
-    destinations_[level_] = value;
+    if (value)
+        destinations_[level_] = value;
+    else
+        destinations_.erase(level_);
 }
 
 void log::clear()
@@ -122,10 +135,6 @@ void log::to_stream(std::ostream& out, level value, const std::string& domain,
     out.flush();
 }
 
-void log::output_ignore(level, const std::string&, const std::string&)
-{
-}
-
 void log::output_cout(level value, const std::string& domain,
     const std::string& body)
 {
@@ -138,12 +147,11 @@ void log::output_cerr(level value, const std::string& domain,
     to_stream(bc::cerr, value, domain, body);
 }
 
+// Debug output is disabled by default in release builds.
 log::destinations log::destinations_
 {
 #ifdef DEBUG
     std::make_pair(level::debug, output_cout),
-#else
-    std::make_pair(level::debug, output_ignore),
 #endif
     std::make_pair(level::info, output_cout),
     std::make_pair(level::warning, output_cerr),
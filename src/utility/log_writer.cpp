@@ -0,0 +1,332 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/log_writer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/date_time.hpp>
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/thread/tss.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/log.hpp>
+
+namespace libbitcoin {
+
+static constexpr size_t levels = static_cast<size_t>(log::level::null);
+static constexpr size_t cache_line = 64;
+
+// Writers are distinguished by identity rather than address, which may be
+// reused once a writer is destroyed.
+static std::atomic<uint64_t> identities(0);
+
+// A record occupies one fixed size slot of a ring.
+struct record
+{
+    int64_t time;
+    log::level level;
+    uint16_t domain_size;
+    uint16_t body_size;
+    bool truncated;
+    char text[log_writer::record_text];
+};
+
+// A single producer single consumer ring of records. The producer is the
+// thread that owns the ring, and the consumer is the writer thread.
+class log_writer::ring
+{
+public:
+    ring(uint64_t owner, size_t capacity)
+      : owner(owner), retired(false), head_(0), tail_(0),
+        mask_(capacity - 1), records_(capacity)
+    {
+        BITCOIN_ASSERT((capacity & mask_) == 0);
+    }
+
+    // Called only by the owning thread.
+    bool push(log::level level, const std::string& domain,
+        const std::string& body)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_)
+            return false;
+
+        auto& entry = records_[head & mask_];
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        entry.time = std::chrono::duration_cast<std::chrono::microseconds>(
+            now).count();
+        entry.level = level;
+
+        const size_t limit = record_text;
+        const auto domain_size = std::min(domain.size(), limit);
+        const auto body_size = std::min(body.size(), limit - domain_size);
+        entry.domain_size = static_cast<uint16_t>(domain_size);
+        entry.body_size = static_cast<uint16_t>(body_size);
+        entry.truncated = domain_size + body_size <
+            domain.size() + body.size();
+        std::memcpy(entry.text, domain.data(), domain_size);
+        std::memcpy(entry.text + domain_size, body.data(), body_size);
+
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Called only by the writer thread.
+    template <typename Handler>
+    size_t pop(Handler handler)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto head = head_.load(std::memory_order_acquire);
+
+        for (auto index = tail; index != head; ++index)
+            handler(records_[index & mask_]);
+
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) ==
+            tail_.load(std::memory_order_acquire);
+    }
+
+    const uint64_t owner;
+    std::atomic<bool> retired;
+
+private:
+    // The indexes are separated to avoid false sharing between threads.
+    std::atomic<size_t> head_;
+    char head_padding_[cache_line];
+    std::atomic<size_t> tail_;
+    char tail_padding_[cache_line];
+    const size_t mask_;
+    std::vector<record> records_;
+};
+
+typedef std::vector<log_writer::ring_ptr> ring_list;
+
+// A thread's rings are retired when the thread exits, and each is removed by
+// its writer once empty.
+static void retire(ring_list* rings)
+{
+    for (const auto& ring: *rings)
+        ring->retired = true;
+
+    delete rings;
+}
+
+// Each thread retains a ring for each writer to which it has logged.
+static boost::thread_specific_ptr<ring_list> thread_rings(retire);
+
+static size_t power_of_two(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+
+    return result;
+}
+
+static std::string to_line(const record& entry,
+    const boost::posix_time::time_duration& offset)
+{
+    static const boost::posix_time::ptime epoch(
+        boost::gregorian::date(1970, 1, 1));
+
+    const auto time = epoch + offset +
+        boost::posix_time::microseconds(entry.time);
+
+    std::string line;
+    line.reserve(32 + entry.domain_size + entry.body_size);
+    line += boost::posix_time::to_simple_string(time.time_of_day());
+    line += " ";
+    line += log::to_text(entry.level);
+    line += " [";
+    line.append(entry.text, entry.domain_size);
+    line += "] ";
+    line.append(entry.text + entry.domain_size, entry.body_size);
+
+    if (entry.truncated)
+        line += "...";
+
+    line += "\n";
+    return line;
+}
+
+log_writer::log_writer(sink output, size_t capacity,
+    std::chrono::milliseconds interval)
+  : identity_(++identities),
+    capacity_(power_of_two(std::max(capacity, size_t(2)))),
+    interval_(interval),
+    sink_(output),
+    dropped_(0),
+    reported_(0),
+    stopped_(false),
+    thread_(std::bind(&log_writer::run, this))
+{
+}
+
+log_writer::~log_writer()
+{
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+
+    stopping_.notify_one();
+    thread_.join();
+}
+
+size_t log_writer::dropped() const
+{
+    return dropped_.load();
+}
+
+log_writer::ring_ptr log_writer::local_ring()
+{
+    auto local = thread_rings.get();
+    if (local == nullptr)
+    {
+        local = new ring_list;
+        thread_rings.reset(local);
+    }
+
+    for (const auto& ring: *local)
+        if (ring->owner == identity_)
+            return ring;
+
+    // The ring of a destroyed writer is held only by the thread.
+    const auto orphaned = [](const ring_ptr& ring)
+    {
+        return ring.use_count() == 1;
+    };
+
+    local->erase(std::remove_if(local->begin(), local->end(), orphaned),
+        local->end());
+
+    const auto ring = std::make_shared<log_writer::ring>(identity_,
+        capacity_);
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.push_back(ring);
+    }
+
+    local->push_back(ring);
+    return ring;
+}
+
+void log_writer::write(log::level level, const std::string& domain,
+    const std::string& body)
+{
+    // Records without a body (such as those of the temporaries that set the
+    // output functions) are not written.
+    if (body.empty())
+        return;
+
+    if (!local_ring()->push(level, domain, body))
+        ++dropped_;
+}
+
+// Format all queued records into one batch per level and pass each to the
+// sink. Returns the number of records written.
+size_t log_writer::drain()
+{
+    std::vector<ring_ptr> rings;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto unused = [](const ring_ptr& ring)
+        {
+            return ring->retired && ring->empty();
+        };
+
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(), unused),
+            rings_.end());
+        rings = rings_;
+    }
+
+    // The local time offset is computed once per batch.
+    const auto utc = boost::posix_time::microsec_clock::universal_time();
+    const auto offset = boost::date_time::c_local_adjustor<
+        boost::posix_time::ptime>::utc_to_local(utc) - utc;
+
+    std::array<std::string, levels> batches;
+    const auto append = [&batches, &offset](const record& entry)
+    {
+        batches[static_cast<size_t>(entry.level)] += to_line(entry, offset);
+    };
+
+    size_t written = 0;
+    for (const auto& ring: rings)
+        written += ring->pop(append);
+
+    const auto dropped = dropped_.load();
+    if (dropped != reported_)
+    {
+        const auto local = (utc + offset).time_of_day();
+        const auto level = static_cast<size_t>(log::level::warning);
+        batches[level] += boost::posix_time::to_simple_string(local) +
+            " WARNING [log] Dropped " + std::to_string(dropped - reported_) +
+            " records.\n";
+        reported_ = dropped;
+    }
+
+    for (size_t level = 0; level < levels; ++level)
+        if (!batches[level].empty())
+            sink_(static_cast<log::level>(level), batches[level]);
+
+    return written;
+}
+
+void log_writer::run()
+{
+    while (true)
+    {
+        const auto written = drain();
+
+        // The stop is checked on every pass, as records may never cease.
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopped_)
+            break;
+
+        if (written == 0)
+            stopping_.wait_for(lock, interval_);
+    }
+
+    // Drain records queued while the stop was being signaled.
+    drain();
+}
+
+} // namespace libbitcoin
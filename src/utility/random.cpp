@@ -19,12 +19,17 @@
  */
 #include <bitcoin/bitcoin/utility/random.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <random>
 #include <boost/date_time.hpp>
+#include <boost/thread/tss.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 
 namespace libbitcoin {
 
@@ -33,17 +38,157 @@ using namespace boost::posix_time;
 // DO NOT USE srand() and rand() on MSVC as srand must be called per thread.
 // As a result it is difficult to use safely.
 
-// Not fully testable due to lack of random engine injection.
+// An OS keyed engine is rekeyed after this many blocks (4MiB of output).
+static constexpr uint64_t rekey_blocks = 65536;
+
+// The ChaCha20 constant "expand 32-byte k".
+static constexpr std::array<uint32_t, 4> sigma
+{
+    { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 }
+};
+
+static uint32_t rotate_left(uint32_t value, size_t shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+static void quarter_round(std::array<uint32_t, 16>& state, size_t a,
+    size_t b, size_t c, size_t d)
+{
+    state[a] += state[b];
+    state[d] = rotate_left(state[d] ^ state[a], 16);
+    state[c] += state[d];
+    state[b] = rotate_left(state[b] ^ state[c], 12);
+    state[a] += state[b];
+    state[d] = rotate_left(state[d] ^ state[a], 8);
+    state[c] += state[d];
+    state[b] = rotate_left(state[b] ^ state[c], 7);
+}
+
 // This may be truly random depending on the underlying device.
-uint64_t pseudo_random()
+static hash_digest operating_system_key()
 {
     std::random_device device;
-    std::uniform_int_distribution<uint64_t> distribution;
-    return distribution(device);
+    std::uniform_int_distribution<uint32_t> distribution;
+
+    hash_digest key;
+    for (size_t index = 0; index < key.size(); index += sizeof(uint32_t))
+    {
+        const auto bytes = to_little_endian(distribution(device));
+        std::copy(bytes.begin(), bytes.end(), key.begin() + index);
+    }
+
+    return key;
+}
+
+random_engine::~random_engine()
+{
+}
+
+chacha20_engine::chacha20_engine()
+  : reseed_(true), counter_(0), index_(0)
+{
+    rekey(operating_system_key());
+}
+
+chacha20_engine::chacha20_engine(const hash_digest& key)
+  : reseed_(false), counter_(0), index_(0)
+{
+    rekey(key);
+}
+
+void chacha20_engine::rekey(const hash_digest& key)
+{
+    for (size_t word = 0; word < key_.size(); ++word)
+        key_[word] = from_little_endian_unsafe<uint32_t>(
+            key.begin() + word * sizeof(uint32_t));
+
+    counter_ = 0;
+    generate();
+}
+
+// Produce the keystream block for the current counter.
+void chacha20_engine::generate()
+{
+    std::array<uint32_t, 16> state;
+    std::copy(sigma.begin(), sigma.end(), state.begin());
+    std::copy(key_.begin(), key_.end(), state.begin() + 4);
+    state[12] = static_cast<uint32_t>(counter_);
+    state[13] = static_cast<uint32_t>(counter_ >> 32);
+    state[14] = 0;
+    state[15] = 0;
+
+    block_ = state;
+    for (size_t round = 0; round < 10; ++round)
+    {
+        quarter_round(block_, 0, 4, 8, 12);
+        quarter_round(block_, 1, 5, 9, 13);
+        quarter_round(block_, 2, 6, 10, 14);
+        quarter_round(block_, 3, 7, 11, 15);
+        quarter_round(block_, 0, 5, 10, 15);
+        quarter_round(block_, 1, 6, 11, 12);
+        quarter_round(block_, 2, 7, 8, 13);
+        quarter_round(block_, 3, 4, 9, 14);
+    }
+
+    for (size_t word = 0; word < block_.size(); ++word)
+        block_[word] += state[word];
+
+    ++counter_;
+    index_ = 0;
+}
+
+uint64_t chacha20_engine::next()
+{
+    if (index_ == block_.size())
+    {
+        if (reseed_ && counter_ == rekey_blocks)
+            rekey(operating_system_key());
+        else
+            generate();
+    }
+
+    const uint64_t low = block_[index_++];
+    const uint64_t high = block_[index_++];
+    return low | (high << 32);
+}
+
+// The default engine of each thread is created on first use.
+static boost::thread_specific_ptr<random_engine> default_engines;
+
+// Injected engines are not owned, so are not deleted on thread exit.
+static void release(random_engine*)
+{
+}
+
+static boost::thread_specific_ptr<random_engine> injected_engines(release);
+
+static random_engine& engine()
+{
+    const auto injected = injected_engines.get();
+    if (injected != nullptr)
+        return *injected;
+
+    auto current = default_engines.get();
+    if (current == nullptr)
+    {
+        current = new chacha20_engine();
+        default_engines.reset(current);
+    }
+
+    return *current;
+}
+
+void set_pseudo_random_engine(random_engine* engine)
+{
+    injected_engines.reset(engine);
+}
+
+uint64_t pseudo_random()
+{
+    return engine().next();
 }
 
-// Not fully testable due to lack of random engine injection.
-// This may be truly random depending on the underlying device.
 uint64_t nonzero_pseudo_random()
 {
     for (auto index = 0; index < 100; ++index)
@@ -57,21 +202,17 @@ uint64_t nonzero_pseudo_random()
     throw std::runtime_error("The RNG produces 100 consecutive zero values.");
 }
 
-// Not fully testable due to lack of random engine injection.
-// This may be truly random depending on the underlying device.
 void pseudo_random_fill(data_chunk& chunk)
 {
-    std::random_device device;
-    std::uniform_int_distribution<uint16_t> distribution;
-    for (uint8_t& byte: chunk)
+    auto& source = engine();
+    for (size_t index = 0; index < chunk.size(); index += sizeof(uint64_t))
     {
-        // uniform_int_distribution is undefined for sizes < 16 bits,
-        // so we generate a 16 bit value and reduce it to 8 bits.
-        byte = distribution(device) % std::numeric_limits<uint8_t>::max();
+        const auto bytes = to_little_endian(source.next());
+        const auto size = std::min(sizeof(uint64_t), chunk.size() - index);
+        std::copy(bytes.begin(), bytes.begin() + size, chunk.begin() + index);
     }
 }
 
-// Not fully testable due to lack of random engine injection.
 // Randomly select a time duration in the range [expiration/ratio, expiration].
 time_duration pseudo_randomize(const time_duration& expiration, uint8_t ratio)
 {
@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/slice_reader.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+slice_reader::slice_reader(data_slice data)
+  : begin_(data.begin()), end_(data.end()), position_(data.begin()),
+    valid_(true)
+{
+}
+
+slice_reader::operator bool() const
+{
+    return valid_;
+}
+
+bool slice_reader::operator!() const
+{
+    return !valid_;
+}
+
+bool slice_reader::is_exhausted() const
+{
+    return valid_ && position_ == end_;
+}
+
+size_t slice_reader::position() const
+{
+    return static_cast<size_t>(position_ - begin_);
+}
+
+const uint8_t* slice_reader::advance(uint64_t size)
+{
+    const auto remaining = static_cast<uint64_t>(end_ - position_);
+
+    if (!valid_ || size > remaining)
+    {
+        valid_ = false;
+        return nullptr;
+    }
+
+    const auto result = position_;
+    position_ += static_cast<size_t>(size);
+    return result;
+}
+
+data_slice slice_reader::read_slice(uint64_t size)
+{
+    const auto data = advance(size);
+
+    if (data == nullptr)
+        return data_slice(end_, end_);
+
+    return data_slice(data, data + static_cast<size_t>(size));
+}
+
+uint8_t slice_reader::read_byte()
+{
+    const auto data = advance(1);
+
+    if (data == nullptr)
+        return 0;
+
+    return *data;
+}
+
+// As a stream, a short read provides the remaining bytes (and fails).
+size_t slice_reader::available(size_t size) const
+{
+    if (!valid_)
+        return 0;
+
+    return std::min(size, static_cast<size_t>(end_ - position_));
+}
+
+size_t slice_reader::read_data(uint8_t* data, size_t size)
+{
+    const auto read_size = available(size);
+    std::copy(position_, position_ + read_size, data);
+    advance(size);
+    return read_size;
+}
+
+data_chunk slice_reader::read_data(size_t size)
+{
+    data_chunk result(position_, position_ + available(size));
+    advance(size);
+    return result;
+}
+
+data_chunk slice_reader::read_data_to_eof()
+{
+    return read_data(static_cast<size_t>(end_ - position_));
+}
+
+hash_digest slice_reader::read_hash()
+{
+    hash_digest result{ {} };
+    read_data(result.data(), result.size());
+    return result;
+}
+
+short_hash slice_reader::read_short_hash()
+{
+    short_hash result{ {} };
+    read_data(result.data(), result.size());
+    return result;
+}
+
+template <typename Integer>
+Integer slice_reader::read_little_endian()
+{
+    const auto data = advance(sizeof(Integer));
+
+    if (data == nullptr)
+        return 0;
+
+    return from_little_endian_unsafe<Integer>(data);
+}
+
+template <typename Integer>
+Integer slice_reader::read_big_endian()
+{
+    const auto data = advance(sizeof(Integer));
+
+    if (data == nullptr)
+        return 0;
+
+    return from_big_endian_unsafe<Integer>(data);
+}
+
+uint16_t slice_reader::read_2_bytes_little_endian()
+{
+    return read_little_endian<uint16_t>();
+}
+
+uint32_t slice_reader::read_4_bytes_little_endian()
+{
+    return read_little_endian<uint32_t>();
+}
+
+uint64_t slice_reader::read_8_bytes_little_endian()
+{
+    return read_little_endian<uint64_t>();
+}
+
+uint64_t slice_reader::read_variable_uint_little_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_little_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_little_endian();
+
+    // length should be 0xff
+    return read_8_bytes_little_endian();
+}
+
+uint16_t slice_reader::read_2_bytes_big_endian()
+{
+    return read_big_endian<uint16_t>();
+}
+
+uint32_t slice_reader::read_4_bytes_big_endian()
+{
+    return read_big_endian<uint32_t>();
+}
+
+uint64_t slice_reader::read_8_bytes_big_endian()
+{
+    return read_big_endian<uint64_t>();
+}
+
+uint64_t slice_reader::read_variable_uint_big_endian()
+{
+    const auto length = read_byte();
+    if (length < 0xfd)
+        return length;
+    else if (length == 0xfd)
+        return read_2_bytes_big_endian();
+    else if (length == 0xfe)
+        return read_4_bytes_big_endian();
+
+    // length should be 0xff
+    return read_8_bytes_big_endian();
+}
+
+std::string slice_reader::read_fixed_string(size_t length)
+{
+    const auto data = read_slice(length);
+    const std::string result(data.begin(), data.end());
+
+    // Removes trailing 0s... Needed for string comparisons
+    return result.c_str();
+}
+
+std::string slice_reader::read_string()
+{
+    const auto data = read_slice(read_variable_uint_little_endian());
+    const std::string result(data.begin(), data.end());
+    return result.c_str();
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/slice_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+slice_writer::slice_writer(uint8_t* begin, uint8_t* end)
+  : begin_(begin), end_(end), position_(begin), valid_(true)
+{
+}
+
+slice_writer::slice_writer(data_chunk& data)
+  : slice_writer(data.data(), data.data() + data.size())
+{
+}
+
+slice_writer::operator bool() const
+{
+    return valid_;
+}
+
+bool slice_writer::operator!() const
+{
+    return !valid_;
+}
+
+size_t slice_writer::position() const
+{
+    return static_cast<size_t>(position_ - begin_);
+}
+
+bool slice_writer::is_exhausted() const
+{
+    return valid_ && position_ == end_;
+}
+
+uint8_t* slice_writer::advance(size_t size)
+{
+    if (!valid_ || size > static_cast<size_t>(end_ - position_))
+    {
+        valid_ = false;
+        return nullptr;
+    }
+
+    const auto result = position_;
+    position_ += size;
+    return result;
+}
+
+void slice_writer::write_byte(uint8_t value)
+{
+    const auto data = advance(1);
+
+    if (data != nullptr)
+        *data = value;
+}
+
+void slice_writer::write_data(const data_chunk& data)
+{
+    write_data(data.data(), data.size());
+}
+
+void slice_writer::write_data(const uint8_t* data, size_t size)
+{
+    const auto out = advance(size);
+
+    if (out != nullptr)
+        std::copy(data, data + size, out);
+}
+
+void slice_writer::write_hash(const hash_digest& value)
+{
+    write_data(value.data(), value.size());
+}
+
+void slice_writer::write_short_hash(const short_hash& value)
+{
+    write_data(value.data(), value.size());
+}
+
+template <typename Integer>
+void slice_writer::write_little_endian(Integer value)
+{
+    const auto out = advance(sizeof(Integer));
+
+    if (out == nullptr)
+        return;
+
+    for (size_t index = 0; index < sizeof(Integer); ++index)
+    {
+        out[index] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+template <typename Integer>
+void slice_writer::write_big_endian(Integer value)
+{
+    const auto out = advance(sizeof(Integer));
+
+    if (out == nullptr)
+        return;
+
+    for (size_t index = sizeof(Integer); index > 0; --index)
+    {
+        out[index - 1] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+void slice_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    write_little_endian<uint16_t>(value);
+}
+
+void slice_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    write_little_endian<uint32_t>(value);
+}
+
+void slice_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    write_little_endian<uint64_t>(value);
+}
+
+void slice_writer::write_variable_uint_little_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_little_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_little_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void slice_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    write_big_endian<uint16_t>(value);
+}
+
+void slice_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    write_big_endian<uint32_t>(value);
+}
+
+void slice_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    write_big_endian<uint64_t>(value);
+}
+
+void slice_writer::write_variable_uint_big_endian(uint64_t value)
+{
+    if (value < 0xfd)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= 0xffff)
+    {
+        write_byte(0xfd);
+        write_2_bytes_big_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= 0xffffffff)
+    {
+        write_byte(0xfe);
+        write_4_bytes_big_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(0xff);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void slice_writer::write_fixed_string(const std::string& value, size_t size)
+{
+    const auto out = advance(size);
+
+    if (out == nullptr)
+        return;
+
+    const auto copy_size = std::min(size, value.size());
+    std::copy_n(value.begin(), copy_size, out);
+    std::fill(out + copy_size, out + size, 0);
+}
+
+void slice_writer::write_string(const std::string& value)
+{
+    write_variable_uint_little_endian(value.size());
+    write_data(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "stack_element.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+stack_element::stack_element()
+  : size_(0), capacity_(0)
+{
+}
+
+stack_element::stack_element(data_slice data)
+  : stack_element()
+{
+    assign(data);
+}
+
+stack_element::stack_element(const stack_element& other)
+  : stack_element()
+{
+    assign(other);
+}
+
+stack_element::stack_element(stack_element&& other)
+  : stack_element()
+{
+    *this = std::move(other);
+}
+
+stack_element& stack_element::operator=(const stack_element& other)
+{
+    if (this != &other)
+        assign(other);
+
+    return *this;
+}
+
+// The buffers are exchanged so that neither allocation is released.
+stack_element& stack_element::operator=(stack_element&& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.size_ <= inline_capacity)
+        std::copy(other.inline_, other.inline_ + other.size_, inline_);
+
+    std::swap(heap_, other.heap_);
+    std::swap(capacity_, other.capacity_);
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+}
+
+void stack_element::assign(data_slice data)
+{
+    const auto size = data.size();
+
+    if (size <= inline_capacity)
+    {
+        std::copy(data.begin(), data.end(), inline_);
+    }
+    else
+    {
+        if (size > capacity_)
+        {
+            heap_.reset(new uint8_t[size]);
+            capacity_ = size;
+        }
+
+        std::copy(data.begin(), data.end(), heap_.get());
+    }
+
+    size_ = size;
+}
+
+const uint8_t* stack_element::data() const
+{
+    if (size_ <= inline_capacity)
+        return inline_;
+
+    return heap_.get();
+}
+
+const uint8_t* stack_element::begin() const
+{
+    return data();
+}
+
+const uint8_t* stack_element::end() const
+{
+    return data() + size_;
+}
+
+size_t stack_element::size() const
+{
+    return size_;
+}
+
+bool stack_element::empty() const
+{
+    return size_ == 0;
+}
+
+bool stack_element::operator==(const stack_element& other) const
+{
+    return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+}
+
+bool stack_element::operator!=(const stack_element& other) const
+{
+    return !(*this == other);
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_STACK_ELEMENT_HPP
+#define LIBBITCOIN_STACK_ELEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/**
+ * A script stack item with inline storage for up to 75 bytes, which covers
+ * numbers, hashes, public keys and signatures without heap allocation.
+ * Larger items use a heap buffer which is retained when the element is
+ * reassigned, and which moves (or swaps) with the element.
+ */
+class BC_API stack_element
+{
+public:
+    static BC_CONSTEXPR size_t inline_capacity = 75;
+
+    stack_element();
+    explicit stack_element(data_slice data);
+    stack_element(const stack_element& other);
+    stack_element(stack_element&& other);
+    stack_element& operator=(const stack_element& other);
+    stack_element& operator=(stack_element&& other);
+
+    /// Replace the value, reusing existing storage where possible.
+    void assign(data_slice data);
+
+    const uint8_t* data() const;
+    const uint8_t* begin() const;
+    const uint8_t* end() const;
+    size_t size() const;
+    bool empty() const;
+
+    bool operator==(const stack_element& other) const;
+    bool operator!=(const stack_element& other) const;
+
+private:
+    size_t size_;
+    size_t capacity_;
+    std::unique_ptr<uint8_t[]> heap_;
+    uint8_t inline_[inline_capacity];
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -80,6 +80,11 @@ void threadpool::join()
     service_.reset();
 }
 
+size_t threadpool::size() const
+{
+    return threads_.size();
+}
+
 asio::service& threadpool::service()
 {
     return service_;
@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/timer_wheel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/network/asio.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/deadline.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+using std::placeholders::_1;
+
+// The first level has 256 slots of one tick, each further level has 64 slots
+// of the span of the level below, so four levels span 2^26 ticks. A timer is
+// placed in the lowest level that spans its delay and cascades down a level
+// each time the level below wraps. Longer delays are placed at the full span
+// and reinserted upon reaching it.
+static constexpr size_t first_bits = 8;
+static constexpr size_t level_bits = 6;
+static constexpr size_t levels = 4;
+static constexpr size_t first_slots = size_t(1) << first_bits;
+static constexpr size_t level_slots = size_t(1) << level_bits;
+static constexpr size_t total_slots = first_slots +
+    (levels - 1) * level_slots;
+
+// The number of low bits of a tick below the slot index of the level.
+static size_t shift(size_t level)
+{
+    return level == 0 ? 0 : first_bits + (level - 1) * level_bits;
+}
+
+// The number of ticks spanned by the level, and those below it.
+static uint64_t span(size_t level)
+{
+    return uint64_t(1) << (first_bits + level * level_bits);
+}
+
+// The index into the slot vector of the level's slot for the tick.
+static size_t index(size_t level, uint64_t tick)
+{
+    if (level == 0)
+        return tick % first_slots;
+
+    const auto offset = first_slots + (level - 1) * level_slots;
+    return offset + ((tick >> shift(level)) % level_slots);
+}
+
+// A timer is pending while it is in a slot. Its expiration may be advanced
+// without the lock, as it is only compared when its slot is reached. The
+// generation changes upon each schedule and cancel, so that an expired
+// handler is not invoked once its timer has been canceled or rescheduled.
+class timer_wheel::timer
+{
+public:
+    timer()
+      : when(0), pending(false), slot(0), position(0), generation(0)
+    {
+    }
+
+    std::atomic<uint64_t> when;
+    handler handle;
+    bool pending;
+    size_t slot;
+    size_t position;
+    uint64_t generation;
+};
+
+// An expired handler, with the generation of its timer upon expiry.
+struct expiry
+{
+    timer_wheel::handle timer;
+    uint64_t generation;
+    timer_wheel::handler handle;
+};
+
+timer_wheel::timer_wheel(threadpool& pool, const asio::duration& resolution)
+  : resolution_(resolution),
+    deadline_(std::make_shared<deadline>(pool, resolution)),
+    current_(0),
+    stopped_(true),
+    size_(0),
+    slots_(total_slots)
+{
+    BITCOIN_ASSERT(resolution.total_microseconds() > 0);
+}
+
+void timer_wheel::start()
+{
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopped_)
+            return;
+
+        stopped_ = false;
+    }
+
+    deadline_->start(
+        std::bind(&timer_wheel::handle_tick,
+            shared_from_this(), _1));
+}
+
+void timer_wheel::stop()
+{
+    std::vector<slot> released(total_slots);
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        size_ = 0;
+        released.swap(slots_);
+
+        for (auto& slot: released)
+            for (auto& timer: slot)
+            {
+                timer->pending = false;
+                timer->handle = nullptr;
+            }
+    }
+
+    deadline_->cancel();
+}
+
+void timer_wheel::handle_tick(const code& ec)
+{
+    if (ec)
+        return;
+
+    tick();
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_)
+            return;
+    }
+
+    deadline_->start(
+        std::bind(&timer_wheel::handle_tick,
+            shared_from_this(), _1));
+}
+
+// The delay in ticks, rounded up and at least one.
+uint64_t timer_wheel::ticks(const asio::duration& delay) const
+{
+    const auto period = resolution_.total_microseconds();
+    const auto micro = std::max(delay.total_microseconds(), int64_t(1));
+    return static_cast<uint64_t>((micro + period - 1) / period);
+}
+
+timer_wheel::handle timer_wheel::schedule(const asio::duration& delay,
+    handler handle)
+{
+    const auto timer = std::make_shared<timer_wheel::timer>();
+    schedule(timer, delay, handle);
+    return timer;
+}
+
+void timer_wheel::schedule(const handle& timer, const asio::duration& delay,
+    handler handle)
+{
+    BITCOIN_ASSERT(timer);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (timer->pending)
+        remove(timer);
+
+    timer->when = current_ + ticks(delay);
+    timer->handle = handle;
+    ++timer->generation;
+    insert(timer);
+}
+
+// This is lock free, the timer is reinserted when its slot is reached.
+void timer_wheel::touch(const handle& timer, const asio::duration& delay)
+{
+    if (timer)
+        timer->when.store(current_.load() + ticks(delay));
+}
+
+void timer_wheel::cancel(const handle& timer)
+{
+    if (!timer)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    timer->handle = nullptr;
+    ++timer->generation;
+
+    if (timer->pending)
+        remove(timer);
+}
+
+size_t timer_wheel::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+// Insert into the lowest level that spans the expiration.
+// This must be called under the lock.
+void timer_wheel::insert(const handle& timer)
+{
+    const auto current = current_.load();
+    auto when = std::max(timer->when.load(), current);
+
+    size_t level = 0;
+    while (level < levels - 1 && when - current >= span(level))
+        ++level;
+
+    // Beyond the last level, the timer is reinserted upon reaching its span.
+    if (when - current >= span(level))
+        when = current + span(level) - 1;
+
+    auto& slot = slots_[index(level, when)];
+    timer->pending = true;
+    timer->slot = index(level, when);
+    timer->position = slot.size();
+    slot.push_back(timer);
+    ++size_;
+}
+
+// Remove from the slot by swapping with its last timer.
+// This must be called under the lock.
+void timer_wheel::remove(const handle& timer)
+{
+    BITCOIN_ASSERT(timer->pending);
+    auto& slot = slots_[timer->slot];
+    BITCOIN_ASSERT(slot[timer->position] == timer);
+
+    slot.back()->position = timer->position;
+    slot[timer->position] = std::move(slot.back());
+    slot.pop_back();
+    timer->pending = false;
+    --size_;
+}
+
+// Move the timers of the level's current slot to lower levels.
+// This must be called under the lock.
+void timer_wheel::cascade(size_t level)
+{
+    slot moving;
+    moving.swap(slots_[index(level, current_)]);
+    size_ -= moving.size();
+
+    for (const auto& timer: moving)
+        insert(timer);
+}
+
+void timer_wheel::tick()
+{
+    std::vector<expiry> expired;
+
+    if (true)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto current = ++current_;
+
+        // Each level cascades when the level below it wraps.
+        for (size_t level = 1; level < levels; ++level)
+        {
+            if (current % (uint64_t(1) << shift(level)) != 0)
+                break;
+
+            cascade(level);
+        }
+
+        slot due;
+        due.swap(slots_[index(0, current)]);
+        size_ -= due.size();
+
+        for (const auto& timer: due)
+        {
+            timer->pending = false;
+
+            // The timer was touched since it was inserted.
+            if (timer->when > current)
+            {
+                insert(timer);
+                continue;
+            }
+
+            expired.push_back({ timer, timer->generation,
+                std::move(timer->handle) });
+            timer->handle = nullptr;
+        }
+    }
+
+    // Handlers are invoked outside of the lock, so they may reschedule. A
+    // handler may cancel a timer that expired on the same tick.
+    for (const auto& expiry: expired)
+    {
+        if (true)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (expiry.timer->generation != expiry.generation)
+                continue;
+        }
+
+        expiry.handle(error::success);
+    }
+}
+
+} // namespace libbitcoin
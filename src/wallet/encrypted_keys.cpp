@@ -22,17 +22,24 @@
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/scrypt.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel_for.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include "parse_encrypted_keys/parse_encrypted_key.hpp"
@@ -125,22 +132,35 @@ static one_byte point_sign(const one_byte& single, const hash_digest& hash)
 // scrypt_
 // ----------------------------------------------------------------------------
 
-static hash_digest scrypt_token(data_slice data, data_slice salt)
+// Arbitrary scrypt parameters from BIP-38. The contexts retain their working
+// memory, so that a thread reuses it for each of many keys.
+struct scrypt_contexts
 {
-    // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<hash_size>(data, salt, 16384u, 8u, 8u);
+    scrypt_contexts()
+      : slow(16384u, 8u, 8u), fast(1024u, 1u, 1u)
+    {
+    }
+
+    scrypt_context slow;
+    scrypt_context fast;
+};
+
+static hash_digest scrypt_token(scrypt_contexts& contexts, data_slice data,
+    data_slice salt)
+{
+    return contexts.slow.hash<hash_size>(data, salt);
 }
 
-static long_hash scrypt_pair(data_slice data, data_slice salt)
+static long_hash scrypt_pair(scrypt_contexts& contexts, data_slice data,
+    data_slice salt)
 {
-    // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<long_hash_size>(data, salt, 1024u, 1u, 1u);
+    return contexts.fast.hash<long_hash_size>(data, salt);
 }
 
-static long_hash scrypt_private(data_slice data, data_slice salt)
+static long_hash scrypt_private(scrypt_contexts& contexts, data_slice data,
+    data_slice salt)
 {
-    // Arbitrary scrypt parameters from BIP-38.
-    return scrypt<long_hash_size>(data, salt, 16384u, 8u, 8u);
+    return contexts.slow.hash<long_hash_size>(data, salt);
 }
 
 // set_flags
@@ -253,8 +273,9 @@ bool create_key_pair(encrypted_private& out_private,
     if (!address_salt(salt, point_copy, version, compressed))
         return false;
 
+    scrypt_contexts contexts;
     const auto salt_entropy = splice(salt, parse.entropy());
-    const auto derived = split(scrypt_pair(point, salt_entropy));
+    const auto derived = split(scrypt_pair(contexts, point, salt_entropy));
     const auto flags = set_flags(compressed, parse.lot_sequence(), true);
 
     if (!create_public_key(out_public, flags, salt, parse.entropy(),
@@ -296,8 +317,9 @@ static bool create_token(encrypted_token& out_token,
     BITCOIN_ASSERT(owner_salt.size() == ek_salt_size ||
         owner_salt.size() == ek_entropy_size);
 
+    scrypt_contexts contexts;
     const auto lot_sequence = owner_salt.size() == ek_salt_size;
-    auto factor = scrypt_token(normal(passphrase), owner_salt);
+    auto factor = scrypt_token(contexts, normal(passphrase), owner_salt);
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, owner_entropy));
@@ -343,14 +365,16 @@ bool create_token(encrypted_token& out_token, const std::string& passphrase,
 // encrypt
 // ----------------------------------------------------------------------------
 
-bool encrypt(encrypted_private& out_private, const ec_secret& secret,
+static bool encrypt_private(scrypt_contexts& contexts,
+    encrypted_private& out_private, const ec_secret& secret,
     const std::string& passphrase, uint8_t version, bool compressed)
 {
     ek_salt salt;
     if (!address_salt(salt, secret, version, compressed))
         return false;
 
-    const auto derived = split(scrypt_private(normal(passphrase), salt));
+    const auto derived = split(scrypt_private(contexts, normal(passphrase),
+        salt));
     const auto prefix = parse_encrypted_private::prefix_factory(version,
         false);
 
@@ -370,13 +394,23 @@ bool encrypt(encrypted_private& out_private, const ec_secret& secret,
     });
 }
 
+bool encrypt(encrypted_private& out_private, const ec_secret& secret,
+    const std::string& passphrase, uint8_t version, bool compressed)
+{
+    scrypt_contexts contexts;
+    return encrypt_private(contexts, out_private, secret, passphrase, version,
+        compressed);
+}
+
 // decrypt private_key
 // ----------------------------------------------------------------------------
 
-static bool decrypt_multiplied(ec_secret& out_secret,
-    const parse_encrypted_private& parse, const std::string& passphrase)
+static bool decrypt_multiplied(scrypt_contexts& contexts,
+    ec_secret& out_secret, const parse_encrypted_private& parse,
+    const std::string& passphrase)
 {
-    auto secret = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto secret = scrypt_token(contexts, normal(passphrase),
+        parse.owner_salt());
 
     if (parse.lot_sequence())
         secret = bitcoin_hash(splice(secret, parse.entropy()));
@@ -386,7 +420,7 @@ static bool decrypt_multiplied(ec_secret& out_secret,
         return false;
 
     const auto salt_entropy = splice(parse.salt(), parse.entropy());
-    const auto derived = split(scrypt_pair(point, salt_entropy));
+    const auto derived = split(scrypt_pair(contexts, point, salt_entropy));
 
     auto encrypt1 = parse.data1();
     auto encrypt2 = parse.data2();
@@ -411,12 +445,12 @@ static bool decrypt_multiplied(ec_secret& out_secret,
     return true;
 }
 
-static bool decrypt_secret(ec_secret& out_secret,
+static bool decrypt_secret(scrypt_contexts& contexts, ec_secret& out_secret,
     const parse_encrypted_private& parse, const std::string& passphrase)
 {
     auto encrypt1 = splice(parse.entropy(), parse.data1());
     auto encrypt2 = parse.data2();
-    const auto derived = split(scrypt_private(normal(passphrase),
+    const auto derived = split(scrypt_private(contexts, normal(passphrase),
         parse.salt()));
 
     aes256_decrypt(derived.right, encrypt1);
@@ -434,16 +468,17 @@ static bool decrypt_secret(ec_secret& out_secret,
     return true;
 }
 
-bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
-    const encrypted_private& key, const std::string& passphrase)
+static bool decrypt_private(scrypt_contexts& contexts, ec_secret& out_secret,
+    uint8_t& out_version, bool& out_compressed, const encrypted_private& key,
+    const std::string& passphrase)
 {
     const parse_encrypted_private parse(key);
     if (!parse.valid())
         return false;
 
     const auto success = parse.multiplied() ?
-        decrypt_multiplied(out_secret, parse, passphrase) :
-        decrypt_secret(out_secret, parse, passphrase);
+        decrypt_multiplied(contexts, out_secret, parse, passphrase) :
+        decrypt_secret(contexts, out_secret, parse, passphrase);
 
     if (success)
     {
@@ -454,6 +489,14 @@ bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
     return success;
 }
 
+bool decrypt(ec_secret& out_secret, uint8_t& out_version, bool& out_compressed,
+    const encrypted_private& key, const std::string& passphrase)
+{
+    scrypt_contexts contexts;
+    return decrypt_private(contexts, out_secret, out_version, out_compressed,
+        key, passphrase);
+}
+
 // decrypt public_key
 // ----------------------------------------------------------------------------
 
@@ -465,9 +508,11 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
     if (!parse.valid())
         return false;
 
+    scrypt_contexts contexts;
     const auto version = parse.address_version();
     const auto lot_sequence = parse.lot_sequence();
-    auto factor = scrypt_token(normal(passphrase), parse.owner_salt());
+    auto factor = scrypt_token(contexts, normal(passphrase),
+        parse.owner_salt());
 
     if (lot_sequence)
         factor = bitcoin_hash(splice(factor, parse.entropy()));
@@ -477,7 +522,7 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
         return false;
 
     const auto salt_entropy = splice(parse.salt(), parse.entropy());
-    auto derived = split(scrypt_pair(point, salt_entropy));
+    auto derived = split(scrypt_pair(contexts, point, salt_entropy));
     auto encrypt = split(parse.data());
 
     aes256_decrypt(derived.right, encrypt.left);
@@ -500,6 +545,65 @@ bool decrypt(ec_compressed& out_point, uint8_t& out_version,
     return true;
 }
 
+// batch
+// ----------------------------------------------------------------------------
+
+// Each task reuses its own scrypt contexts for the items it claims.
+template <typename Item, typename Result>
+static void run_batch(threadpool& pool, const std::vector<Item>& items,
+    std::function<bool(scrypt_contexts&, const Item&, Result&)> process,
+    std::function<void(const std::vector<Result>&)> complete)
+{
+    const auto inputs = std::make_shared<std::vector<Item>>(items);
+    const auto results = std::make_shared<std::vector<Result>>(items.size());
+
+    const auto run = [inputs, results, process](scrypt_contexts& contexts,
+        size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+        {
+            auto& result = (*results)[index];
+            result.valid = process(contexts, (*inputs)[index], result);
+        }
+    };
+
+    const auto finish = [results, complete]()
+    {
+        complete(*results);
+    };
+
+    parallel_for<scrypt_contexts>(pool, inputs->size(), 1, run, finish);
+}
+
+void encrypt(threadpool& pool, const std::vector<ec_secret>& secrets,
+    const std::string& passphrase, uint8_t version, bool compressed,
+    ek_encryption_handler handler)
+{
+    const auto process = [passphrase, version, compressed](
+        scrypt_contexts& contexts, const ec_secret& secret,
+        ek_encryption& result)
+    {
+        return encrypt_private(contexts, result.key, secret, passphrase,
+            version, compressed);
+    };
+
+    run_batch<ec_secret, ek_encryption>(pool, secrets, process, handler);
+}
+
+void decrypt(threadpool& pool, const std::vector<encrypted_private>& keys,
+    const std::string& passphrase, ek_decryption_handler handler)
+{
+    const auto process = [passphrase](scrypt_contexts& contexts,
+        const encrypted_private& key, ek_decryption& result)
+    {
+        return decrypt_private(contexts, result.secret, result.version,
+            result.compressed, key, passphrase);
+    };
+
+    run_batch<encrypted_private, ek_decryption>(pool, keys, process,
+        handler);
+}
+
 #endif // WITH_ICU
 
 } // namespace wallet
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "hd_parent.hpp"
+
+#include <cstdint>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/wallet/hd_public.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+static uint32_t fingerprint(const ec_compressed& point)
+{
+    const auto message_digest = bitcoin_short_hash(point);
+    return from_big_endian_unsafe<uint32_t>(message_digest.begin());
+}
+
+hd_parent::hd_parent(const hd_chain_code& chain_code,
+    const ec_compressed& point, const hd_lineage& lineage)
+  : hmac_(chain_code), point_(point), lineage_(lineage),
+    fingerprint_(fingerprint(point))
+{
+}
+
+bool hd_parent::derivable() const
+{
+    return lineage_.depth != max_uint8;
+}
+
+const ec_compressed& hd_parent::point() const
+{
+    return point_;
+}
+
+hd_lineage hd_parent::lineage(uint32_t index) const
+{
+    return
+    {
+        lineage_.prefixes,
+        static_cast<uint8_t>(lineage_.depth + 1),
+        fingerprint_,
+        index
+    };
+}
+
+long_hash hd_parent::public_hash(uint32_t index) const
+{
+    auto context = hmac_;
+    context.update(point_);
+    return finalize(context, index);
+}
+
+long_hash hd_parent::private_hash(const ec_secret& secret,
+    uint32_t index) const
+{
+    static const uint8_t depth = 0;
+
+    auto context = hmac_;
+    context.update(&depth, sizeof(depth));
+    context.update(secret);
+    return finalize(context, index);
+}
+
+long_hash hd_parent::finalize(hmac_sha512_context& context,
+    uint32_t index) const
+{
+    context.update(to_big_endian(index));
+    return context.digest();
+}
+
+} // namespace wallet
+} // namespace libbitcoin
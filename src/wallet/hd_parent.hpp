@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_HD_PARENT_HPP
+#define LIBBITCOIN_WALLET_HD_PARENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/wallet/hd_public.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+// The state shared by the derivation of each child of a key. The chain code
+// keyed HMAC pads are hashed once and copied for each child, and the parent
+// fingerprint and child lineage are computed once.
+class hd_parent
+{
+public:
+    hd_parent(const hd_chain_code& chain_code, const ec_compressed& point,
+        const hd_lineage& lineage);
+
+    /// False if the parent is at maximum depth.
+    bool derivable() const;
+
+    /// The point of the parent.
+    const ec_compressed& point() const;
+
+    /// The lineage of the child with the index.
+    hd_lineage lineage(uint32_t index) const;
+
+    /// HMAC-SHA512(chain code, point || index).
+    long_hash public_hash(uint32_t index) const;
+
+    /// HMAC-SHA512(chain code, 0x00 || secret || index).
+    long_hash private_hash(const ec_secret& secret, uint32_t index) const;
+
+private:
+    long_hash finalize(hmac_sha512_context& context, uint32_t index) const;
+
+    const hmac_sha512_context hmac_;
+    const ec_compressed point_;
+    const hd_lineage lineage_;
+    const uint32_t fingerprint_;
+};
+
+// Parallel derivations claim this many children at a time.
+static constexpr size_t derive_grain = 16;
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -18,8 +18,11 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -31,9 +34,12 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel_for.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_private.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
+#include "hd_parent.hpp"
 
 namespace libbitcoin {
 namespace wallet {
@@ -232,31 +238,60 @@ hd_public hd_private::to_public() const
 
 hd_private hd_private::derive_private(uint32_t index) const
 {
-    constexpr uint8_t depth = 0;
+    const hd_parent parent(chain_, point_, lineage_);
+    return derive(parent, secret_, index);
+}
 
-    const auto data = (index >= hd_first_hardened_key) ?
-        splice(to_array(depth), secret_, to_big_endian(index)) :
-        splice(point_, to_big_endian(index));
+std::vector<hd_private> hd_private::derive_private(uint32_t first,
+    size_t count) const
+{
+    std::vector<hd_private> out(count);
+    derive_private(out.data(), first, count);
+    return out;
+}
 
-    const auto intermediate = split(hmac_sha512_hash(data, chain_));
+void hd_private::derive_private(hd_private* out, uint32_t first,
+    size_t count) const
+{
+    const hd_parent parent(chain_, point_, lineage_);
 
-    // The child key ki is (parse256(IL) + kpar) mod n:
-    auto child = secret_;
-    if (!ec_add(child, intermediate.left))
-        return hd_private();
+    for (size_t offset = 0; offset < count; ++offset)
+        out[offset] = derive(parent, secret_, uint64_t(first) + offset);
+}
 
-    if (lineage_.depth == max_uint8)
-        return hd_private();
+void hd_private::derive_private(threadpool& pool, hd_private* out,
+    uint32_t first, size_t count, completion_handler handler) const
+{
+    const auto parent = std::make_shared<hd_parent>(chain_, point_,
+        lineage_);
+    const auto secret = secret_;
 
-    const hd_lineage lineage
+    const auto derive_range = [=](size_t begin, size_t end)
     {
-        lineage_.prefixes,
-        static_cast<uint8_t>(lineage_.depth + 1),
-        fingerprint(),
-        index
+        for (auto offset = begin; offset < end; ++offset)
+            out[offset] = derive(*parent, secret, uint64_t(first) + offset);
     };
 
-    return hd_private(child, intermediate.right, lineage);
+    parallel_for(pool, count, derive_grain, derive_range, handler);
+}
+
+// Indexes beyond the range of uint32_t cannot be derived.
+hd_private hd_private::derive(const hd_parent& parent,
+    const ec_secret& secret, uint64_t index)
+{
+    if (index > max_uint32 || !parent.derivable())
+        return hd_private();
+
+    const auto number = static_cast<uint32_t>(index);
+    const auto intermediate = split(number >= hd_first_hardened_key ?
+        parent.private_hash(secret, number) : parent.public_hash(number));
+
+    // The child key ki is (parse256(IL) + kpar) mod n:
+    auto child = secret;
+    if (!ec_add(child, intermediate.left))
+        return hd_private();
+
+    return hd_private(child, intermediate.right, parent.lineage(number));
 }
 
 hd_public hd_private::derive_public(uint32_t index) const
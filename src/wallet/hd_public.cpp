@@ -18,8 +18,11 @@
  */
 #include <bitcoin/bitcoin/wallet/hd_public.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -30,9 +33,12 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/parallel_for.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/wallet/ec_public.hpp>
 #include <bitcoin/bitcoin/wallet/hd_private.hpp>
+#include "hd_parent.hpp"
 
 namespace libbitcoin {
 namespace wallet {
@@ -211,29 +217,103 @@ hd_key hd_public::to_hd_key() const
 
 hd_public hd_public::derive_public(uint32_t index) const
 {
-    if (index >= hd_first_hardened_key)
-        return hd_public();
+    const hd_parent parent(chain_, point_, lineage_);
+    return derive(parent, index);
+}
 
-    const auto data = splice(point_, to_big_endian(index));
-    const auto intermediate = split(hmac_sha512_hash(data, chain_));
+std::vector<hd_public> hd_public::derive_public(uint32_t first,
+    size_t count) const
+{
+    std::vector<hd_public> out(count);
+    derive_public(out.data(), first, count);
+    return out;
+}
 
-    // The returned child key Ki is point(parse256(IL)) + Kpar.
-    auto combined = point_;
-    if (!ec_add(combined, intermediate.left))
-        return hd_public();
+void hd_public::derive_public(hd_public* out, uint32_t first,
+    size_t count) const
+{
+    const hd_parent parent(chain_, point_, lineage_);
 
-    if (lineage_.depth == max_uint8)
-        return hd_public();
+    for (size_t offset = 0; offset < count; ++offset)
+        out[offset] = derive(parent, uint64_t(first) + offset);
+}
 
-    const hd_lineage lineage
+void hd_public::derive_public(threadpool& pool, hd_public* out,
+    uint32_t first, size_t count, completion_handler handler) const
+{
+    const auto parent = std::make_shared<hd_parent>(chain_, point_,
+        lineage_);
+
+    const auto derive_range = [=](size_t begin, size_t end)
     {
-        lineage_.prefixes,
-        static_cast<uint8_t>(lineage_.depth + 1),
-        fingerprint(),
-        index
+        for (auto offset = begin; offset < end; ++offset)
+            out[offset] = derive(*parent, uint64_t(first) + offset);
     };
 
-    return hd_public(combined, intermediate.right, lineage);
+    parallel_for(pool, count, derive_grain, derive_range, handler);
+}
+
+void hd_public::derive_address_hashes(short_hash* out, uint32_t first,
+    size_t count) const
+{
+    const hd_parent parent(chain_, point_, lineage_);
+    ec_compressed point;
+    hd_chain_code chain_code;
+
+    for (size_t offset = 0; offset < count; ++offset)
+        out[offset] = derive_point(point, chain_code, parent,
+            uint64_t(first) + offset) ? bitcoin_short_hash(point) :
+            null_short_hash;
+}
+
+void hd_public::derive_address_hashes(threadpool& pool, short_hash* out,
+    uint32_t first, size_t count, completion_handler handler) const
+{
+    const auto parent = std::make_shared<hd_parent>(chain_, point_,
+        lineage_);
+
+    const auto derive_range = [=](size_t begin, size_t end)
+    {
+        ec_compressed point;
+        hd_chain_code chain_code;
+
+        for (auto offset = begin; offset < end; ++offset)
+            out[offset] = derive_point(point, chain_code, *parent,
+                uint64_t(first) + offset) ? bitcoin_short_hash(point) :
+                null_short_hash;
+    };
+
+    parallel_for(pool, count, derive_grain, derive_range, handler);
+}
+
+// Indexes beyond the range of uint32_t are treated as hardened.
+bool hd_public::derive_point(ec_compressed& out, hd_chain_code& chain_code,
+    const hd_parent& parent, uint64_t index)
+{
+    if (index >= hd_first_hardened_key || !parent.derivable())
+        return false;
+
+    const auto number = static_cast<uint32_t>(index);
+    const auto intermediate = split(parent.public_hash(number));
+
+    // The returned child key Ki is point(parse256(IL)) + Kpar.
+    out = parent.point();
+    if (!ec_add(out, intermediate.left))
+        return false;
+
+    chain_code = intermediate.right;
+    return true;
+}
+
+hd_public hd_public::derive(const hd_parent& parent, uint64_t index)
+{
+    ec_compressed point;
+    hd_chain_code chain_code;
+    if (!derive_point(point, chain_code, parent, index))
+        return hd_public();
+
+    const auto number = static_cast<uint32_t>(index);
+    return hd_public(point, chain_code, parent.lineage(number));
 }
 
 // Helpers.
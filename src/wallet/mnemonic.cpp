@@ -21,15 +21,17 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/locale.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/unicode/unicode.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/wallet/dictionary.hpp>
-#include "../math/external/pkcs5_pbkdf2.h"
 
 namespace libbitcoin {
 namespace wallet {
@@ -140,6 +142,36 @@ long_hash decode_mnemonic(const word_list& mnemonic)
         to_chunk(salt), hmac_iterations);
 }
 
+// The chunks outlive the slices that refer to them during derivation.
+static long_hash_list decode_salted(const std::vector<word_list>& mnemonics,
+    const std::vector<std::string>& salts)
+{
+    BITCOIN_ASSERT(mnemonics.size() == salts.size());
+    std::vector<data_chunk> sentences;
+    sentences.reserve(mnemonics.size());
+    for (const auto& mnemonic: mnemonics)
+        sentences.push_back(to_chunk(join(mnemonic)));
+
+    std::vector<data_chunk> salt_chunks;
+    salt_chunks.reserve(salts.size());
+    for (const auto& salt: salts)
+        salt_chunks.push_back(to_chunk(salt));
+
+    const std::vector<data_slice> passphrases(sentences.begin(),
+        sentences.end());
+    const std::vector<data_slice> salt_slices(salt_chunks.begin(),
+        salt_chunks.end());
+    return pkcs5_pbkdf2_hmac_sha512_many(passphrases, salt_slices,
+        hmac_iterations);
+}
+
+long_hash_list decode_mnemonics(const std::vector<word_list>& mnemonics)
+{
+    const std::vector<std::string> salts(mnemonics.size(),
+        passphrase_prefix);
+    return decode_salted(mnemonics, salts);
+}
+
 #ifdef WITH_ICU
 
 long_hash decode_mnemonic(const word_list& mnemonic,
@@ -152,6 +184,18 @@ long_hash decode_mnemonic(const word_list& mnemonic,
         to_chunk(salt), hmac_iterations);
 }
 
+long_hash_list decode_mnemonics(const std::vector<word_list>& mnemonics,
+    const std::vector<std::string>& passphrases)
+{
+    const std::string prefix(passphrase_prefix);
+    std::vector<std::string> salts;
+    salts.reserve(passphrases.size());
+    for (const auto& passphrase: passphrases)
+        salts.push_back(to_normal_nfkd_form(prefix + passphrase));
+
+    return decode_salted(mnemonics, salts);
+}
+
 #endif
 
 } // namespace wallet
@@ -189,4 +189,23 @@ BOOST_AUTO_TEST_CASE(generate_merkle_root_block_with_multiple_transactions_match
     BOOST_REQUIRE(block100k.header.merkle == chain::block::generate_merkle_root(block100k.transactions));
 }
 
+BOOST_AUTO_TEST_CASE(generate_merkle_root_transaction_changed_after_parse_matches_new_hash)
+{
+    chain::transaction::list transactions(1);
+    transactions.back().from_data(to_chunk(base16_literal(
+        "010000000100000000000000000000000000000000000000000000000000000000000"
+        "00000ffffffff07049d8e2f1b0114ffffffff0100f2052a0100000043410437b36a72"
+        "21bc977dce712728a954e3b5d88643ed5aef46660ddcfeeec132724cd950c1fdd008a"
+        "d4a2dfd354d6af0ff155fc17c1ee9ef802062feb07ef1d065f0ac00000000")));
+
+    const auto parsed = transactions.back().cached_hash();
+    BOOST_REQUIRE(parsed == chain::block::generate_merkle_root(transactions));
+
+    // The parsed hash is cached, but the root is of the changed transaction.
+    transactions.back().locktime = 42;
+    const auto root = chain::block::generate_merkle_root(transactions);
+    BOOST_REQUIRE(root != parsed);
+    BOOST_REQUIRE(root == transactions.back().hash());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
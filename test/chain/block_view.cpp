@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "genesis_block.hpp"
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(block_view_tests)
+
+static script make_script(size_t size, uint8_t fill)
+{
+    return script::factory_from_data(data_chunk(size, fill), false,
+        script::parse_mode::raw_data_fallback);
+}
+
+static chain::transaction make_transaction(uint32_t seed, size_t inputs,
+    size_t outputs)
+{
+    chain::transaction tx;
+    tx.version = 1;
+    tx.locktime = seed;
+
+    for (size_t index = 0; index < inputs; ++index)
+    {
+        chain::input input;
+        input.previous_output.hash = bitcoin_hash(to_little_endian(seed));
+        input.previous_output.index = static_cast<uint32_t>(index);
+        input.script = make_script(20 + index, 0x51);
+        input.sequence = max_input_sequence;
+        tx.inputs.push_back(input);
+    }
+
+    for (size_t index = 0; index < outputs; ++index)
+    {
+        chain::output output;
+        output.value = seed * 1000 + index;
+        output.script = make_script(25, 0x76);
+        tx.outputs.push_back(output);
+    }
+
+    return tx;
+}
+
+static chain::block make_block()
+{
+    auto block = genesis_block();
+    block.transactions.push_back(make_transaction(1, 1, 2));
+    block.transactions.push_back(make_transaction(2, 3, 1));
+    block.header.transaction_count = block.transactions.size();
+    block.header.merkle = block::generate_merkle_root(block.transactions);
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__genesis__matches_block)
+{
+    const auto genesis = genesis_block();
+    const auto data = genesis.to_data();
+
+    block_view view;
+    BOOST_REQUIRE(view.from_data(data));
+    BOOST_REQUIRE(view.header() == genesis.header);
+    BOOST_REQUIRE_EQUAL(view.transactions().size(), 1u);
+    BOOST_REQUIRE(view.generate_merkle_root() == genesis.header.merkle);
+    BOOST_REQUIRE(view.header().cached_hash() == genesis.header.hash());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__borrows_scripts)
+{
+    const auto expected = make_block();
+    const auto data = expected.to_data();
+
+    block_view view;
+    BOOST_REQUIRE(view.from_data(data));
+    BOOST_REQUIRE_EQUAL(view.transactions().size(), 3u);
+    BOOST_REQUIRE_EQUAL(view.inputs().size(), 1u + 1u + 3u);
+    BOOST_REQUIRE_EQUAL(view.outputs().size(), 1u + 2u + 1u);
+
+    const auto& tx = view.transactions()[2];
+    BOOST_REQUIRE_EQUAL(tx.locktime, 2u);
+    BOOST_REQUIRE_EQUAL(tx.first_input, 2u);
+    BOOST_REQUIRE_EQUAL(tx.input_count, 3u);
+    BOOST_REQUIRE_EQUAL(tx.first_output, 3u);
+    BOOST_REQUIRE_EQUAL(tx.output_count, 1u);
+
+    const auto& input = view.inputs()[tx.first_input + 2];
+    BOOST_REQUIRE_EQUAL(input.script.size(), 22u);
+    BOOST_REQUIRE(input.script.data() >= data.data());
+    BOOST_REQUIRE(input.script.data() + input.script.size() <= data.data() + data.size());
+    BOOST_REQUIRE_EQUAL(view.outputs()[tx.first_output].value, 2000u);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__to_block__matches_block)
+{
+    const auto expected = make_block();
+    const auto data = expected.to_data();
+
+    block_view view;
+    BOOST_REQUIRE(view.from_data(data));
+    BOOST_REQUIRE(view.to_block().to_data() == data);
+    BOOST_REQUIRE(view.to_transaction(1).hash() == expected.transactions[1].hash());
+    BOOST_REQUIRE(view.generate_merkle_root() == expected.header.merkle);
+
+    const auto hashes = view.transaction_hashes();
+    BOOST_REQUIRE_EQUAL(hashes.size(), 3u);
+    BOOST_REQUIRE(hashes[2] == expected.transactions[2].hash());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__truncated__fails)
+{
+    auto data = make_block().to_data();
+    data.pop_back();
+
+    block_view view;
+    BOOST_REQUIRE(!view.from_data(data));
+    BOOST_REQUIRE(view.transactions().empty());
+    BOOST_REQUIRE(view.inputs().empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__excessive_count__fails)
+{
+    auto data = genesis_block().header.to_data(false);
+    extend_data(data, data_chunk{ 0xfe, 0xff, 0xff, 0xff, 0xff });
+
+    block_view view;
+    BOOST_REQUIRE(!view.from_data(data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
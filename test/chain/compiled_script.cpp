@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(compiled_script_tests)
+
+static script make_script(const data_chunk& data)
+{
+    return script::factory_from_data(data, false,
+        script::parse_mode::raw_data_fallback);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__constructor__default__empty_valid)
+{
+    const compiled_script instance;
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_push_only());
+    BOOST_REQUIRE(instance.instructions().empty());
+    BOOST_REQUIRE(instance.buffer().empty());
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__pay_key_hash__expected)
+{
+    const auto raw = to_chunk(base16_literal(
+        "76a91406ccef231c2db72526df9338894ccf9355e8f12188ac"));
+    const compiled_script instance(make_script(raw));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.is_push_only());
+    BOOST_REQUIRE(instance.pattern() == script_pattern::pay_key_hash);
+    BOOST_REQUIRE(instance.buffer() == raw);
+
+    const auto& program = instance.instructions();
+    BOOST_REQUIRE_EQUAL(program.size(), 5u);
+    BOOST_REQUIRE(program[0].code == opcode::dup);
+    BOOST_REQUIRE(program[2].code == opcode::special);
+    BOOST_REQUIRE_EQUAL(program[2].begin, 2u);
+    BOOST_REQUIRE_EQUAL(program[2].data, 3u);
+    BOOST_REQUIRE_EQUAL(program[2].size, 20u);
+    BOOST_REQUIRE(program[4].code == opcode::checksig);
+
+    const auto data = instance.data(program[2]);
+    BOOST_REQUIRE(data_chunk(data.begin(), data.end()) ==
+        data_chunk(raw.begin() + 3, raw.begin() + 23));
+
+    const auto code = instance.code(2, 4);
+    BOOST_REQUIRE(data_chunk(code.begin(), code.end()) ==
+        data_chunk(raw.begin() + 2, raw.begin() + 24));
+
+    const auto tail = instance.code(3, program.size());
+    BOOST_REQUIRE(data_chunk(tail.begin(), tail.end()) ==
+        data_chunk(raw.begin() + 23, raw.end()));
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__pushdata__serialization_preserved)
+{
+    // [pushdata1 3 010203] [pushdata2 1 04] [zero] [op_16]
+    const auto raw = to_chunk(base16_literal("4c030102034d0100040060"));
+    const compiled_script instance(make_script(raw));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_push_only());
+    BOOST_REQUIRE(instance.buffer() == raw);
+
+    const auto& program = instance.instructions();
+    BOOST_REQUIRE_EQUAL(program.size(), 4u);
+    BOOST_REQUIRE_EQUAL(program[1].begin, 5u);
+    BOOST_REQUIRE_EQUAL(program[1].data, 8u);
+    BOOST_REQUIRE_EQUAL(program[1].size, 1u);
+    BOOST_REQUIRE_EQUAL(program[2].size, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__disabled_opcode__invalid)
+{
+    // [op_1] [op_1] [cat] within an unexecuted branch.
+    const compiled_script instance(make_script({ 0x00, 0x63, 0x51, 0x51,
+        0x7e, 0x68 }));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__oversized_push__invalid)
+{
+    data_chunk raw{ 0x4d, 0x09, 0x02 };
+    raw.resize(raw.size() + 521, 0x2a);
+    const compiled_script instance(make_script(raw));
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__operation_limit__expected)
+{
+    const data_chunk at_limit(201, 0x61);
+    BOOST_REQUIRE(compiled_script(make_script(at_limit)).is_valid());
+
+    const data_chunk over_limit(202, 0x61);
+    BOOST_REQUIRE(!compiled_script(make_script(over_limit)).is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__compile__recompile__replaces_program)
+{
+    compiled_script instance(make_script({ 0x51, 0x52, 0x53 }));
+    instance.compile(make_script({ 0x6a }));
+    BOOST_REQUIRE_EQUAL(instance.instructions().size(), 1u);
+    BOOST_REQUIRE(instance.buffer() == data_chunk{ 0x6a });
+    BOOST_REQUIRE(!instance.is_push_only());
+}
+
+BOOST_AUTO_TEST_CASE(compiled_script__verify__precompiled__matches_script)
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    tx.inputs.resize(1);
+    const signature_hash_cache cache(tx);
+
+    // [op_2 op_3] / [add op_5 equal]
+    const auto input = make_script({ 0x52, 0x53 });
+    const auto output = make_script({ 0x93, 0x55, 0x87 });
+    const compiled_script compiled_input(input);
+    const compiled_script compiled_output(output);
+    BOOST_REQUIRE(script::verify(input, output, cache, 0));
+    BOOST_REQUIRE(script::verify(compiled_input, compiled_output, cache, 0));
+
+    // Repeated evaluation of the same compiled scripts.
+    BOOST_REQUIRE(script::verify(compiled_input, compiled_output, cache, 0));
+
+    const compiled_script failing_output(make_script({ 0x93, 0x56, 0x87 }));
+    BOOST_REQUIRE(!script::verify(compiled_input, failing_output, cache, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -145,4 +145,26 @@ BOOST_AUTO_TEST_CASE(roundtrip_to_data_factory_from_data_reader_with_transaction
     BOOST_REQUIRE(expected == result);
 }
 
+BOOST_AUTO_TEST_CASE(header__cached_hash__from_data_with_transaction_count__hash)
+{
+    const auto genesis = genesis_block();
+    const auto data = genesis.header.to_data(true);
+    const auto result = chain::header::factory_from_data(data, true);
+    BOOST_REQUIRE(result.cached_hash() == genesis.header.hash());
+    BOOST_REQUIRE_EQUAL(encode_hash(result.cached_hash()), "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+}
+
+BOOST_AUTO_TEST_CASE(header__cached_hash__invalidated__recomputed)
+{
+    auto header = genesis_block().header;
+    const auto original = header.cached_hash();
+
+    header.nonce++;
+    BOOST_REQUIRE(header.cached_hash() == original);
+
+    header.invalidate_hash();
+    BOOST_REQUIRE(header.cached_hash() == header.hash());
+    BOOST_REQUIRE(header.cached_hash() != original);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
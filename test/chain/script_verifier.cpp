@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(script_verifier_tests)
+
+// Previous output indexes select the prevout script.
+static const uint32_t missing_prevout = 0;
+static const uint32_t one_equal_prevout = 1;
+static const uint32_t pay_script_hash_prevout = 2;
+
+struct verify_result
+{
+    code ec;
+    size_t tx_index;
+    uint32_t input_index;
+};
+
+static script make_script(const data_chunk& data)
+{
+    return script::factory_from_data(data, false,
+        script::parse_mode::raw_data_fallback);
+}
+
+static bool fetch(const output_point& prevout, script& out_script)
+{
+    switch (prevout.index)
+    {
+        case one_equal_prevout:
+            // [1 EQUAL]
+            out_script = make_script({ 0x51, 0x87 });
+            return true;
+
+        case pay_script_hash_prevout:
+        {
+            // [HASH160 <hash160([1])> EQUAL]
+            data_chunk data{ 0xa9, 0x14 };
+            extend_data(data, bitcoin_short_hash(data_chunk{ 0x51 }));
+            data.push_back(0x87);
+            out_script = make_script(data);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+static void add_input(transaction& tx, uint32_t prevout,
+    const data_chunk& input_script)
+{
+    input input;
+    input.previous_output.index = prevout;
+    input.script = make_script(input_script);
+    input.sequence = max_input_sequence;
+    tx.inputs.push_back(input);
+}
+
+static transaction make_transaction(size_t inputs)
+{
+    transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+
+    for (size_t index = 0; index < inputs; ++index)
+    {
+        if (index % 2 == 0)
+            add_input(tx, one_equal_prevout, { 0x51 });
+        else
+            add_input(tx, pay_script_hash_prevout, { 0x01, 0x51 });
+    }
+
+    return tx;
+}
+
+static block make_block(size_t transactions, size_t inputs)
+{
+    transaction coinbase;
+    coinbase.version = 1;
+    coinbase.locktime = 0;
+    input input;
+    input.previous_output = output_point{ null_hash, max_uint32 };
+    input.sequence = max_input_sequence;
+    coinbase.inputs.push_back(input);
+
+    block block;
+    block.transactions.push_back(coinbase);
+
+    for (size_t index = 0; index < transactions; ++index)
+        block.transactions.push_back(make_transaction(inputs));
+
+    return block;
+}
+
+template <typename Message>
+static verify_result verify(threadpool& pool, const Message& message)
+{
+    std::promise<verify_result> promise;
+    const auto handler = [&promise](const code& ec, size_t tx_index,
+        uint32_t input_index)
+    {
+        promise.set_value({ ec, tx_index, input_index });
+    };
+
+    script_verifier verifier(pool);
+    verifier.verify(message, fetch, handler);
+    return promise.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__empty_transaction__success)
+{
+    threadpool pool(2);
+    const auto result = verify(pool, transaction());
+    BOOST_REQUIRE_EQUAL(result.ec, error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__valid_transaction__success)
+{
+    threadpool pool(4);
+    const auto result = verify(pool, make_transaction(100));
+    BOOST_REQUIRE_EQUAL(result.ec, error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__coinbase_only_block__success)
+{
+    threadpool pool(2);
+    const auto result = verify(pool, make_block(0, 0));
+    BOOST_REQUIRE_EQUAL(result.ec, error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__valid_block__success)
+{
+    threadpool pool(4);
+    const auto result = verify(pool, make_block(20, 25));
+    BOOST_REQUIRE_EQUAL(result.ec, error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__no_threads__completes_inline)
+{
+    threadpool pool(0);
+    auto block = make_block(3, 4);
+    BOOST_REQUIRE_EQUAL(verify(pool, block).ec, error::success);
+
+    block.transactions[2].inputs[1].previous_output.index = missing_prevout;
+    const auto result = verify(pool, block);
+    BOOST_REQUIRE_EQUAL(result.ec, error::input_not_found);
+    BOOST_REQUIRE_EQUAL(result.tx_index, 2u);
+    BOOST_REQUIRE_EQUAL(result.input_index, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__missing_prevout__input_not_found)
+{
+    threadpool pool(2);
+    auto tx = make_transaction(10);
+    tx.inputs[7].previous_output.index = missing_prevout;
+    const auto result = verify(pool, tx);
+    BOOST_REQUIRE_EQUAL(result.ec, error::input_not_found);
+    BOOST_REQUIRE_EQUAL(result.tx_index, 0u);
+    BOOST_REQUIRE_EQUAL(result.input_index, 7u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(script_verifier__verify__invalid_inputs__first_failure)
+{
+    threadpool pool(4);
+    auto block = make_block(20, 25);
+    block.transactions[17].inputs[20].script = make_script({ 0x00 });
+    block.transactions[5].inputs[12].previous_output.index = missing_prevout;
+    block.transactions[5].inputs[3].script = make_script({ 0x01, 0x52 });
+
+    // The reported failure must not depend upon thread scheduling.
+    for (size_t run = 0; run < 20; ++run)
+    {
+        const auto result = verify(pool, block);
+        BOOST_REQUIRE_EQUAL(result.ec, error::validate_inputs_failed);
+        BOOST_REQUIRE_EQUAL(result.tx_index, 5u);
+        BOOST_REQUIRE_EQUAL(result.input_index, 3u);
+    }
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdint>
+#include <limits>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+// The original copy-and-serialize signature hash, used as the reference.
+static hash_digest reference_signature_hash(chain::transaction parent_tx,
+    uint32_t input_index, const chain::script& script_code, uint32_t hash_type)
+{
+    static const hash_digest one_hash{ { 1 } };
+    if (input_index >= parent_tx.inputs.size())
+        return one_hash;
+
+    for (auto& input: parent_tx.inputs)
+        input.script.reset();
+
+    parent_tx.inputs[input_index].script = script_code;
+    const auto nullify_sequences = [&parent_tx, input_index]()
+    {
+        for (uint32_t index = 0; index < parent_tx.inputs.size(); ++index)
+            if (index != input_index)
+                parent_tx.inputs[index].sequence = 0;
+    };
+
+    if ((hash_type & 0x1f) == chain::signature_hash_algorithm::none)
+    {
+        parent_tx.outputs.clear();
+        nullify_sequences();
+    }
+    else if ((hash_type & 0x1f) == chain::signature_hash_algorithm::single)
+    {
+        auto& outputs = parent_tx.outputs;
+        if (input_index >= outputs.size())
+            return one_hash;
+
+        outputs.resize(input_index + 1);
+        for (auto it = outputs.begin(); it != outputs.end() - 1; ++it)
+        {
+            it->value = std::numeric_limits<uint64_t>::max();
+            it->script.reset();
+        }
+
+        nullify_sequences();
+    }
+
+    if ((hash_type & chain::signature_hash_algorithm::anyone_can_pay) != 0)
+    {
+        parent_tx.inputs[0] = parent_tx.inputs[input_index];
+        parent_tx.inputs.resize(1);
+    }
+
+    return parent_tx.hash(hash_type);
+}
+
+static chain::transaction make_transaction(size_t inputs, size_t outputs)
+{
+    const auto script = chain::script::factory_from_data(to_chunk(
+        base16_literal("76a91406ccef231c2db72526df9338894ccf9355e8f12188ac")),
+        false, chain::script::parse_mode::strict);
+
+    chain::transaction tx;
+    tx.version = 1;
+    tx.locktime = 42;
+
+    for (uint32_t index = 0; index < inputs; ++index)
+    {
+        chain::input input;
+        input.previous_output.hash = bitcoin_hash(to_little_endian(index));
+        input.previous_output.index = index;
+        input.script = script;
+        input.sequence = 0xfffffffe - index;
+        tx.inputs.push_back(input);
+    }
+
+    for (uint32_t index = 0; index < outputs; ++index)
+    {
+        chain::output output;
+        output.value = 1000 * (index + 1);
+        output.script = script;
+        tx.outputs.push_back(output);
+    }
+
+    return tx;
+}
+
+BOOST_AUTO_TEST_SUITE(signature_hash_cache_tests)
+
+BOOST_AUTO_TEST_CASE(signature_hash_cache__generate__all_hash_types__matches_reference)
+{
+    const auto tx = make_transaction(4, 3);
+    const chain::signature_hash_cache cache(tx);
+    const auto script_code = chain::script::factory_from_data(to_chunk(
+        base16_literal("76a914fcc9b36d38cf55d7d5b4ee4dddb6b2c17612f48c88ac")),
+        false, chain::script::parse_mode::strict);
+
+    const uint32_t hash_types[] =
+    {
+        chain::signature_hash_algorithm::all,
+        chain::signature_hash_algorithm::none,
+        chain::signature_hash_algorithm::single,
+        chain::signature_hash_algorithm::all_anyone_can_pay,
+        chain::signature_hash_algorithm::none_anyone_can_pay,
+        chain::signature_hash_algorithm::single_anyone_can_pay,
+        0x00, 0x04, 0x21, 0x43
+    };
+
+    // Includes an index past the last input, which produces one_hash.
+    for (uint32_t input_index = 0; input_index <= tx.inputs.size(); ++input_index)
+    {
+        for (const auto hash_type: hash_types)
+        {
+            const auto expected = reference_signature_hash(tx, input_index, script_code, hash_type);
+            BOOST_REQUIRE(cache.generate(input_index, script_code, hash_type) == expected);
+            BOOST_REQUIRE(chain::script::generate_signature_hash(tx, input_index, script_code, hash_type) == expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(signature_hash_cache__generate__large_input_count__matches_reference)
+{
+    // Exceeds a single byte input count varint.
+    const auto tx = make_transaction(260, 2);
+    const chain::signature_hash_cache cache(tx);
+    const auto& script_code = tx.inputs.front().script;
+    const auto hash_type = chain::signature_hash_algorithm::all;
+
+    for (uint32_t input_index = 0; input_index < tx.inputs.size(); input_index += 37)
+    {
+        const auto expected = reference_signature_hash(tx, input_index, script_code, hash_type);
+        BOOST_REQUIRE(cache.generate(input_index, script_code, hash_type) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(signature_hash_cache__parent_tx__always__returns_constructed_tx)
+{
+    const auto tx = make_transaction(1, 1);
+    const chain::signature_hash_cache cache(tx);
+    BOOST_REQUIRE(&cache.parent_tx() == &tx);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
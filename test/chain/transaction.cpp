@@ -347,4 +347,54 @@ BOOST_AUTO_TEST_CASE(case_2_factory_reader)
     BOOST_REQUIRE(resave == raw_tx);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__cached_hash__from_data__hash)
+{
+    chain::transaction tx;
+    tx.version = 1;
+    tx.locktime = 42;
+    tx.outputs.resize(1);
+    tx.outputs[0].value = 1000;
+
+    const auto result = chain::transaction::factory_from_data(tx.to_data());
+    BOOST_REQUIRE(result.cached_hash() == tx.hash());
+}
+
+BOOST_AUTO_TEST_CASE(transaction__cached_hash__non_minimal_encoding__hash_of_bytes_read)
+{
+    // Version 1, no inputs (with a three byte count), no outputs, locktime 0.
+    const auto raw_tx = to_chunk(base16_literal("01000000fd00000000000000"));
+    const auto tx = chain::transaction::factory_from_data(raw_tx);
+    BOOST_REQUIRE(tx.cached_hash() == bitcoin_hash(raw_tx));
+    BOOST_REQUIRE(tx.hash() != bitcoin_hash(raw_tx));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__cached_hash__mutated__stale_until_invalidated)
+{
+    chain::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    const auto original = tx.cached_hash();
+
+    tx.locktime = 1;
+    const auto copy = tx;
+    BOOST_REQUIRE(tx.cached_hash() == original);
+    BOOST_REQUIRE(copy.cached_hash() == original);
+
+    tx.invalidate_hash();
+    BOOST_REQUIRE(tx.cached_hash() == tx.hash());
+    BOOST_REQUIRE(tx.cached_hash() != original);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__cached_hash__reset__invalidated)
+{
+    chain::transaction tx;
+    tx.version = 1;
+    tx.locktime = 0;
+    const auto original = tx.cached_hash();
+
+    tx.reset();
+    BOOST_REQUIRE(tx.cached_hash() != original);
+    BOOST_REQUIRE(tx.cached_hash() == tx.hash());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -67,6 +67,109 @@ BOOST_AUTO_TEST_CASE(sha256_hash_test)
     BOOST_REQUIRE_EQUAL(encode_hash(genesis_hash), "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
 }
 
+BOOST_AUTO_TEST_CASE(sha256_context__update__split_input__matches_sha256_hash)
+{
+    for (const hash_result& result: sha256_tests)
+    {
+        data_chunk data;
+        BOOST_REQUIRE(decode_base16(data, result.input));
+
+        for (size_t split = 0; split <= data.size(); ++split)
+        {
+            sha256_context context;
+            context.update(data.data(), split);
+            context.update(data.data() + split, data.size() - split);
+            BOOST_REQUIRE_EQUAL(encode_base16(context.digest()), result.result);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sha256_context__digest__copied_midstate__resumable)
+{
+    const data_chunk prefix(100, 0x42);
+    const data_chunk first{ 'a', 'b', 'c' };
+    const data_chunk second(70, 0x24);
+
+    sha256_context midstate;
+    midstate.update(prefix);
+    BOOST_REQUIRE(midstate.digest() == sha256_hash(prefix));
+
+    auto context1 = midstate;
+    context1.update(first);
+    BOOST_REQUIRE(context1.digest() == sha256_hash(build_chunk({ prefix, first })));
+
+    auto context2 = midstate;
+    context2.update(second);
+    BOOST_REQUIRE(context2.digest() == sha256_hash(build_chunk({ prefix, second })));
+}
+
+BOOST_AUTO_TEST_CASE(sha256_implementations__always__generic_last)
+{
+    const auto implementations = sha256_implementations();
+    BOOST_REQUIRE(!implementations.empty());
+    BOOST_REQUIRE_EQUAL(implementations.back(), "generic");
+}
+
+BOOST_AUTO_TEST_CASE(select_sha256_implementation__unknown__false)
+{
+    BOOST_REQUIRE(!select_sha256_implementation("bogus"));
+}
+
+// Every implementation supported here must agree with the generic one.
+BOOST_AUTO_TEST_CASE(sha256_implementations__all_supported__match_generic)
+{
+    data_chunk data(1000);
+    for (size_t index = 0; index < data.size(); ++index)
+        data[index] = static_cast<uint8_t>(index * 7 + index / 256);
+
+    // Items of varying length, so that lanes complete at different times.
+    std::vector<data_slice> items;
+    for (size_t index = 0; index < 37; ++index)
+        items.push_back({ data.data() + index, data.data() + index + (index * 53) % 400 });
+
+    hash_list level(22);
+    for (size_t index = 0; index < level.size(); ++index)
+        level[index] = sha256_hash(to_little_endian(static_cast<uint32_t>(index)));
+
+    BOOST_REQUIRE(select_sha256_implementation("generic"));
+    hash_list expected_single;
+    for (size_t size = 0; size <= 200; ++size)
+        expected_single.push_back(sha256_hash({ data.data(), data.data() + size }));
+
+    hash_list expected_many;
+    for (const auto& item: items)
+        expected_many.push_back(bitcoin_hash(item));
+
+    hash_list expected_pairs;
+    for (size_t index = 0; index < level.size(); index += 2)
+        expected_pairs.push_back(bitcoin_hash(build_chunk({ level[index], level[index + 1] })));
+
+    const auto implementations = sha256_implementations();
+    for (const auto& implementation: implementations)
+    {
+        BOOST_TEST_MESSAGE(implementation);
+        BOOST_REQUIRE(select_sha256_implementation(implementation));
+
+        for (size_t size = 0; size <= 200; ++size)
+            BOOST_REQUIRE(sha256_hash({ data.data(), data.data() + size }) == expected_single[size]);
+
+        BOOST_REQUIRE(bitcoin_hash_many(items) == expected_many);
+
+        // The level is reduced in place.
+        auto reduced = level;
+        bitcoin_hash_pairs(reduced.data(), reduced.data(), reduced.size() / 2);
+        reduced.resize(reduced.size() / 2);
+        BOOST_REQUIRE(reduced == expected_pairs);
+    }
+
+    BOOST_REQUIRE(select_sha256_implementation(implementations.front()));
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_many__empty__empty)
+{
+    BOOST_REQUIRE(bitcoin_hash_many({}).empty());
+}
+
 BOOST_AUTO_TEST_CASE(hmac_sha256_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
@@ -83,6 +186,47 @@ BOOST_AUTO_TEST_CASE(hmac_sha512_hash_test)
     BOOST_REQUIRE_EQUAL(encode_base16(long_hash), "3c5953a18f7303ec653ba170ae334fafa08e3846f2efe317b87efce82376253cb52a8c31ddcde5a3a2eee183c2b34cb91f85e64ddbc325f7692b199473579c58");
 }
 
+BOOST_AUTO_TEST_CASE(hmac_sha512_context__update__split_input__matches_hmac_sha512_hash)
+{
+    // Keys shorter than, equal to and longer than the block size.
+    for (const auto key_size: { 3, 128, 200 })
+    {
+        const data_chunk key(key_size, 0x0b);
+        const hmac_sha512_context keyed(key);
+
+        // Every length modulo the block size, covering every padding case.
+        for (size_t size = 0; size <= 2 * 128; ++size)
+        {
+            const data_chunk data(size, 0xdd);
+            const auto expected = hmac_sha512_hash(data, key);
+
+            for (size_t split = 0; split <= size; split += 29)
+            {
+                auto context = keyed;
+                context.update(data.data(), split);
+                context.update(data.data() + split, size - split);
+                BOOST_REQUIRE(context.digest() == expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hmac_sha512_context__digest__copied_midstate__resumable)
+{
+    const data_chunk key{ 'k', 'e', 'y' };
+    const data_chunk prefix(150, 0x42);
+    const data_chunk first{ 'a', 'b', 'c' };
+
+    hmac_sha512_context midstate(key);
+    midstate.update(prefix);
+    BOOST_REQUIRE(midstate.digest() == hmac_sha512_hash(prefix, key));
+
+    auto context = midstate;
+    context.update(first);
+    BOOST_REQUIRE(context.digest() == hmac_sha512_hash(build_chunk({ prefix, first }), key));
+    BOOST_REQUIRE(midstate.digest() == hmac_sha512_hash(prefix, key));
+}
+
 BOOST_AUTO_TEST_CASE(sha512_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
@@ -99,4 +243,54 @@ BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_many__empty__empty)
+{
+    BOOST_REQUIRE(pkcs5_pbkdf2_hmac_sha512_many({}, {}, 2048).empty());
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_many__distinct_inputs__match_single)
+{
+    // Enough derivations for whole groups of lanes and a remainder.
+    std::vector<data_chunk> passphrases;
+    std::vector<data_chunk> salts;
+    for (uint8_t index = 0; index < 11; ++index)
+    {
+        passphrases.push_back(data_chunk(index * 15, index));
+        salts.push_back(data_chunk(index, 0xff - index));
+    }
+
+    const std::vector<data_slice> passphrase_slices(passphrases.begin(), passphrases.end());
+    const std::vector<data_slice> salt_slices(salts.begin(), salts.end());
+
+    for (const size_t iterations: { 0, 1, 2, 100 })
+    {
+        const auto hashes = pkcs5_pbkdf2_hmac_sha512_many(passphrase_slices, salt_slices, iterations);
+        BOOST_REQUIRE_EQUAL(hashes.size(), passphrases.size());
+
+        for (size_t index = 0; index < hashes.size(); ++index)
+            BOOST_REQUIRE(hashes[index] == pkcs5_pbkdf2_hmac_sha512(passphrases[index], salts[index], iterations));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pkcs5_pbkdf2_hmac_sha512_many__vectors__expected)
+{
+    std::vector<data_chunk> passphrases;
+    std::vector<data_chunk> salts;
+    for (const auto& result: pkcs5_pbkdf2_hmac_sha512_tests)
+    {
+        passphrases.push_back(to_chunk(result.passphrase));
+        salts.push_back(to_chunk(result.salt));
+    }
+
+    const std::vector<data_slice> passphrase_slices(passphrases.begin(), passphrases.end());
+    const std::vector<data_slice> salt_slices(salts.begin(), salts.end());
+
+    for (size_t index = 0; index < passphrases.size(); ++index)
+    {
+        const auto& result = pkcs5_pbkdf2_hmac_sha512_tests[index];
+        const auto hashes = pkcs5_pbkdf2_hmac_sha512_many(passphrase_slices, salt_slices, result.iterations);
+        BOOST_REQUIRE_EQUAL(encode_base16(hashes[index]), result.result);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -140,7 +140,12 @@ pkcs5_pbkdf2_hmac_sha512_result_list pkcs5_pbkdf2_hmac_sha512_tests{{
     {"password", "salt", 2, "e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53cf76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e"},
     {"password", "salt", 4096, "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5"},
     {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8"},
-    {"password", "NaCL", 1, "73decfa58aa2e84f94771a75736bb88bd3c7b38270cfb50cb390ed78b305656af8148e52452b2216b2b8098b761fc6336060a09f76415e9f71ea47f9e9064306"}
+    {"password", "NaCL", 1, "73decfa58aa2e84f94771a75736bb88bd3c7b38270cfb50cb390ed78b305656af8148e52452b2216b2b8098b761fc6336060a09f76415e9f71ea47f9e9064306"},
+
+    // The salt and block index fill 112 to 119 bytes of the block, as does
+    // the BIP39 salt of a 100 to 107 byte passphrase, so the padding and
+    // length spill into a further block.
+    {"password", "mnemonicpassphrase passphrase passphrase passphrase passphrase passphrase passphrase passphrase passphrase pass", 2048, "b0e2a5e632e6b7e420fba28b397b845359516c64f1fe0e4fbf63ca6fcee130a2408f3f6b84d6341230f248a8d18848f242eb3984f315d88d54da0f0ae02c5bd6"}
 }};
 
 
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../chain/genesis_block.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(merkle_tests)
+
+static hash_list make_leaves(size_t count)
+{
+    hash_list leaves;
+    for (uint32_t index = 0; index < count; ++index)
+        leaves.push_back(sha256_hash(to_little_endian(index)));
+
+    return leaves;
+}
+
+// The tree as specified, one allocated level at a time.
+static hash_digest naive_root(hash_list level)
+{
+    if (level.empty())
+        return null_hash;
+
+    while (level.size() > 1)
+    {
+        if (level.size() % 2 != 0)
+            level.push_back(level.back());
+
+        hash_list parents;
+        for (size_t index = 0; index < level.size(); index += 2)
+            parents.push_back(bitcoin_hash(build_chunk({ level[index], level[index + 1] })));
+
+        level = parents;
+    }
+
+    return level.front();
+}
+
+BOOST_AUTO_TEST_CASE(merkle_root__empty__null_hash)
+{
+    BOOST_REQUIRE(merkle_root({}) == null_hash);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_root__one_leaf__leaf)
+{
+    const auto leaves = make_leaves(1);
+    BOOST_REQUIRE(merkle_root(leaves) == leaves.front());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_root__various_sizes__matches_naive)
+{
+    for (size_t count = 1; count <= 40; ++count)
+    {
+        const auto leaves = make_leaves(count);
+        BOOST_REQUIRE(merkle_root(leaves) == naive_root(leaves));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_merkle_root__three_leaves__matches_naive)
+{
+    auto leaves = make_leaves(3);
+    const auto expected = naive_root(leaves);
+    BOOST_REQUIRE(reduce_merkle_root(leaves) == expected);
+    BOOST_REQUIRE_EQUAL(leaves.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(block__generate_merkle_root__genesis__header_merkle)
+{
+    const auto genesis = genesis_block();
+    BOOST_REQUIRE(chain::block::generate_merkle_root(genesis.transactions) == genesis.header.merkle);
+}
+
+BOOST_AUTO_TEST_CASE(merkle_branch__out_of_range__empty)
+{
+    BOOST_REQUIRE(merkle_branch(make_leaves(3), 3).empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_branch__every_leaf__proves_root)
+{
+    for (size_t count = 1; count <= 17; ++count)
+    {
+        const auto leaves = make_leaves(count);
+        const auto root = merkle_root(leaves);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            const auto branch = merkle_branch(leaves, index);
+            BOOST_REQUIRE(merkle_branch_root(leaves[index], branch, index) == root);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkle_branch__four_leaves__siblings)
+{
+    const auto leaves = make_leaves(4);
+    const auto branch = merkle_branch(leaves, 2);
+    BOOST_REQUIRE_EQUAL(branch.size(), 2u);
+    BOOST_REQUIRE(branch[0] == leaves[3]);
+    BOOST_REQUIRE(branch[1] == merkle_root({ leaves[0], leaves[1] }));
+}
+
+BOOST_AUTO_TEST_CASE(partial_merkle_tree__empty__empty)
+{
+    hash_list hashes;
+    data_chunk flags;
+    partial_merkle_tree(hashes, flags, {}, {});
+    BOOST_REQUIRE(hashes.empty());
+    BOOST_REQUIRE(flags.empty());
+}
+
+BOOST_AUTO_TEST_CASE(partial_merkle_tree__no_matches__root_only)
+{
+    const auto leaves = make_leaves(4);
+    hash_list hashes;
+    data_chunk flags;
+    partial_merkle_tree(hashes, flags, leaves, std::vector<bool>(4, false));
+    BOOST_REQUIRE(hashes == hash_list{ merkle_root(leaves) });
+    BOOST_REQUIRE(flags == data_chunk{ 0x00 });
+}
+
+BOOST_AUTO_TEST_CASE(partial_merkle_tree__first_of_four__descends_to_match)
+{
+    const auto leaves = make_leaves(4);
+    hash_list hashes;
+    data_chunk flags;
+    partial_merkle_tree(hashes, flags, leaves, { true, false, false, false });
+
+    // Flags (depth first): root, left parent, leaf 0, leaf 1, right parent.
+    BOOST_REQUIRE(flags == data_chunk{ 0x07 });
+    BOOST_REQUIRE_EQUAL(hashes.size(), 3u);
+    BOOST_REQUIRE(hashes[0] == leaves[0]);
+    BOOST_REQUIRE(hashes[1] == leaves[1]);
+    BOOST_REQUIRE(hashes[2] == merkle_root({ leaves[2], leaves[3] }));
+}
+
+BOOST_AUTO_TEST_CASE(partial_merkle_tree__last_of_three__odd_node_not_duplicated)
+{
+    const auto leaves = make_leaves(3);
+    hash_list hashes;
+    data_chunk flags;
+    partial_merkle_tree(hashes, flags, leaves, { false, false, true });
+
+    // Flags: root, left parent, right parent, leaf 2 (which has no sibling).
+    BOOST_REQUIRE(flags == data_chunk{ 0x0d });
+    BOOST_REQUIRE_EQUAL(hashes.size(), 2u);
+    BOOST_REQUIRE(hashes[0] == merkle_root({ leaves[0], leaves[1] }));
+    BOOST_REQUIRE(hashes[1] == leaves[2]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
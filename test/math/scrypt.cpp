@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(scrypt_tests)
+
+// Test vectors from RFC 7914, section 12 (the context takes N, p, r).
+
+static std::string scrypt_base16(scrypt_context& context,
+    const std::string& passphrase, const std::string& salt)
+{
+    return encode_base16(context.hash(to_chunk(passphrase), to_chunk(salt),
+        64));
+}
+
+static std::string scrypt_base16(const std::string& passphrase,
+    const std::string& salt, uint64_t N, uint32_t p, uint32_t r)
+{
+    scrypt_context context(N, p, r);
+    return scrypt_base16(context, passphrase, salt);
+}
+
+static std::string scrypt_base16(const std::string& passphrase,
+    const std::string& salt, uint64_t N, uint32_t p, uint32_t r,
+    threadpool& pool)
+{
+    scrypt_context context(N, p, r, pool);
+    return scrypt_base16(context, passphrase, salt);
+}
+
+static const std::string rfc7914_empty =
+    "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442"
+    "fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906";
+
+static const std::string rfc7914_password =
+    "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b373162"
+    "2eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+
+static const std::string rfc7914_pleaseletmein =
+    "7023bdcb3afd7348461c06cd81fd38ebfda8fbba904f8e3ea9b543f6545da1f2"
+    "d5432955613f0fcf62d49705242a9af9e61e85dc0d651e40dfcf017b45575887";
+
+BOOST_AUTO_TEST_CASE(scrypt_context__hash__rfc7914_empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(scrypt_base16("", "", 16, 1, 1), rfc7914_empty);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_context__hash__rfc7914_password__expected)
+{
+    BOOST_REQUIRE_EQUAL(scrypt_base16("password", "NaCl", 1024, 16, 8),
+        rfc7914_password);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_context__hash__rfc7914_pleaseletmein__expected)
+{
+    BOOST_REQUIRE_EQUAL(scrypt_base16("pleaseletmein", "SodiumChloride",
+        16384, 1, 8), rfc7914_pleaseletmein);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt__rfc7914_password__expected)
+{
+    const auto result = scrypt(to_chunk(std::string("password")),
+        to_chunk(std::string("NaCl")), 1024, 16, 8, 64);
+    BOOST_REQUIRE_EQUAL(encode_base16(result), rfc7914_password);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_context__hash__reused__same_result)
+{
+    scrypt_context context(1024, 16, 8);
+    const auto data = to_chunk(std::string("password"));
+    const auto salt = to_chunk(std::string("NaCl"));
+    const auto other = context.hash<64>(data, to_chunk(std::string("salt")));
+    BOOST_REQUIRE_EQUAL(encode_base16(context.hash<64>(data, salt)),
+        rfc7914_password);
+    BOOST_REQUIRE(context.hash<64>(data, to_chunk(std::string("salt"))) ==
+        other);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_context__hash__pool__expected)
+{
+    threadpool pool(3);
+    BOOST_REQUIRE_EQUAL(scrypt_base16("password", "NaCl", 1024, 16, 8,
+        pool), rfc7914_password);
+    BOOST_REQUIRE_EQUAL(scrypt_base16("", "", 16, 1, 1, pool),
+        rfc7914_empty);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_context__construct__invalid__throws)
+{
+    BOOST_REQUIRE_THROW(scrypt_context(0, 1, 1), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt_context(1000, 1, 1), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt_context(16, 0, 1), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt_context(16, 1, 0), std::runtime_error);
+    BOOST_REQUIRE_THROW(scrypt_context(16, 1u << 15, 1u << 15),
+        std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(scrypt_implementations__always__generic_last)
+{
+    const auto implementations = scrypt_implementations();
+    BOOST_REQUIRE(!implementations.empty());
+    BOOST_REQUIRE_EQUAL(implementations.back(), "generic");
+}
+
+BOOST_AUTO_TEST_CASE(select_scrypt_implementation__unknown__false)
+{
+    BOOST_REQUIRE(!select_scrypt_implementation("bogus"));
+}
+
+// Every implementation supported here must agree with the generic one, for
+// odd and even numbers of blocks so that partially filled lanes are covered.
+BOOST_AUTO_TEST_CASE(scrypt_implementations__all_supported__match_generic)
+{
+    const auto data = to_chunk(std::string("passphrase"));
+    const auto salt = to_chunk(std::string("salt"));
+
+    BOOST_REQUIRE(select_scrypt_implementation("generic"));
+    std::vector<data_chunk> expected;
+    for (uint32_t p = 1; p <= 5; ++p)
+        for (uint32_t r = 1; r <= 3; ++r)
+            expected.push_back(scrypt_context(64, p, r).hash(data, salt, 80));
+
+    const auto implementations = scrypt_implementations();
+    for (const auto& implementation: implementations)
+    {
+        BOOST_TEST_MESSAGE(implementation);
+        BOOST_REQUIRE(select_scrypt_implementation(implementation));
+
+        auto result = expected.begin();
+        for (uint32_t p = 1; p <= 5; ++p)
+            for (uint32_t r = 1; r <= 3; ++r)
+                BOOST_REQUIRE(scrypt_context(64, p, r).hash(data, salt,
+                    80) == *result++);
+
+        BOOST_REQUIRE_EQUAL(scrypt_base16("password", "NaCl", 1024, 16, 8),
+            rfc7914_password);
+    }
+
+    BOOST_REQUIRE(select_scrypt_implementation(implementations.front()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
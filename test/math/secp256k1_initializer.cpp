@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(secp256k1_initializer_tests)
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__context__repeated__created_once)
+{
+    secp256k1_verification instance;
+    const auto context = instance.context();
+    BOOST_REQUIRE(context != nullptr);
+    BOOST_REQUIRE_EQUAL(instance.context(), context);
+    BOOST_REQUIRE_EQUAL(instance.metrics().create.count(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.metrics().clone.count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__initialize__then_context__created_once)
+{
+    secp256k1_signing instance;
+    instance.initialize();
+    BOOST_REQUIRE_EQUAL(instance.metrics().create.count(), 1u);
+    BOOST_REQUIRE(instance.context() != nullptr);
+    BOOST_REQUIRE_EQUAL(instance.metrics().create.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__context__per_thread__distinct_clones)
+{
+    secp256k1_verification instance;
+    const auto shared = instance.context();
+    instance.set_per_thread(true);
+
+    const auto local = instance.context();
+    BOOST_REQUIRE(local != shared);
+    BOOST_REQUIRE_EQUAL(instance.context(), local);
+
+    secp256k1_context* other = nullptr;
+    std::thread thread([&instance, &other]()
+    {
+        other = instance.context();
+    });
+
+    thread.join();
+    BOOST_REQUIRE(other != nullptr);
+    BOOST_REQUIRE(other != shared);
+    BOOST_REQUIRE(other != local);
+    BOOST_REQUIRE_EQUAL(instance.metrics().clone.count(), 2u);
+
+    instance.set_per_thread(false);
+    BOOST_REQUIRE_EQUAL(instance.context(), shared);
+}
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__context__verification__not_randomized)
+{
+    secp256k1_verification instance;
+    instance.set_per_thread(true);
+    instance.set_randomize_interval(1);
+    instance.context();
+    instance.context();
+    BOOST_REQUIRE_EQUAL(instance.metrics().randomize.count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__context__signing_interval__randomized)
+{
+    secp256k1_signing instance;
+    instance.set_per_thread(true);
+    instance.set_randomize_interval(2);
+
+    // Shared creation and the clone are each randomized once.
+    instance.context();
+    BOOST_REQUIRE_EQUAL(instance.metrics().randomize.count(), 2u);
+
+    // Then once per two subsequent uses.
+    for (size_t use = 0; use < 5; ++use)
+        instance.context();
+
+    BOOST_REQUIRE_EQUAL(instance.metrics().randomize.count(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(secp256k1_initializer__context__zero_interval__not_rerandomized)
+{
+    secp256k1_signing instance;
+    instance.set_per_thread(true);
+    instance.set_randomize_interval(0);
+
+    for (size_t use = 0; use < 5; ++use)
+        instance.context();
+
+    BOOST_REQUIRE_EQUAL(instance.metrics().randomize.count(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <future>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(signature_batch_tests)
+
+static data_chunk make_point(uint8_t fill)
+{
+    data_chunk point(ec_compressed_size, fill);
+    point[0] = 0x02;
+    return point;
+}
+
+static const hash_digest sighash = null_hash;
+static const endorsement signature{ 0x30, 0x06, 0x02, 0x01, 0x01, 0x02,
+    0x01, 0x01 };
+
+BOOST_AUTO_TEST_CASE(signature_batch__add__triples__indexed_in_order)
+{
+    signature_batch batch;
+    BOOST_REQUIRE_EQUAL(batch.add(make_point(1), sighash, signature), 0u);
+    BOOST_REQUIRE_EQUAL(batch.add(make_point(1), sighash, signature), 1u);
+    BOOST_REQUIRE_EQUAL(batch.add(make_point(2), sighash, signature), 2u);
+    BOOST_REQUIRE_EQUAL(batch.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_batch__verify__empty__empty)
+{
+    signature_batch batch;
+    BOOST_REQUIRE(batch.verify().empty());
+}
+
+BOOST_AUTO_TEST_CASE(signature_batch__verify__invalid_point__false)
+{
+    signature_batch batch;
+    batch.add(data_chunk(ec_compressed_size, 0x05), sighash, signature);
+    batch.add(data_chunk{ 0x02 }, sighash, signature);
+    const auto valid = batch.verify();
+    BOOST_REQUIRE_EQUAL(valid.size(), 2u);
+    BOOST_REQUIRE(!valid[0]);
+    BOOST_REQUIRE(!valid[1]);
+    BOOST_REQUIRE_EQUAL(batch.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_batch__verify__cached__true)
+{
+    signature_cache cache(10);
+    cache.insert(make_point(1), sighash, signature);
+
+    signature_batch batch(cache);
+    batch.add(make_point(2), sighash, signature);
+    batch.add(make_point(1), sighash, signature);
+    const auto valid = batch.verify();
+    BOOST_REQUIRE_EQUAL(valid.size(), 2u);
+    BOOST_REQUIRE(!valid[0]);
+    BOOST_REQUIRE(valid[1]);
+}
+
+BOOST_AUTO_TEST_CASE(signature_batch__verify_pool__cached__results_in_order)
+{
+    static const size_t count = 100;
+    signature_cache cache(count);
+    signature_batch batch(cache);
+
+    for (uint8_t fill = 0; fill < count; ++fill)
+    {
+        if (fill % 3 == 0)
+            cache.insert(make_point(fill), sighash, signature);
+
+        batch.add(make_point(fill), sighash, signature);
+    }
+
+    threadpool pool(4);
+    std::promise<std::vector<bool>> promise;
+    batch.verify(pool, [&promise](const std::vector<bool>& valid)
+    {
+        promise.set_value(valid);
+    });
+
+    const auto valid = promise.get_future().get();
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(valid.size(), count);
+
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(valid[index], index % 3 == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
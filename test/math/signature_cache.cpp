@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(signature_cache_tests)
+
+static data_chunk make_point(uint8_t fill)
+{
+    data_chunk point(ec_compressed_size, fill);
+    point[0] = 0x02;
+    return point;
+}
+
+static const hash_digest sighash = null_hash;
+static const endorsement signature{ 0x30, 0x06, 0x02, 0x01, 0x01, 0x02,
+    0x01, 0x01 };
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__inserted__true)
+{
+    signature_cache cache(10);
+    const auto point = make_point(1);
+    BOOST_REQUIRE(!cache.contains(point, sighash, signature));
+    cache.insert(point, sighash, signature);
+    BOOST_REQUIRE(cache.contains(point, sighash, signature));
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__contains__different_component__false)
+{
+    signature_cache cache(10);
+    const auto point = make_point(1);
+    cache.insert(point, sighash, signature);
+
+    auto other_hash = sighash;
+    other_hash[0] = 1;
+    auto other_signature = signature;
+    other_signature.back() = 2;
+
+    BOOST_REQUIRE(!cache.contains(make_point(2), sighash, signature));
+    BOOST_REQUIRE(!cache.contains(point, other_hash, signature));
+    BOOST_REQUIRE(!cache.contains(point, sighash, other_signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__insert__duplicate__not_counted)
+{
+    signature_cache cache(10);
+    const auto point = make_point(1);
+    cache.insert(point, sighash, signature);
+    cache.insert(point, sighash, signature);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__insert__full__evicts_one)
+{
+    static const size_t capacity = 8;
+    signature_cache cache(capacity);
+
+    for (uint8_t fill = 0; fill < 2 * capacity; ++fill)
+    {
+        cache.insert(make_point(fill), sighash, signature);
+        BOOST_REQUIRE(cache.contains(make_point(fill), sighash, signature));
+    }
+
+    BOOST_REQUIRE_EQUAL(cache.size(), capacity);
+
+    size_t found = 0;
+    for (uint8_t fill = 0; fill < 2 * capacity; ++fill)
+        if (cache.contains(make_point(fill), sighash, signature))
+            ++found;
+
+    BOOST_REQUIRE_EQUAL(found, capacity);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__insert__zero_capacity__empty)
+{
+    signature_cache cache(0);
+    cache.insert(make_point(1), sighash, signature);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE(!cache.contains(make_point(1), sighash, signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__clear__inserted__empty)
+{
+    signature_cache cache(10);
+    cache.insert(make_point(1), sighash, signature);
+    cache.clear();
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    BOOST_REQUIRE(!cache.contains(make_point(1), sighash, signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__verify__cached__true)
+{
+    signature_cache cache(10);
+    const auto point = make_point(1);
+    BOOST_REQUIRE(!cache.verify(point, sighash, signature));
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+    cache.insert(point, sighash, signature);
+    BOOST_REQUIRE(cache.verify(point, sighash, signature));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
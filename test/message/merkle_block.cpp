@@ -122,4 +122,15 @@ BOOST_AUTO_TEST_CASE(roundtrip_to_data_factory_from_data_reader)
     BOOST_REQUIRE(expected == result);
 }
 
+BOOST_AUTO_TEST_CASE(factory_from_block__genesis_matched__coinbase_proof)
+{
+    const auto genesis = genesis_block();
+    const auto instance = message::merkle_block::factory_from_block(genesis, { true });
+
+    BOOST_REQUIRE(instance.header == genesis.header);
+    BOOST_REQUIRE_EQUAL(instance.header.transaction_count, 1u);
+    BOOST_REQUIRE(instance.hashes == hash_list{ genesis.transactions[0].hash() });
+    BOOST_REQUIRE(instance.flags == data_chunk{ 0x01 });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::network;
+
+// An unconnected channel, which has the default authority.
+static channel::ptr make_channel(threadpool& pool, uint64_t nonce)
+{
+    const auto socket = std::make_shared<asio::socket>(pool.service());
+    const auto result = std::make_shared<channel>(pool, socket, p2p::testnet);
+    result->set_nonce(nonce);
+    return result;
+}
+
+BOOST_AUTO_TEST_SUITE(connections_tests)
+
+BOOST_AUTO_TEST_CASE(connections__store__same_authority__address_in_use)
+{
+    threadpool pool(1);
+    connections instance;
+    const auto channel = make_channel(pool, 0);
+
+    code result(error::unknown);
+    instance.store(channel, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    BOOST_REQUIRE(instance.exists(channel->authority()));
+
+    instance.store(make_channel(pool, 0),
+        [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::address_in_use);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    instance.remove(channel, [](const code&) {});
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(connections__remove__other_channel__not_found)
+{
+    threadpool pool(1);
+    connections instance;
+    const auto channel = make_channel(pool, 0);
+    instance.store(channel, [](const code&) {});
+
+    code result(error::unknown);
+    instance.remove(make_channel(pool, 0),
+        [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::not_found);
+
+    instance.remove(channel, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+
+    size_t count = 1;
+    instance.count([&count](size_t value) { count = value; });
+    BOOST_REQUIRE_EQUAL(count, 0u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
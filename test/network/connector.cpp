@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdint>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::network;
+
+// The pool has no threads, the test runs its service to completion.
+#define LISTEN_LOOPBACK(pool, listener, port) \
+    threadpool pool(0); \
+    asio::acceptor listener(pool.service(), \
+        asio::endpoint(asio::ipv4::loopback(), 0)); \
+    const auto port = listener.local_endpoint().port()
+
+BOOST_AUTO_TEST_SUITE(connector_tests)
+
+BOOST_AUTO_TEST_CASE(connector__connect__numeric_host__not_resolved)
+{
+    LISTEN_LOOPBACK(pool, listener, port);
+    connector::statistics statistics;
+    const auto instance = std::make_shared<connector>(pool, p2p::testnet,
+        statistics);
+
+    code result(error::unknown);
+    instance->connect("127.0.0.1", port,
+        [&result](const code& ec, channel::ptr) { result = ec; });
+    pool.service().run();
+
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    BOOST_REQUIRE_EQUAL(statistics.resolve.count(), 0u);
+    BOOST_REQUIRE_EQUAL(statistics.connect.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(connector__connect__ipv4_mapped_authority__success)
+{
+    LISTEN_LOOPBACK(pool, listener, port);
+    connector::statistics statistics;
+    const auto instance = std::make_shared<connector>(pool, p2p::testnet,
+        statistics);
+    const config::authority host(asio::address(asio::ipv4::loopback()),
+        port);
+
+    code result(error::unknown);
+    instance->connect(host,
+        [&result](const code& ec, channel::ptr) { result = ec; });
+    pool.service().run();
+
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    BOOST_REQUIRE_EQUAL(statistics.resolve.count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(connector__connect__over_limit__queued)
+{
+    LISTEN_LOOPBACK(pool, listener, port);
+    auto settings = p2p::testnet;
+    settings.connect_limit = 1;
+    connector::statistics statistics;
+    const auto instance = std::make_shared<connector>(pool, settings,
+        statistics);
+
+    size_t connected = 0;
+    const auto handler = [&connected](const code& ec, channel::ptr)
+    {
+        if (!ec)
+            ++connected;
+    };
+
+    instance->connect("127.0.0.1", port, handler);
+    instance->connect("127.0.0.1", port, handler);
+    BOOST_REQUIRE_EQUAL(instance->in_flight(), 1u);
+    pool.service().run();
+
+    BOOST_REQUIRE_EQUAL(connected, 2u);
+    BOOST_REQUIRE_EQUAL(instance->in_flight(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(connector__cancel__queued__service_stopped)
+{
+    LISTEN_LOOPBACK(pool, listener, port);
+    auto settings = p2p::testnet;
+    settings.connect_limit = 1;
+    connector::statistics statistics;
+    const auto instance = std::make_shared<connector>(pool, settings,
+        statistics);
+
+    code first(error::unknown);
+    code second(error::unknown);
+    instance->connect("127.0.0.1", port,
+        [&first](const code& ec, channel::ptr) { first = ec; });
+    instance->connect("127.0.0.1", port,
+        [&second](const code& ec, channel::ptr) { second = ec; });
+    instance->cancel();
+    BOOST_REQUIRE_EQUAL(second, error::service_stopped);
+    pool.service().run();
+
+    BOOST_REQUIRE_EQUAL(first, error::success);
+    BOOST_REQUIRE_EQUAL(instance->in_flight(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,324 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::network;
+
+BOOST_AUTO_TEST_SUITE(hosts_tests)
+
+static settings make_settings(uint32_t capacity, const std::string& file)
+{
+    settings config = p2p::testnet;
+    config.host_pool_capacity = capacity;
+    config.hosts_file = file;
+    boost::filesystem::remove_all(file);
+    return config;
+}
+
+// An IPv4 address in the 10.index/16 group.
+static message::network_address make_host(uint8_t group, uint8_t index,
+    uint16_t port=8333)
+{
+    return config::authority(message::ip_address
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0xff, 0xff, 0x0a, group, 0x00, index
+    }, port).to_network_address();
+}
+
+static size_t count(const hosts& instance)
+{
+    size_t result = 0;
+    instance.count([&result](size_t value) { result = value; });
+    return result;
+}
+
+static code run(hosts& instance, bool save)
+{
+    std::promise<code> promise;
+    const auto handler = [&promise](const code& ec)
+    {
+        promise.set_value(ec);
+    };
+
+    if (save)
+        instance.save(handler);
+    else
+        instance.load(handler);
+
+    return promise.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store__duplicate__stored_once)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_duplicate.cache"));
+    instance.store(make_host(1, 1), [](const code&) {});
+    instance.store(make_host(1, 1), [](const code&) {});
+    instance.store(make_host(1, 2), [](const code&) {});
+    BOOST_REQUIRE_EQUAL(count(instance), 2u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store__zero_port__discarded)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_port.cache"));
+    instance.store(make_host(1, 1, 0), [](const code&) {});
+    BOOST_REQUIRE_EQUAL(count(instance), 0u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store__over_capacity__limited)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(8, "hosts_capacity.cache"));
+
+    for (uint8_t index = 0; index < 100; ++index)
+        instance.store(make_host(index, index), [](const code&) {});
+
+    // One quarter of the capacity is reserved for tried hosts.
+    BOOST_REQUIRE_EQUAL(count(instance), 6u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store__same_group__limited_to_bucket)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(1000, "hosts_group.cache"));
+
+    for (uint8_t index = 0; index < 100; ++index)
+        instance.store(make_host(1, index), [](const code&) {});
+
+    // A group occupies one sixteen host bucket of the new table.
+    BOOST_REQUIRE_EQUAL(count(instance), 16u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store_list__mixed__counted)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_list.cache"));
+    instance.store(make_host(1, 1), [](const code&) {});
+
+    const hosts::address::list list
+    {
+        make_host(1, 1),
+        make_host(1, 2),
+        make_host(1, 2),
+        make_host(1, 3, 0),
+        hosts::address(),
+        make_host(2, 1)
+    };
+
+    code result(error::unknown);
+    hosts::store_counts counts{ 0, 0, 0, 0 };
+    instance.store(list, [&](const code& ec, const hosts::store_counts& value)
+    {
+        result = ec;
+        counts = value;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    BOOST_REQUIRE_EQUAL(counts.accepted, 2u);
+    BOOST_REQUIRE_EQUAL(counts.duplicate, 2u);
+    BOOST_REQUIRE_EQUAL(counts.invalid, 2u);
+    BOOST_REQUIRE_EQUAL(counts.evicted, 0u);
+    BOOST_REQUIRE_EQUAL(count(instance), 3u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__store_list__over_capacity__evicted_counted)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(8, "hosts_evict.cache"));
+
+    hosts::address::list list;
+    for (uint8_t index = 0; index < 10; ++index)
+        list.push_back(make_host(index, index));
+
+    hosts::store_counts counts{ 0, 0, 0, 0 };
+    instance.store(list, [&counts](const code&,
+        const hosts::store_counts& value)
+    {
+        counts = value;
+    });
+
+    BOOST_REQUIRE_EQUAL(counts.accepted, 10u);
+    BOOST_REQUIRE_EQUAL(counts.evicted, 4u);
+    BOOST_REQUIRE_EQUAL(count(instance), 6u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__fetch__empty__not_found)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_empty.cache"));
+
+    code result(error::success);
+    instance.fetch([&result](const code& ec, const hosts::address&)
+    {
+        result = ec;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, error::not_found);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__fetch__one__stored_host)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_fetch.cache"));
+    const auto host = make_host(1, 1);
+    instance.store(host, [](const code&) {});
+
+    hosts::address result;
+    instance.fetch([&result](const code&, const hosts::address& value)
+    {
+        result = value;
+    });
+
+    BOOST_REQUIRE(config::authority(result) == config::authority(host));
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__remove__stored__not_found_after)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_remove.cache"));
+    const auto host = make_host(1, 1);
+    instance.store(host, [](const code&) {});
+
+    code result(error::unknown);
+    instance.remove(host, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    instance.remove(host, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::not_found);
+    BOOST_REQUIRE_EQUAL(count(instance), 0u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__attempt__repeated_failure__dropped)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_attempt.cache"));
+    const auto host = make_host(1, 1);
+    instance.store(host, [](const code&) {});
+
+    for (size_t attempt = 0; attempt < 10; ++attempt)
+        instance.attempt(host, [](const code&) {});
+
+    BOOST_REQUIRE_EQUAL(count(instance), 0u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__confirm__tried__retained_after_attempts)
+{
+    threadpool pool(1);
+    hosts instance(pool, make_settings(100, "hosts_confirm.cache"));
+    const auto host = make_host(1, 1);
+    instance.store(host, [](const code&) {});
+
+    code result(error::unknown);
+    instance.confirm(host, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+
+    for (size_t attempt = 0; attempt < 10; ++attempt)
+        instance.attempt(host, [](const code&) {});
+
+    BOOST_REQUIRE_EQUAL(count(instance), 1u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__save_load__round_trip__restored)
+{
+    threadpool pool(1);
+    const auto config = make_settings(100, "hosts_round_trip.cache");
+    hosts source(pool, config);
+
+    for (uint8_t index = 0; index < 10; ++index)
+        source.store(make_host(index, index), [](const code&) {});
+
+    source.confirm(make_host(0, 0), [](const code&) {});
+    BOOST_REQUIRE_EQUAL(run(source, true), error::success);
+
+    hosts target(pool, config);
+    BOOST_REQUIRE_EQUAL(run(target, false), error::success);
+    BOOST_REQUIRE_EQUAL(count(target), 10u);
+
+    // The tried host remains tried, so it survives repeated attempts.
+    for (size_t attempt = 0; attempt < 10; ++attempt)
+        target.attempt(make_host(0, 0), [](const code&) {});
+
+    BOOST_REQUIRE_EQUAL(count(target), 10u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(hosts__load__text_file__migrated)
+{
+    threadpool pool(1);
+    const auto config = make_settings(100, "hosts_text.cache");
+
+    {
+        bc::ofstream file(config.hosts_file.string());
+        file << "10.0.0.1:8333" << std::endl;
+        file << "[2001:db8::1]:8333" << std::endl;
+    }
+
+    hosts instance(pool, config);
+    BOOST_REQUIRE_EQUAL(run(instance, false), error::success);
+    BOOST_REQUIRE_EQUAL(count(instance), 2u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::network;
+
+// An unconnected channel, which has the default authority.
+static channel::ptr make_channel(threadpool& pool, uint64_t nonce)
+{
+    const auto socket = std::make_shared<asio::socket>(pool.service());
+    const auto result = std::make_shared<channel>(pool, socket, p2p::testnet);
+    result->set_nonce(nonce);
+    return result;
+}
+
+BOOST_AUTO_TEST_SUITE(pending_tests)
+
+BOOST_AUTO_TEST_CASE(pending__store__distinct_nonces__exists)
+{
+    threadpool pool(1);
+    pending instance;
+    const auto first = make_channel(pool, 42);
+    const auto second = make_channel(pool, 43);
+
+    code result(error::unknown);
+    instance.store(first, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    instance.store(second, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+
+    BOOST_REQUIRE(instance.exists(42));
+    BOOST_REQUIRE(instance.exists(43));
+    BOOST_REQUIRE(!instance.exists(44));
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    instance.clear(error::service_stopped);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(pending__store__duplicate_nonce__address_in_use)
+{
+    threadpool pool(1);
+    pending instance;
+
+    code result(error::unknown);
+    instance.store(make_channel(pool, 42), [](const code&) {});
+    instance.store(make_channel(pool, 42),
+        [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::address_in_use);
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    instance.clear(error::service_stopped);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(pending__exists__zero_nonce__false)
+{
+    threadpool pool(1);
+    pending instance;
+    instance.store(make_channel(pool, 0), [](const code&) {});
+
+    bool found = true;
+    instance.exists(0, [&found](bool value) { found = value; });
+    BOOST_REQUIRE(!found);
+    instance.clear(error::service_stopped);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(pending__remove__reset_nonce__removed)
+{
+    threadpool pool(1);
+    pending instance;
+    const auto channel = make_channel(pool, 42);
+    instance.store(channel, [](const code&) {});
+    channel->set_nonce(0);
+
+    code result(error::unknown);
+    instance.remove(channel, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::success);
+    BOOST_REQUIRE(!instance.exists(42));
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+
+    instance.remove(channel, [&result](const code& ec) { result = ec; });
+    BOOST_REQUIRE_EQUAL(result, error::not_found);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <memory>
+#include <utility>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(buffer_pool_tests)
+
+BOOST_AUTO_TEST_CASE(buffer_pool__get__new__expected_size)
+{
+    buffer_pool pool(2, 100);
+    const auto buffer = pool.get(42);
+    BOOST_REQUIRE_EQUAL(buffer->size(), 42u);
+    BOOST_REQUIRE_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__get__released__reused)
+{
+    buffer_pool pool(2, 100);
+    auto buffer = pool.get(50);
+    const auto address = buffer->data();
+    buffer.reset();
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+
+    const auto reused = pool.get(40);
+    BOOST_REQUIRE_EQUAL(pool.size(), 0u);
+    BOOST_REQUIRE_EQUAL(reused->size(), 40u);
+    BOOST_REQUIRE(reused->data() == address);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__shared__returned_after_last)
+{
+    buffer_pool pool(2, 100);
+    std::shared_ptr<data_chunk> buffer = pool.get(10);
+    auto copy = buffer;
+    buffer.reset();
+    BOOST_REQUIRE_EQUAL(pool.size(), 0u);
+    copy.reset();
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__moved__returned_once)
+{
+    buffer_pool pool(2, 100);
+    auto buffer = pool.get(10);
+    const auto moved = std::move(buffer);
+    BOOST_REQUIRE(!buffer);
+    BOOST_REQUIRE_EQUAL(moved->size(), 10u);
+    buffer.reset();
+    BOOST_REQUIRE_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__over_limit__freed)
+{
+    buffer_pool pool(1, 100);
+    auto first = pool.get(10);
+    auto second = pool.get(10);
+    first.reset();
+    second.reset();
+    BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__oversized__freed)
+{
+    buffer_pool pool(2, 100);
+    pool.get(101);
+    BOOST_REQUIRE_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__after_pool__freed)
+{
+    buffer_pool::ptr buffer;
+    {
+        buffer_pool pool(2, 100);
+        buffer = pool.get(10);
+    }
+
+    BOOST_REQUIRE_EQUAL(buffer->size(), 10u);
+    buffer.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
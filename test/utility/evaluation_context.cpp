@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../../src/utility/evaluation_context.hpp"
+#include "../../src/utility/stack_element.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(evaluation_context_tests)
+
+static data_chunk to_chunk(const stack_element& element)
+{
+    return data_chunk(element.begin(), element.end());
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_context__pop_primary__top__returned_and_removed)
+{
+    evaluation_context context;
+    context.primary.push_back(data_chunk{ 0x01 });
+    context.primary.push_back(data_chunk(200, 0x02));
+    const auto top = context.pop_primary();
+    BOOST_REQUIRE(to_chunk(top) == data_chunk(200, 0x02));
+    BOOST_REQUIRE_EQUAL(context.primary.size(), 1u);
+    BOOST_REQUIRE(to_chunk(context.primary.back()) == data_chunk{ 0x01 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_context__pop_primary__then_push__value_retained)
+{
+    evaluation_context context;
+    context.primary.push_back(data_chunk{ 0x01 });
+    const auto top = context.pop_primary();
+
+    // The popped element is retained by the stack and overwritten here.
+    context.primary.push_back(data_chunk{ 0x02 });
+    BOOST_REQUIRE(to_chunk(top) == data_chunk{ 0x01 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_context__alt_stack__round_trip__order_preserved)
+{
+    evaluation_context context;
+    context.primary.push_back(data_chunk{ 0x01 });
+    context.primary.push_back(data_chunk{ 0x02 });
+    context.primary.push_back(data_chunk(100, 0x03));
+
+    // OP_TOALTSTACK three times reverses the items onto the secondary stack.
+    for (auto count = 0; count < 3; ++count)
+        context.secondary.push_back(context.pop_primary());
+
+    BOOST_REQUIRE(context.primary.empty());
+    BOOST_REQUIRE_EQUAL(context.secondary.size(), 3u);
+    BOOST_REQUIRE(to_chunk(context.secondary.back()) == data_chunk{ 0x01 });
+
+    // OP_FROMALTSTACK three times restores the original order.
+    for (auto count = 0; count < 3; ++count)
+    {
+        context.primary.push_back(context.secondary.back());
+        context.secondary.pop_back();
+    }
+
+    BOOST_REQUIRE(context.secondary.empty());
+    BOOST_REQUIRE_EQUAL(context.primary.size(), 3u);
+    BOOST_REQUIRE(to_chunk(context.primary.back()) == data_chunk(100, 0x03));
+    context.primary.pop_back();
+    BOOST_REQUIRE(to_chunk(context.primary.back()) == data_chunk{ 0x02 });
+    context.primary.pop_back();
+    BOOST_REQUIRE(to_chunk(context.primary.back()) == data_chunk{ 0x01 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_context__clear__populated__all_empty)
+{
+    evaluation_context context;
+    context.operation_counter = 42;
+    context.primary.push_back(data_chunk{ 0x01 });
+    context.secondary.push_back(data_chunk{ 0x02 });
+    context.conditional.open(false);
+    context.clear();
+    BOOST_REQUIRE_EQUAL(context.operation_counter, 0u);
+    BOOST_REQUIRE(context.primary.empty());
+    BOOST_REQUIRE(context.secondary.empty());
+    BOOST_REQUIRE(context.conditional.closed());
+    BOOST_REQUIRE(!context.conditional.has_failed_branches());
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_context__primary_swap__between_contexts__moved)
+{
+    evaluation_context input;
+    evaluation_context output;
+    input.primary.push_back(data_chunk{ 0x01 });
+    input.primary.push_back(data_chunk{ 0x02 });
+
+    // The input stack is handed to the output phase by swap.
+    output.clear();
+    output.primary.swap(input.primary);
+    BOOST_REQUIRE(input.primary.empty());
+    BOOST_REQUIRE_EQUAL(output.primary.size(), 2u);
+    BOOST_REQUIRE(to_chunk(output.primary.back()) == data_chunk{ 0x02 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../../src/utility/evaluation_stack.hpp"
+#include "../../src/utility/stack_element.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(evaluation_stack_tests)
+
+static data_chunk to_chunk(const stack_element& element)
+{
+    return data_chunk(element.begin(), element.end());
+}
+
+static evaluation_stack make_stack(size_t count)
+{
+    evaluation_stack stack;
+
+    for (size_t index = 0; index < count; ++index)
+        stack.push_back(data_chunk{ static_cast<uint8_t>(index) });
+
+    return stack;
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__constructor__default__empty)
+{
+    const evaluation_stack stack;
+    BOOST_REQUIRE(stack.empty());
+    BOOST_REQUIRE_EQUAL(stack.size(), 0u);
+    BOOST_REQUIRE(stack.begin() == stack.end());
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__push_back__data__back_is_last)
+{
+    evaluation_stack stack;
+    stack.push_back(data_chunk{ 0x01 });
+    stack.push_back(data_chunk{ 0x02, 0x03 });
+    BOOST_REQUIRE_EQUAL(stack.size(), 2u);
+    BOOST_REQUIRE(to_chunk(stack.back()) == (data_chunk{ 0x02, 0x03 }));
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__pop_back__all__empty)
+{
+    auto stack = make_stack(3);
+    stack.pop_back();
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x01 });
+    stack.pop_back();
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x00 });
+    stack.pop_back();
+    BOOST_REQUIRE(stack.empty());
+    BOOST_REQUIRE(stack.begin() == stack.end());
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__push_back__after_pop__reuses_element)
+{
+    evaluation_stack stack;
+    stack.push_back(data_chunk(520, 0x01));
+    const auto buffer = stack.back().data();
+    stack.pop_back();
+    const data_chunk value(100, 0x02);
+    stack.push_back(value);
+    BOOST_REQUIRE_EQUAL(stack.size(), 1u);
+    BOOST_REQUIRE(stack.back().data() == buffer);
+    BOOST_REQUIRE(to_chunk(stack.back()) == value);
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__push_back__own_back_data__copied)
+{
+    auto stack = make_stack(1);
+
+    // Push from the element itself until the vector has had to relocate.
+    for (auto count = 0; count < 64; ++count)
+    {
+        const auto& top = stack.back();
+        stack.push_back(data_slice(top.begin(), top.end()));
+    }
+
+    BOOST_REQUIRE_EQUAL(stack.size(), 65u);
+
+    for (const auto& element: stack)
+        BOOST_REQUIRE(to_chunk(element) == data_chunk{ 0x00 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__push_back__own_back__copied)
+{
+    evaluation_stack stack;
+    stack.push_back(data_chunk(200, 0x07));
+
+    for (auto count = 0; count < 64; ++count)
+        stack.push_back(stack.back());
+
+    BOOST_REQUIRE_EQUAL(stack.size(), 65u);
+
+    for (const auto& element: stack)
+        BOOST_REQUIRE(to_chunk(element) == data_chunk(200, 0x07));
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__insert__middle__shifts_above)
+{
+    auto stack = make_stack(3);
+    const stack_element value(data_chunk{ 0x42 });
+    stack.insert(stack.begin() + 1, value);
+    BOOST_REQUIRE_EQUAL(stack.size(), 4u);
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 0)) == data_chunk{ 0x00 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 1)) == data_chunk{ 0x42 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 2)) == data_chunk{ 0x01 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 3)) == data_chunk{ 0x02 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__insert__end__is_back)
+{
+    auto stack = make_stack(2);
+    stack.insert(stack.end(), stack_element(data_chunk{ 0x42 }));
+    BOOST_REQUIRE_EQUAL(stack.size(), 3u);
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x42 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__erase__one__shifts_above)
+{
+    auto stack = make_stack(4);
+    stack.erase(stack.begin() + 1);
+    BOOST_REQUIRE_EQUAL(stack.size(), 3u);
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 0)) == data_chunk{ 0x00 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 1)) == data_chunk{ 0x02 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 2)) == data_chunk{ 0x03 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__erase__range__shifts_above)
+{
+    auto stack = make_stack(5);
+    stack.erase(stack.begin() + 1, stack.begin() + 3);
+    BOOST_REQUIRE_EQUAL(stack.size(), 3u);
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 0)) == data_chunk{ 0x00 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 1)) == data_chunk{ 0x03 });
+    BOOST_REQUIRE(to_chunk(*(stack.begin() + 2)) == data_chunk{ 0x04 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__erase__all__empty)
+{
+    auto stack = make_stack(3);
+    stack.erase(stack.begin(), stack.end());
+    BOOST_REQUIRE(stack.empty());
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__clear__push_back__reuses_elements)
+{
+    auto stack = make_stack(3);
+    stack.clear();
+    BOOST_REQUIRE(stack.empty());
+    stack.push_back(data_chunk{ 0x42 });
+    BOOST_REQUIRE_EQUAL(stack.size(), 1u);
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x42 });
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__assign__larger_and_smaller__copies)
+{
+    const auto three = make_stack(3);
+    const auto one = make_stack(1);
+    evaluation_stack stack;
+    stack.assign(three);
+    BOOST_REQUIRE_EQUAL(stack.size(), 3u);
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x02 });
+    stack.assign(one);
+    BOOST_REQUIRE_EQUAL(stack.size(), 1u);
+    BOOST_REQUIRE(to_chunk(stack.back()) == data_chunk{ 0x00 });
+    BOOST_REQUIRE_EQUAL(three.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(evaluation_stack__swap__different_sizes__exchanged)
+{
+    auto left = make_stack(3);
+    auto right = make_stack(1);
+    left.swap(right);
+    BOOST_REQUIRE_EQUAL(left.size(), 1u);
+    BOOST_REQUIRE_EQUAL(right.size(), 3u);
+    BOOST_REQUIRE(to_chunk(left.back()) == data_chunk{ 0x00 });
+    BOOST_REQUIRE(to_chunk(right.back()) == data_chunk{ 0x02 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+typedef histogram::duration duration;
+
+BOOST_AUTO_TEST_SUITE(histogram_tests)
+
+BOOST_AUTO_TEST_CASE(histogram__construct__empty)
+{
+    histogram instance;
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+    BOOST_REQUIRE(instance.mean() == duration(0));
+    BOOST_REQUIRE(instance.percentile(0.5) == duration(0));
+}
+
+BOOST_AUTO_TEST_CASE(histogram__record__power_of_two_buckets)
+{
+    histogram instance;
+    instance.record(duration(0));
+    instance.record(duration(1));
+    instance.record(duration(3));
+    instance.record(duration(4));
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.count(0), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(1), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(2), 1u);
+    BOOST_REQUIRE_EQUAL(instance.count(3), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(histogram__record__negative__first_bucket)
+{
+    histogram instance;
+    instance.record(duration(-5));
+    BOOST_REQUIRE_EQUAL(instance.count(0), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(histogram__record__overflow__last_bucket)
+{
+    histogram instance;
+    instance.record(std::chrono::hours(24 * 365));
+    BOOST_REQUIRE_EQUAL(instance.count(histogram::buckets - 1), 1u);
+    BOOST_REQUIRE(instance.percentile(1.0) == duration::max());
+}
+
+BOOST_AUTO_TEST_CASE(histogram__mean__samples__expected)
+{
+    histogram instance;
+    instance.record(duration(10));
+    instance.record(duration(30));
+    BOOST_REQUIRE(instance.mean() == duration(20));
+}
+
+BOOST_AUTO_TEST_CASE(histogram__percentile__samples__bucket_upper_bounds)
+{
+    histogram instance;
+    for (auto sample = 0; sample < 90; ++sample)
+        instance.record(duration(100));
+
+    for (auto sample = 0; sample < 10; ++sample)
+        instance.record(duration(5000));
+
+    BOOST_REQUIRE(instance.percentile(0.0) == duration(128));
+    BOOST_REQUIRE(instance.percentile(0.5) == duration(128));
+    BOOST_REQUIRE(instance.percentile(0.9) == duration(128));
+    BOOST_REQUIRE(instance.percentile(0.91) == duration(8192));
+    BOOST_REQUIRE(instance.percentile(1.0) == duration(8192));
+}
+
+BOOST_AUTO_TEST_CASE(histogram__reset__samples__empty)
+{
+    histogram instance;
+    instance.record(duration(42));
+    instance.reset();
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+    BOOST_REQUIRE(instance.mean() == duration(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ostream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+// Counts the number of times it is formatted.
+struct formatted
+{
+    size_t& count;
+};
+
+static std::ostream& operator<<(std::ostream& stream, const formatted& value)
+{
+    ++value.count;
+    return stream << "formatted";
+}
+
+// The null level is not otherwise used, so it is safe to reconfigure here.
+BOOST_AUTO_TEST_SUITE(log_tests)
+
+BOOST_AUTO_TEST_CASE(log__stream__disabled_level__not_formatted)
+{
+    size_t count = 0;
+    BOOST_REQUIRE(!bc::log::enabled(bc::log::level::null));
+    bc::log(bc::log::level::null, "test") << formatted{ count };
+    BOOST_REQUIRE_EQUAL(count, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(log__stream__enabled_level__output)
+{
+    size_t count = 0;
+    std::string output;
+    bc::log(bc::log::level::null, "").set_output_function(
+        [&output](bc::log::level, const std::string& domain,
+            const std::string& body)
+        {
+            output = domain + ":" + body;
+        });
+
+    BOOST_REQUIRE(bc::log::enabled(bc::log::level::null));
+    bc::log(bc::log::level::null, "test") << formatted{ count };
+    BOOST_REQUIRE_EQUAL(count, 1u);
+    BOOST_REQUIRE_EQUAL(output, "test:formatted");
+
+    bc::log(bc::log::level::null, "").set_output_function(nullptr);
+    BOOST_REQUIRE(!bc::log::enabled(bc::log::level::null));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
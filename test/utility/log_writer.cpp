@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+// Collects the batches written to the sink, by level.
+class collector
+{
+public:
+    void write(log::level level, const std::string& lines)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        text_ += log::to_text(level) + ":" + lines;
+    }
+
+    std::string text()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return text_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::string text_;
+};
+
+BOOST_AUTO_TEST_SUITE(log_writer_tests)
+
+BOOST_AUTO_TEST_CASE(log_writer__write__destruct__written_in_order)
+{
+    collector sink;
+
+    if (true)
+    {
+        log_writer writer([&sink](log::level level, const std::string& lines)
+        {
+            sink.write(level, lines);
+        });
+
+        writer.write(log::level::info, "test", "first");
+        writer.write(log::level::info, "test", "second");
+    }
+
+    const auto text = sink.text();
+    const auto first = text.find(" INFO [test] first\n");
+    const auto second = text.find(" INFO [test] second\n");
+    BOOST_REQUIRE(first != std::string::npos);
+    BOOST_REQUIRE(second != std::string::npos);
+    BOOST_REQUIRE(first < second);
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__write__levels__separate_batches)
+{
+    collector sink;
+
+    if (true)
+    {
+        log_writer writer([&sink](log::level level, const std::string& lines)
+        {
+            sink.write(level, lines);
+        });
+
+        writer.write(log::level::debug, "test", "detail");
+        writer.write(log::level::error, "test", "failure");
+    }
+
+    const auto text = sink.text();
+    BOOST_REQUIRE(text.find("DEBUG:") != std::string::npos);
+    BOOST_REQUIRE(text.find("ERROR:") != std::string::npos);
+    BOOST_REQUIRE(text.find(" ERROR [test] failure\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__write__empty_body__not_written)
+{
+    collector sink;
+
+    if (true)
+    {
+        log_writer writer([&sink](log::level level, const std::string& lines)
+        {
+            sink.write(level, lines);
+        });
+
+        writer.write(log::level::info, "", "");
+        writer.write(log::level::info, "test", "");
+    }
+
+    BOOST_REQUIRE(sink.text().empty());
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__destruct__steady_logging__stops)
+{
+    collector sink;
+    std::atomic<log_writer*> self(nullptr);
+
+    if (true)
+    {
+        // Each batch logs another record, so there is always one queued.
+        log_writer writer([&](log::level level, const std::string& lines)
+        {
+            sink.write(level, lines);
+            const auto writer = self.load();
+            if (writer != nullptr)
+                writer->write(log::level::info, "test", "again");
+        });
+
+        self = &writer;
+        writer.write(log::level::info, "test", "first");
+    }
+
+    BOOST_REQUIRE(sink.text().find(" INFO [test] first\n") !=
+        std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__write__alternating_writers__all_written_in_order)
+{
+    collector first_sink;
+    collector second_sink;
+
+    if (true)
+    {
+        log_writer first([&first_sink](log::level level,
+            const std::string& lines)
+        {
+            first_sink.write(level, lines);
+        });
+
+        log_writer second([&second_sink](log::level level,
+            const std::string& lines)
+        {
+            second_sink.write(level, lines);
+        });
+
+        for (auto record = 0; record < 100; ++record)
+        {
+            first.write(log::level::info, "first", std::to_string(record));
+            second.write(log::level::info, "second", std::to_string(record));
+        }
+    }
+
+    const auto first_text = first_sink.text();
+    const auto second_text = second_sink.text();
+    size_t first_position = 0;
+    size_t second_position = 0;
+
+    for (auto record = 0; record < 100; ++record)
+    {
+        const auto body = "] " + std::to_string(record) + "\n";
+        first_position = first_text.find("[first" + body, first_position);
+        second_position = second_text.find("[second" + body,
+            second_position);
+        BOOST_REQUIRE(first_position != std::string::npos);
+        BOOST_REQUIRE(second_position != std::string::npos);
+    }
+
+    BOOST_REQUIRE(first_text.find("[second]") == std::string::npos);
+    BOOST_REQUIRE(second_text.find("[first]") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__write__long_body__truncated)
+{
+    collector sink;
+    const std::string body(log_writer::record_text + 10, 'x');
+
+    if (true)
+    {
+        log_writer writer([&sink](log::level level, const std::string& lines)
+        {
+            sink.write(level, lines);
+        });
+
+        writer.write(log::level::info, "test", body);
+    }
+
+    const std::string kept(log_writer::record_text - 4, 'x');
+    BOOST_REQUIRE(sink.text().find("[test] " + kept + "...\n") !=
+        std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(log_writer__write__full_ring__dropped_and_reported)
+{
+    collector sink;
+    std::promise<void> entered;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto first = true;
+
+    if (true)
+    {
+        // The sink blocks upon its first batch, so the ring is not drained.
+        log_writer writer([&](log::level level, const std::string& lines)
+        {
+            if (first)
+            {
+                first = false;
+                entered.set_value();
+                released.wait();
+            }
+
+            sink.write(level, lines);
+        }, 4);
+
+        writer.write(log::level::info, "test", "blocking");
+        entered.get_future().wait();
+
+        for (auto record = 0; record < 6; ++record)
+            writer.write(log::level::info, "test", "queued");
+
+        BOOST_REQUIRE_EQUAL(writer.dropped(), 2u);
+        release.set_value();
+    }
+
+    BOOST_REQUIRE(sink.text().find("[log] Dropped 2 records.") !=
+        std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
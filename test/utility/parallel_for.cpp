@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+// Counts the ranges claimed by the task that owns it.
+struct claims
+{
+    claims()
+      : count(0)
+    {
+    }
+
+    size_t count;
+};
+
+BOOST_AUTO_TEST_SUITE(parallel_for_tests)
+
+BOOST_AUTO_TEST_CASE(parallel_for__pool__each_index_once)
+{
+    static const size_t count = 1000;
+    threadpool pool(3);
+    std::vector<std::atomic<size_t>> hits(count);
+    std::promise<void> done;
+
+    for (auto& hit: hits)
+        hit = 0;
+
+    const auto body = [&hits](size_t first, size_t last)
+    {
+        for (auto index = first; index < last; ++index)
+            ++hits[index];
+    };
+
+    parallel_for(pool, count, 7, body, [&done]() { done.set_value(); });
+    done.get_future().wait();
+
+    for (const auto& hit: hits)
+        BOOST_REQUIRE_EQUAL(hit.load(), 1u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for__no_threads__completes_inline)
+{
+    threadpool pool(0);
+    const auto caller = std::this_thread::get_id();
+    size_t processed = 0;
+    auto completed = false;
+
+    const auto body = [&processed, caller](size_t first, size_t last)
+    {
+        BOOST_REQUIRE(std::this_thread::get_id() == caller);
+        processed += last - first;
+    };
+
+    parallel_for(pool, 10, 3, body, [&completed]() { completed = true; });
+    BOOST_REQUIRE(completed);
+    BOOST_REQUIRE_EQUAL(processed, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for__zero_count__completes)
+{
+    threadpool pool(2);
+    std::atomic<size_t> calls(0);
+    std::promise<void> done;
+
+    const auto body = [&calls](size_t, size_t)
+    {
+        ++calls;
+    };
+
+    parallel_for(pool, 0, 4, body, [&done]() { done.set_value(); });
+    done.get_future().wait();
+    BOOST_REQUIRE_EQUAL(calls.load(), 0u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for__state__reused_across_ranges)
+{
+    threadpool pool(0);
+    size_t most = 0;
+
+    // Inline there is a single task, which claims every range.
+    const auto body = [&most](claims& state, size_t, size_t)
+    {
+        most = ++state.count;
+    };
+
+    parallel_for<claims>(pool, 10, 2, body, []() {});
+    BOOST_REQUIRE_EQUAL(most, 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(persistent_subscriber_tests)
+
+typedef persistent_subscriber<const code&, size_t> count_subscriber;
+
+BOOST_AUTO_TEST_CASE(persistent_subscriber__invoke__twice__handler_persists)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<count_subscriber>(pool);
+
+    size_t total = 0;
+    subscriber->subscribe([&total](const code&, size_t value)
+    {
+        total += value;
+    });
+
+    subscriber->invoke(error::success, 1);
+    subscriber->invoke(error::success, 2);
+    BOOST_REQUIRE_EQUAL(total, 3u);
+    BOOST_REQUIRE_EQUAL(subscriber->size(), 1u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(persistent_subscriber__subscribe__two__distinct_tokens)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<count_subscriber>(pool);
+    const auto first = subscriber->subscribe([](const code&, size_t) {});
+    const auto second = subscriber->subscribe([](const code&, size_t) {});
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE_EQUAL(subscriber->size(), 2u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(persistent_subscriber__unsubscribe__token__removes_handler)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<count_subscriber>(pool);
+
+    size_t first = 0;
+    size_t second = 0;
+    const auto token = subscriber->subscribe([&first](const code&, size_t)
+    {
+        ++first;
+    });
+    subscriber->subscribe([&second](const code&, size_t)
+    {
+        ++second;
+    });
+
+    BOOST_REQUIRE(subscriber->unsubscribe(token));
+    BOOST_REQUIRE(!subscriber->unsubscribe(token));
+    subscriber->invoke(error::success, 0);
+    BOOST_REQUIRE_EQUAL(first, 0u);
+    BOOST_REQUIRE_EQUAL(second, 1u);
+    BOOST_REQUIRE_EQUAL(subscriber->size(), 1u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(persistent_subscriber__invoke__unsubscribe_self__next_invoke_only)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<count_subscriber>(pool);
+
+    size_t calls = 0;
+    count_subscriber::token token;
+    token = subscriber->subscribe([&](const code&, size_t)
+    {
+        ++calls;
+        subscriber->unsubscribe(token);
+    });
+
+    subscriber->invoke(error::success, 0);
+    subscriber->invoke(error::success, 0);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(subscriber->size(), 0u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(persistent_subscriber__relay__subscribed__notified_on_pool)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<count_subscriber>(pool);
+
+    std::promise<size_t> promise;
+    subscriber->subscribe([&promise](const code&, size_t value)
+    {
+        promise.set_value(value);
+    });
+
+    subscriber->relay(error::success, 42);
+    BOOST_REQUIRE_EQUAL(promise.get_future().get(), 42u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
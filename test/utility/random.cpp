@@ -84,4 +84,54 @@ BOOST_AUTO_TEST_CASE(random__pseudo_randomize__superminute_ratio_255__expected)
     BOOST_REQUIRE_GE(result, minimum);
 }
 
+// RFC 8439 test vectors #1 and #2 (zero key and nonce, blocks 0 and 1).
+BOOST_AUTO_TEST_CASE(random__chacha20_engine__zero_key__expected_keystream)
+{
+    chacha20_engine engine(null_hash);
+    BOOST_REQUIRE_EQUAL(engine.next(), 0x903df1a0ade0b876u);
+    BOOST_REQUIRE_EQUAL(engine.next(), 0x28bd8653e56a5d40u);
+
+    for (size_t word = 2; word < 8; ++word)
+        engine.next();
+
+    BOOST_REQUIRE_EQUAL(engine.next(), 0x7a385155bee7079fu);
+}
+
+BOOST_AUTO_TEST_CASE(random__chacha20_engine__default__distinct_keys)
+{
+    chacha20_engine first;
+    chacha20_engine second;
+    BOOST_REQUIRE(first.next() != second.next());
+}
+
+BOOST_AUTO_TEST_CASE(random__pseudo_random__injected_engine__deterministic)
+{
+    chacha20_engine injected(null_hash);
+    chacha20_engine expected(null_hash);
+
+    set_pseudo_random_engine(&injected);
+    const auto first = pseudo_random();
+    const auto second = pseudo_random();
+    set_pseudo_random_engine(nullptr);
+
+    BOOST_REQUIRE_EQUAL(first, expected.next());
+    BOOST_REQUIRE_EQUAL(second, expected.next());
+}
+
+BOOST_AUTO_TEST_CASE(random__pseudo_random_fill__injected_engine__keystream)
+{
+    chacha20_engine injected(null_hash);
+    set_pseudo_random_engine(&injected);
+    data_chunk chunk(10);
+    pseudo_random_fill(chunk);
+    set_pseudo_random_engine(nullptr);
+
+    const data_chunk expected
+    {
+        0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d
+    };
+
+    BOOST_REQUIRE(chunk == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
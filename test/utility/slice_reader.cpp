@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(slice_reader_tests)
+
+BOOST_AUTO_TEST_CASE(slice_reader__roundtrip__serializer)
+{
+    data_chunk data(1 + 2 + 4 + 8 + 4 + 3 + 4 + 6);
+    auto sink = make_serializer(data.begin());
+    sink.write_byte(0x80);
+    sink.write_2_bytes_little_endian(0x8040);
+    sink.write_4_bytes_little_endian(0x80402010);
+    sink.write_8_bytes_little_endian(0x8040201011223344);
+    sink.write_big_endian<uint32_t>(0x80402010);
+    sink.write_variable_uint_little_endian(1234);
+    sink.write_data(to_chunk(to_little_endian<uint32_t>(0xbadf00d)));
+    sink.write_string("hello");
+
+    slice_reader source(data);
+    BOOST_REQUIRE_EQUAL(source.read_byte(), 0x80u);
+    BOOST_REQUIRE_EQUAL(source.read_2_bytes_little_endian(), 0x8040u);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_little_endian(), 0x80402010u);
+    BOOST_REQUIRE_EQUAL(source.read_8_bytes_little_endian(), 0x8040201011223344u);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_big_endian(), 0x80402010u);
+    BOOST_REQUIRE_EQUAL(source.read_variable_uint_little_endian(), 1234u);
+    BOOST_REQUIRE_EQUAL(from_little_endian_unsafe<uint32_t>(source.read_data(4).begin()), 0xbadf00du);
+    BOOST_REQUIRE_EQUAL(source.read_string(), "hello");
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE_EQUAL(source.position(), data.size());
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_slice__borrows_data)
+{
+    const data_chunk data{ 1, 2, 3, 4, 5 };
+    slice_reader source(data);
+    source.read_byte();
+    const auto slice = source.read_slice(3);
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE_EQUAL(slice.size(), 3u);
+    BOOST_REQUIRE(slice.data() == &data[1]);
+    BOOST_REQUIRE_EQUAL(source.position(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_slice__insufficient__fails)
+{
+    const data_chunk data{ 1, 2, 3 };
+    slice_reader source(data);
+    BOOST_REQUIRE(source.read_slice(4).empty());
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE(!source.is_exhausted());
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_past_end__fails_with_zero)
+{
+    const data_chunk data{ 0xff, 0xff };
+    slice_reader source(data);
+    BOOST_REQUIRE_EQUAL(source.read_4_bytes_little_endian(), 0u);
+    BOOST_REQUIRE(!source);
+    BOOST_REQUIRE_EQUAL(source.read_byte(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__read_data__short__remaining_bytes)
+{
+    const data_chunk data{ 1, 2, 3 };
+    slice_reader source(data);
+    BOOST_REQUIRE(source.read_data(5) == data);
+    BOOST_REQUIRE(!source);
+}
+
+BOOST_AUTO_TEST_CASE(slice_reader__empty__exhausted)
+{
+    const data_chunk data;
+    slice_reader source(data);
+    BOOST_REQUIRE(source);
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(source.read_data_to_eof().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../chain/genesis_block.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(slice_writer_tests)
+
+// The stream writer is the reference for the direct writer.
+template <typename Write>
+static void require_same_as_stream(size_t size, Write write)
+{
+    data_chunk expected;
+    data_sink ostream(expected);
+    ostream_writer stream_sink(ostream);
+    write(stream_sink);
+    ostream.flush();
+
+    data_chunk data(size);
+    slice_writer sink(data);
+    write(sink);
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE(sink.is_exhausted());
+    BOOST_REQUIRE_EQUAL(sink.position(), size);
+    BOOST_REQUIRE(data == expected);
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__write__matches_ostream_writer)
+{
+    require_same_as_stream(1 + 2 + 4 + 8 + 2 + 4 + 8 + 3 + 5 + 5 + 8 + 6 +
+        32 + 20 + 3, [](writer& sink)
+    {
+        sink.write_byte(0x80);
+        sink.write_2_bytes_little_endian(0x8040);
+        sink.write_4_bytes_little_endian(0x80402010);
+        sink.write_8_bytes_little_endian(0x8040201011223344);
+        sink.write_2_bytes_big_endian(0x8040);
+        sink.write_4_bytes_big_endian(0x80402010);
+        sink.write_8_bytes_big_endian(0x8040201011223344);
+        sink.write_variable_uint_little_endian(1234);
+        sink.write_variable_uint_little_endian(0x12345678);
+        sink.write_variable_uint_big_endian(0x12345678);
+        sink.write_fixed_string("abc", 8);
+        sink.write_string("hello");
+        sink.write_hash(bitcoin_hash(data_chunk{ 1 }));
+        sink.write_short_hash(bitcoin_short_hash(data_chunk{ 2 }));
+        sink.write_data(data_chunk{ 1, 2, 3 });
+    });
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__write__insufficient__fails_unwritten)
+{
+    data_chunk data{ 0xaa, 0xbb, 0xcc };
+    slice_writer sink(data);
+    sink.write_byte(0x01);
+    sink.write_4_bytes_little_endian(0x12345678);
+    BOOST_REQUIRE(!sink);
+    BOOST_REQUIRE(!sink.is_exhausted());
+
+    // Once failed, nothing further is written.
+    sink.write_byte(0x02);
+    BOOST_REQUIRE(data == (data_chunk{ 0x01, 0xbb, 0xcc }));
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__to_data__caller_memory__matches_to_data)
+{
+    const auto block = genesis_block();
+    const auto expected = block.to_data();
+
+    data_chunk buffer(expected.size() + 10, 0xff);
+    slice_writer sink(buffer.data() + 5, buffer.data() + buffer.size() - 5);
+    block.to_data(sink);
+    BOOST_REQUIRE(sink.is_exhausted());
+    BOOST_REQUIRE(std::equal(expected.begin(), expected.end(),
+        buffer.begin() + 5));
+    BOOST_REQUIRE_EQUAL(buffer.front(), 0xffu);
+    BOOST_REQUIRE_EQUAL(buffer.back(), 0xffu);
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__serialize__caller_memory__matches_heading)
+{
+    const auto block = genesis_block();
+    const auto payload = block.to_data();
+    const uint32_t magic = 0xd9b4bef9;
+
+    message::heading head;
+    head.magic = magic;
+    head.command = message::block::command;
+    head.payload_size = static_cast<uint32_t>(payload.size());
+    head.checksum = bitcoin_checksum(payload);
+    auto expected = head.to_data();
+    extend_data(expected, payload);
+
+    data_chunk buffer(expected.size() + 1);
+    const auto begin = buffer.data();
+    const auto size = message::serialize(block, magic, begin,
+        begin + buffer.size());
+    BOOST_REQUIRE_EQUAL(size, expected.size());
+    BOOST_REQUIRE(std::equal(expected.begin(), expected.end(), begin));
+    BOOST_REQUIRE(message::serialize(block, magic) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__serialize__insufficient__zero)
+{
+    const auto block = genesis_block();
+    data_chunk buffer(block.serialized_size());
+    const auto begin = buffer.data();
+    BOOST_REQUIRE_EQUAL(message::serialize(block, 0, begin,
+        begin + buffer.size()), 0u);
+}
+
+// A payload whose serialized_size is wrong by the given difference.
+class missized
+{
+public:
+    static const std::string command;
+
+    missized(int difference)
+      : difference_(difference)
+    {
+    }
+
+    uint64_t serialized_size() const
+    {
+        return 4 + difference_;
+    }
+
+    void to_data(writer& sink) const
+    {
+        sink.write_4_bytes_little_endian(0x12345678);
+    }
+
+private:
+    const int difference_;
+};
+
+const std::string missized::command = "missized";
+
+static const data_chunk missized_payload{ 0x78, 0x56, 0x34, 0x12 };
+
+BOOST_AUTO_TEST_CASE(slice_writer__to_sized_data__size_too_small__not_truncated)
+{
+    BOOST_REQUIRE(to_sized_data(missized(-3)) == missized_payload);
+    BOOST_REQUIRE(to_sized_data(missized(-4)) == missized_payload);
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__to_sized_data__size_too_large__not_padded)
+{
+    BOOST_REQUIRE(to_sized_data(missized(0)) == missized_payload);
+    BOOST_REQUIRE(to_sized_data(missized(5)) == missized_payload);
+}
+
+BOOST_AUTO_TEST_CASE(slice_writer__serialize__missized_payload__framed_as_written)
+{
+    const uint32_t magic = 0xd9b4bef9;
+    message::heading head;
+    head.magic = magic;
+    head.command = missized::command;
+    head.payload_size = static_cast<uint32_t>(missized_payload.size());
+    head.checksum = bitcoin_checksum(missized_payload);
+    const auto expected = build_chunk({ head.to_data(), missized_payload });
+
+    for (const auto difference: { -2, 3 })
+    {
+        const missized packet(difference);
+        data_chunk buffer(100);
+        const auto begin = buffer.data();
+        BOOST_REQUIRE_EQUAL(message::serialize(packet, magic, begin,
+            begin + buffer.size()), 0u);
+        BOOST_REQUIRE(message::serialize(packet, magic) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <utility>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include "../../src/utility/stack_element.hpp"
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(stack_element_tests)
+
+static data_chunk to_chunk(const stack_element& element)
+{
+    return data_chunk(element.begin(), element.end());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__default__empty)
+{
+    const stack_element instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.begin() == instance.end());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__inline_capacity__round_trips)
+{
+    const data_chunk value(stack_element::inline_capacity, 0x42);
+    const stack_element instance(value);
+    BOOST_REQUIRE_EQUAL(instance.size(), value.size());
+    BOOST_REQUIRE(to_chunk(instance) == value);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__heap__round_trips)
+{
+    const data_chunk value(stack_element::inline_capacity + 1, 0x42);
+    const stack_element instance(value);
+    BOOST_REQUIRE_EQUAL(instance.size(), value.size());
+    BOOST_REQUIRE(to_chunk(instance) == value);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__assign__heap_to_inline__round_trips)
+{
+    const data_chunk large(520, 0x01);
+    const data_chunk small{ 0x02, 0x03 };
+    stack_element instance(large);
+    instance.assign(small);
+    BOOST_REQUIRE(to_chunk(instance) == small);
+    instance.assign(large);
+    BOOST_REQUIRE(to_chunk(instance) == large);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__assign__smaller_heap_value__reuses_buffer)
+{
+    stack_element instance(data_chunk(520, 0x01));
+    const auto buffer = instance.data();
+    const data_chunk value(100, 0x02);
+    instance.assign(value);
+    BOOST_REQUIRE(instance.data() == buffer);
+    BOOST_REQUIRE(to_chunk(instance) == value);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__assign__empty__empty)
+{
+    stack_element instance(data_chunk{ 0x01 });
+    instance.assign(data_chunk{});
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__copy__inline_and_heap__equal)
+{
+    const stack_element small(data_chunk{ 0x01, 0x02 });
+    const stack_element large(data_chunk(200, 0x03));
+    const stack_element small_copy(small);
+    const stack_element large_copy(large);
+    BOOST_REQUIRE(small_copy == small);
+    BOOST_REQUIRE(large_copy == large);
+    BOOST_REQUIRE(large_copy.data() != large.data());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__move__heap__takes_buffer)
+{
+    const data_chunk value(200, 0x03);
+    stack_element source(value);
+    const auto buffer = source.data();
+    const stack_element target(std::move(source));
+    BOOST_REQUIRE(target.data() == buffer);
+    BOOST_REQUIRE(to_chunk(target) == value);
+    BOOST_REQUIRE(source.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__move_assign__inline_over_heap__round_trips)
+{
+    const data_chunk value{ 0x01, 0x02, 0x03 };
+    stack_element source(value);
+    stack_element target(data_chunk(200, 0x03));
+    target = std::move(source);
+    BOOST_REQUIRE(to_chunk(target) == value);
+    BOOST_REQUIRE(source.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__copy_assign__self__unchanged)
+{
+    const data_chunk value(200, 0x03);
+    stack_element instance(value);
+    auto& alias = instance;
+    instance = alias;
+    BOOST_REQUIRE(to_chunk(instance) == value);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__equality__different_bytes__not_equal)
+{
+    const stack_element left(data_chunk{ 0x01, 0x02 });
+    const stack_element right(data_chunk{ 0x01, 0x03 });
+    BOOST_REQUIRE(left != right);
+    BOOST_REQUIRE(!(left == right));
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__equality__prefix__not_equal)
+{
+    const stack_element left(data_chunk{ 0x01, 0x02 });
+    const stack_element right(data_chunk{ 0x01 });
+    BOOST_REQUIRE(left != right);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__script_number__round_trips)
+{
+    const script_number number(-1234);
+    const stack_element instance(number.data());
+    script_number out;
+    BOOST_REQUIRE(out.set_data(instance));
+    BOOST_REQUIRE_EQUAL(out.int32(), -1234);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <future>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(subscriber_tests)
+
+typedef subscriber<const code&, std::shared_ptr<const chain::block>>
+    block_subscriber;
+
+BOOST_AUTO_TEST_CASE(subscriber__relay__two_subscribers__same_instance)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<block_subscriber>(pool,
+        "block_subscriber", "test");
+
+    std::promise<const chain::block*> first;
+    std::promise<const chain::block*> second;
+    subscriber->subscribe([&first](const code&,
+        std::shared_ptr<const chain::block> block)
+    {
+        first.set_value(block.get());
+    });
+    subscriber->subscribe([&second](const code&,
+        std::shared_ptr<const chain::block> block)
+    {
+        second.set_value(block.get());
+    });
+
+    const auto block = std::make_shared<chain::block>();
+    subscriber->relay(error::success, block);
+    BOOST_REQUIRE(first.get_future().get() == block.get());
+    BOOST_REQUIRE(second.get_future().get() == block.get());
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(subscriber__relay__resubscribe__next_relay_only)
+{
+    threadpool pool(1);
+    const auto subscriber = std::make_shared<block_subscriber>(pool,
+        "block_subscriber", "test");
+
+    std::promise<code> first;
+    std::promise<code> second;
+    subscriber->subscribe([&](const code& ec,
+        std::shared_ptr<const chain::block>)
+    {
+        subscriber->subscribe([&second](const code& ec,
+            std::shared_ptr<const chain::block>)
+        {
+            second.set_value(ec);
+        });
+
+        first.set_value(ec);
+    });
+
+    subscriber->relay(error::success, std::make_shared<chain::block>());
+    BOOST_REQUIRE_EQUAL(first.get_future().get(), error::success);
+
+    // The resubscription is ordered before this relay.
+    subscriber->relay(error::bad_stream, std::make_shared<chain::block>());
+    BOOST_REQUIRE_EQUAL(second.get_future().get(), error::bad_stream);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2011-2015 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * libbitcoin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+// The wheel is not started, tests advance it by calling tick.
+#define TIMER_WHEEL(pool, wheel) \
+    threadpool pool(0); \
+    const auto wheel = std::make_shared<timer_wheel>(pool, seconds(1))
+
+static asio::duration seconds(long value)
+{
+    return asio::duration(0, 0, value);
+}
+
+// Tick until the flag is set, returning the number of ticks taken.
+static size_t ticks_until(timer_wheel& wheel, const bool& flag, size_t limit)
+{
+    size_t ticks = 0;
+    while (!flag && ticks < limit)
+    {
+        wheel.tick();
+        ++ticks;
+    }
+
+    return ticks;
+}
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_tests)
+
+BOOST_AUTO_TEST_CASE(timer_wheel__schedule__delay__expires_on_tick)
+{
+    TIMER_WHEEL(pool, wheel);
+    auto expired = false;
+    wheel->schedule(seconds(3), [&expired](const code& ec)
+    {
+        expired = (ec == error::success);
+    });
+
+    BOOST_REQUIRE_EQUAL(wheel->size(), 1u);
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, expired, 10), 3u);
+    BOOST_REQUIRE_EQUAL(wheel->size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__schedule__partial_tick__rounded_up)
+{
+    TIMER_WHEEL(pool, wheel);
+    auto expired = false;
+    wheel->schedule(asio::duration(0, 0, 1, 1), [&expired](const code&)
+    {
+        expired = true;
+    });
+
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, expired, 10), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__schedule__higher_levels__expires_on_tick)
+{
+    TIMER_WHEEL(pool, wheel);
+    auto first = false;
+    auto second = false;
+    auto third = false;
+    wheel->schedule(seconds(300), [&first](const code&) { first = true; });
+    wheel->schedule(seconds(16385), [&second](const code&) { second = true; });
+    wheel->schedule(seconds(20000), [&third](const code&) { third = true; });
+
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, first, 30000), 300u);
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, second, 30000), 16085u);
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, third, 30000), 3615u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__cancel__pending__not_invoked)
+{
+    TIMER_WHEEL(pool, wheel);
+    auto expired = false;
+    const auto timer = wheel->schedule(seconds(2), [&expired](const code&)
+    {
+        expired = true;
+    });
+
+    wheel->cancel(timer);
+    BOOST_REQUIRE_EQUAL(wheel->size(), 0u);
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, expired, 10), 10u);
+    BOOST_REQUIRE(!expired);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__cancel__shared_slot__others_expire)
+{
+    TIMER_WHEEL(pool, wheel);
+    size_t expired = 0;
+    const auto handler = [&expired](const code&) { ++expired; };
+
+    std::vector<timer_wheel::handle> timers;
+    for (size_t timer = 0; timer < 5; ++timer)
+        timers.push_back(wheel->schedule(seconds(4), handler));
+
+    wheel->cancel(timers[1]);
+    wheel->cancel(timers[3]);
+    BOOST_REQUIRE_EQUAL(wheel->size(), 3u);
+
+    for (size_t tick = 0; tick < 4; ++tick)
+        wheel->tick();
+
+    BOOST_REQUIRE_EQUAL(expired, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__cancel__expired_same_tick__not_invoked)
+{
+    TIMER_WHEEL(pool, wheel);
+    size_t expired = 0;
+    std::vector<timer_wheel::handle> timers;
+
+    // Whichever handler runs first cancels the other timer.
+    const auto handler = [&expired, &timers, wheel](const code&)
+    {
+        ++expired;
+        for (const auto& timer: timers)
+            wheel->cancel(timer);
+    };
+
+    timers.push_back(wheel->schedule(seconds(3), handler));
+    timers.push_back(wheel->schedule(seconds(3), handler));
+
+    for (size_t tick = 0; tick < 5; ++tick)
+        wheel->tick();
+
+    BOOST_REQUIRE_EQUAL(expired, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__touch__pending__postponed)
+{
+    TIMER_WHEEL(pool, wheel);
+    auto expired = false;
+    const auto timer = wheel->schedule(seconds(3), [&expired](const code&)
+    {
+        expired = true;
+    });
+
+    wheel->tick();
+    wheel->tick();
+    wheel->touch(timer, seconds(3));
+    BOOST_REQUIRE_EQUAL(ticks_until(*wheel, expired, 10), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__schedule__expired_timer__expires_again)
+{
+    TIMER_WHEEL(pool, wheel);
+    size_t expired = 0;
+    const auto handler = [&expired](const code&) { ++expired; };
+    const auto timer = wheel->schedule(seconds(1), handler);
+
+    wheel->tick();
+    BOOST_REQUIRE_EQUAL(expired, 1u);
+
+    wheel->schedule(timer, seconds(2), handler);
+    wheel->tick();
+    BOOST_REQUIRE_EQUAL(expired, 1u);
+    wheel->tick();
+    BOOST_REQUIRE_EQUAL(expired, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__schedule__pending_timer__replaced)
+{
+    TIMER_WHEEL(pool, wheel);
+    size_t expired = 0;
+    const auto handler = [&expired](const code&) { ++expired; };
+    const auto timer = wheel->schedule(seconds(5), handler);
+
+    wheel->schedule(timer, seconds(1), handler);
+    BOOST_REQUIRE_EQUAL(wheel->size(), 1u);
+    wheel->tick();
+    BOOST_REQUIRE_EQUAL(expired, 1u);
+
+    for (size_t tick = 0; tick < 10; ++tick)
+        wheel->tick();
+
+    BOOST_REQUIRE_EQUAL(expired, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_wheel__stop__pending__handlers_released)
+{
+    TIMER_WHEEL(pool, wheel);
+    const auto resource = std::make_shared<size_t>(42);
+    wheel->schedule(seconds(1), [resource](const code&) {});
+    BOOST_REQUIRE_EQUAL(resource.use_count(), 2);
+
+    wheel->stop();
+    BOOST_REQUIRE_EQUAL(resource.use_count(), 1);
+    BOOST_REQUIRE_EQUAL(wheel->size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
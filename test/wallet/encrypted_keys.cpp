@@ -19,7 +19,9 @@
  */
 #include <algorithm>
 #include <cstddef>
+#include <future>
 #include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 
@@ -661,6 +663,75 @@ BOOST_AUTO_TEST_CASE(encrypted__create_token_lot__private_and_public_compressed_
 
 BOOST_AUTO_TEST_SUITE_END()
 
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(encrypted__batch)
+
+BOOST_AUTO_TEST_CASE(encrypted__decrypt__batch__matches_single)
+{
+    const std::vector<encrypted_private> keys
+    {
+        base58_literal("6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg"),
+        base58_literal("6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo"),
+        base58_literal("6PRNFFkZc2NZ6dJqFfhRoFNMR9Lnyj7dYGrzdgXXVMXcxoKTePPX1dWByq")
+    };
+
+    threadpool pool(2);
+    std::promise<ek_decryption_list> promise;
+    decrypt(pool, keys, "TestingOneTwoThree",
+        [&promise](const ek_decryption_list& results)
+        {
+            promise.set_value(results);
+        });
+
+    const auto results = promise.get_future().get();
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(results.size(), keys.size());
+    BOOST_REQUIRE(results[0].valid);
+    BOOST_REQUIRE_EQUAL(encode_base16(results[0].secret), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(!results[0].compressed);
+    BOOST_REQUIRE(results[1].valid);
+    BOOST_REQUIRE_EQUAL(encode_base16(results[1].secret), "cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5");
+    BOOST_REQUIRE(results[1].compressed);
+
+    // The passphrase of this key is "Satoshi".
+    BOOST_REQUIRE(!results[2].valid);
+}
+
+BOOST_AUTO_TEST_CASE(encrypted__encrypt__batch__expected)
+{
+    const std::vector<ec_secret> secrets
+    {
+        base16_literal("cbf4b9f70470856bb4f40f80b87edb90865997ffee6df315ab166d713af433a5"),
+        base16_literal("09c2686880095b1a4c249ee3ac4eea8a014f11e6f986d0b5025ac1f39afbd9ae")
+    };
+
+    threadpool pool(2);
+    std::promise<ek_encryption_list> promise;
+    encrypt(pool, secrets, "TestingOneTwoThree", 0x00, true,
+        [&promise](const ek_encryption_list& results)
+        {
+            promise.set_value(results);
+        });
+
+    const auto results = promise.get_future().get();
+    pool.shutdown();
+    pool.join();
+
+    BOOST_REQUIRE_EQUAL(results.size(), secrets.size());
+    BOOST_REQUIRE(results[0].valid);
+    BOOST_REQUIRE_EQUAL(encode_base58(results[0].key), "6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo");
+    BOOST_REQUIRE(results[1].valid);
+
+    encrypted_private out_private;
+    BOOST_REQUIRE(encrypt(out_private, secrets[1], "TestingOneTwoThree", 0x00, true));
+    BOOST_REQUIRE(results[1].key == out_private);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 #endif
 
 // ----------------------------------------------------------------------------
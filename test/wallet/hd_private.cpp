@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cstddef>
+#include <future>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 
@@ -131,4 +134,71 @@ BOOST_AUTO_TEST_CASE(hd_private__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__short_seed__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto children = m.derive_private(hd_first_hardened_key, 2);
+
+    BOOST_REQUIRE_EQUAL(children.size(), 2u);
+    BOOST_REQUIRE_EQUAL(children[0].encoded(), "xprv9uHRZZhk6KAJC1avXpDAp4MDc3sQKNxDiPvvkX8Br5ngLNv1TxvUxt4cV1rGL5hj6KCesnDYUhd7oWgT11eZG7XnxHrnYeSvkzY7d2bhkJ7");
+    BOOST_REQUIRE(children[1] == m.derive_private(hd_first_hardened_key + 1));
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__across_hardened__matches_single)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    static const uint32_t first = hd_first_hardened_key - 2;
+    const auto children = m.derive_private(first, 4);
+
+    BOOST_REQUIRE_EQUAL(children.size(), 4u);
+    for (uint32_t offset = 0; offset < children.size(); ++offset)
+        BOOST_REQUIRE(children[offset] == m.derive_private(first + offset));
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_range__beyond_last_index__invalid)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto children = m.derive_private(max_uint32, 2);
+
+    BOOST_REQUIRE_EQUAL(children.size(), 2u);
+    BOOST_REQUIRE(children[0] == m.derive_private(max_uint32));
+    BOOST_REQUIRE(!children[1]);
+}
+
+BOOST_AUTO_TEST_CASE(hd_private__derive_private_pool__short_seed__matches_sequential)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    static const size_t count = 30;
+    static const uint32_t first = hd_first_hardened_key - count / 2;
+
+    std::vector<hd_private> children(count);
+    threadpool pool(4);
+
+    std::promise<void> derived;
+    m.derive_private(pool, children.data(), first, count, [&derived]()
+    {
+        derived.set_value();
+    });
+
+    derived.get_future().wait();
+    pool.shutdown();
+    pool.join();
+
+    const auto expected = m.derive_private(first, count);
+    for (size_t offset = 0; offset < count; ++offset)
+        BOOST_REQUIRE(children[offset] == expected[offset]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
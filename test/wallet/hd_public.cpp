@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cstddef>
+#include <future>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <bitcoin/bitcoin.hpp>
 
@@ -96,4 +99,93 @@ BOOST_AUTO_TEST_CASE(hd_public__derive_public__long_seed__expected)
     BOOST_REQUIRE_EQUAL(m0xH1yH2_pub.encoded(), "xpub6FnCn6nSzZAw5Tw7cgR9bi15UV96gLZhjDstkXXxvCLsUXBGXPdSnLFbdpq8p9HmGsApME5hQTZ3emM2rnY5agb9rXpVGyy3bdW6EEgAtqt");
 }
 
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__short_seed__expected)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_private m(seed, hd_private::mainnet);
+    const auto m0h_pub = m.derive_public(hd_first_hardened_key);
+    const auto children = m0h_pub.derive_public(0, 3);
+
+    BOOST_REQUIRE_EQUAL(children.size(), 3u);
+    BOOST_REQUIRE_EQUAL(children[1].encoded(), "xpub6ASuArnXKPbfEwhqN6e3mwBcDTgzisQN1wXN9BJcM47sSikHjJf3UFHKkNAWbWMiGj7Wf5uMash7SyYq527Hqck2AxYysAA7xmALppuCkwQ");
+
+    for (uint32_t index = 0; index < children.size(); ++index)
+        BOOST_REQUIRE(children[index] == m0h_pub.derive_public(index));
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_range__hardened__invalid)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    const auto children = m_pub.derive_public(hd_first_hardened_key - 1, 2);
+
+    BOOST_REQUIRE_EQUAL(children.size(), 2u);
+    BOOST_REQUIRE(children[0] == m_pub.derive_public(hd_first_hardened_key - 1));
+    BOOST_REQUIRE(!children[1]);
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_address_hashes__short_seed__child_point_hashes)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, SHORT_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    static const size_t count = 5;
+    static const uint32_t first = hd_first_hardened_key - 3;
+
+    std::vector<short_hash> hashes(count);
+    m_pub.derive_address_hashes(hashes.data(), first, count);
+
+    for (size_t offset = 0; offset < count; ++offset)
+    {
+        const auto child = m_pub.derive_public(first + offset);
+        const auto expected = child ? bitcoin_short_hash(child.point()) :
+            null_short_hash;
+
+        BOOST_REQUIRE(hashes[offset] == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hd_public__derive_public_pool__long_seed__matches_sequential)
+{
+    data_chunk seed;
+    BOOST_REQUIRE(decode_base16(seed, LONG_SEED));
+
+    const hd_public m_pub = hd_private(seed, hd_private::mainnet);
+    static const size_t count = 50;
+
+    std::vector<hd_public> children(count);
+    std::vector<short_hash> hashes(count);
+    threadpool pool(4);
+
+    std::promise<void> derived;
+    m_pub.derive_public(pool, children.data(), 7, count, [&derived]()
+    {
+        derived.set_value();
+    });
+
+    std::promise<void> hashed;
+    m_pub.derive_address_hashes(pool, hashes.data(), 7, count, [&hashed]()
+    {
+        hashed.set_value();
+    });
+
+    derived.get_future().wait();
+    hashed.get_future().wait();
+    pool.shutdown();
+    pool.join();
+
+    std::vector<short_hash> expected_hashes(count);
+    m_pub.derive_address_hashes(expected_hashes.data(), 7, count);
+    BOOST_REQUIRE(hashes == expected_hashes);
+
+    const auto expected = m_pub.derive_public(7, count);
+    for (size_t offset = 0; offset < count; ++offset)
+        BOOST_REQUIRE(children[offset] == expected[offset]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
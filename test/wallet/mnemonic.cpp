@@ -38,8 +38,38 @@ BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__no_passphrase)
     }
 }
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__no_passphrase)
+{
+    std::vector<word_list> mnemonics;
+    for (const auto& vector: mnemonic_no_passphrase)
+        mnemonics.push_back(split(vector.mnemonic, ","));
+
+    const auto seeds = decode_mnemonics(mnemonics);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonic_no_passphrase.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(seeds[index]), mnemonic_no_passphrase[index].seed);
+}
+
 #ifdef WITH_ICU
 
+BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonics__trezor)
+{
+    std::vector<word_list> mnemonics;
+    std::vector<std::string> passphrases;
+    for (const auto& vector: mnemonic_trezor_vectors)
+    {
+        mnemonics.push_back(split(vector.mnemonic, ","));
+        passphrases.push_back(vector.passphrase);
+    }
+
+    const auto seeds = decode_mnemonics(mnemonics, passphrases);
+    BOOST_REQUIRE_EQUAL(seeds.size(), mnemonic_trezor_vectors.size());
+
+    for (size_t index = 0; index < seeds.size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(seeds[index]), mnemonic_trezor_vectors[index].seed);
+}
+
 BOOST_AUTO_TEST_CASE(mnemonic__decode_mnemonic__trezor)
 {
     for (const auto& vector: mnemonic_trezor_vectors)